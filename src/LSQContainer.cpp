@@ -1,32 +1,61 @@
 
 namespace m3mpm {
 
-template <typename T>
-LSQContainer<T>::LSQContainer() : size_(0), head_(nullptr), tail_(nullptr) {}
+template <typename T, typename Alloc, typename Stats>
+template <typename... Args>
+Node<T> *LSQContainer<T, Alloc, Stats>::create_node(Args &&...args) {
+  node_allocator alloc;
+  Node<T> *node = node_traits::allocate(alloc, 1);
+  this->on_allocate(sizeof(Node<T>));
+  M3MPM_TRY {
+    node_traits::construct(alloc, node, std::forward<Args>(args)...);
+  } M3MPM_CATCH_ALL {
+    node_traits::deallocate(alloc, node, 1);
+    this->on_deallocate(sizeof(Node<T>));
+    M3MPM_RETHROW;
+  }
+  this->on_construct();
+  return node;
+}
+
+template <typename T, typename Alloc, typename Stats>
+void LSQContainer<T, Alloc, Stats>::destroy_node(Node<T> *node) {
+  node_allocator alloc;
+  node_traits::destroy(alloc, node);
+  this->on_destroy();
+  node_traits::deallocate(alloc, node, 1);
+  this->on_deallocate(sizeof(Node<T>));
+}
 
-template <typename T>
-LSQContainer<T>::LSQContainer(const std::initializer_list<T> &items)
+template <typename T, typename Alloc, typename Stats>
+LSQContainer<T, Alloc, Stats>::LSQContainer()
+    : size_(0), head_(nullptr), tail_(nullptr) {}
+
+template <typename T, typename Alloc, typename Stats>
+LSQContainer<T, Alloc, Stats>::LSQContainer(
+    const std::initializer_list<T> &items)
     : LSQContainer() {
   for (auto &value : items) push(value);
 }
 
-template <typename T>
-LSQContainer<T>::LSQContainer(size_t size_n) : LSQContainer() {
+template <typename T, typename Alloc, typename Stats>
+LSQContainer<T, Alloc, Stats>::LSQContainer(size_t size_n) : LSQContainer() {
   for (size_t i = 0; i < size_n; i++) push(0);
 }
 
-template <typename T>
-LSQContainer<T>::LSQContainer(const LSQContainer &l) : LSQContainer() {
+template <typename T, typename Alloc, typename Stats>
+LSQContainer<T, Alloc, Stats>::LSQContainer(const LSQContainer &l)
+    : LSQContainer() {
   *this = l;
 }
 
-template <typename T>
-LSQContainer<T>::LSQContainer(LSQContainer &&l) : LSQContainer() {
+template <typename T, typename Alloc, typename Stats>
+LSQContainer<T, Alloc, Stats>::LSQContainer(LSQContainer &&l) : LSQContainer() {
   *this = std::move(l);
 }
 
-template <typename T>
-LSQContainer<T>::~LSQContainer() {
+template <typename T, typename Alloc, typename Stats>
+LSQContainer<T, Alloc, Stats>::~LSQContainer() {
   while (size_) {
     pop();
   }
@@ -34,8 +63,8 @@ LSQContainer<T>::~LSQContainer() {
   tail_ = nullptr;
 }
 
-template <typename T>
-void LSQContainer<T>::print() const {
+template <typename T, typename Alloc, typename Stats>
+void LSQContainer<T, Alloc, Stats>::print() const {
   Node<T> *result = this->head_;
   while (result != nullptr) {
     std::cout << result->data_ << " ";
@@ -44,21 +73,26 @@ void LSQContainer<T>::print() const {
   std::cout << std::endl;
 }
 
-template <typename T>
-void LSQContainer<T>::swap(LSQContainer &other) {
+template <typename T, typename Alloc, typename Stats>
+void LSQContainer<T, Alloc, Stats>::swap(LSQContainer &other) {
   std::swap(size_, other.size_);
   std::swap(head_, other.head_);
   std::swap(tail_, other.tail_);
+  this->on_swap(other);
 }
 
-template <typename T>
-LSQContainer<T> &LSQContainer<T>::operator=(LSQContainer &&l) {
+template <typename T, typename Alloc, typename Stats>
+LSQContainer<T, Alloc, Stats> &LSQContainer<T, Alloc, Stats>::operator=(
+    LSQContainer &&l) {
     swap(l);
     return *this;
 }
 
-template <typename T>
-LSQContainer<T> &LSQContainer<T>::operator=(const LSQContainer &l) {
+template <typename T, typename Alloc, typename Stats>
+LSQContainer<T, Alloc, Stats> &LSQContainer<T, Alloc, Stats>::operator=(
+    const LSQContainer &l) {
+  auto scope = this->op_scope(Op::kCopy);
+  this->on_hops(l.size_);
   Node<T> *result = l.head_;
   while (result != nullptr) {
     push(result->data_);
@@ -68,38 +102,66 @@ LSQContainer<T> &LSQContainer<T>::operator=(const LSQContainer &l) {
   return *this;
 }
 
-template <typename T>
-void LSQContainer<T>::push(const T & value) {
+template <typename T, typename Alloc, typename Stats>
+void LSQContainer<T, Alloc, Stats>::link_back(Node<T> *node) {
   if (head_ == nullptr) {
-    head_ = new Node<T>(value);
-    tail_ = head_;
+    head_ = node;
   } else {
-    Node<T> *newNode = new Node<T>(value);
-    tail_->pNext_ = newNode;
-    newNode->pPrev_ = tail_;
-    tail_ = newNode;
+    tail_->pNext_ = node;
+    node->pPrev_ = tail_;
   }
+  tail_ = node;
   size_++;
 }
 
-template <typename T>
-void LSQContainer<T>::pop() {
+template <typename T, typename Alloc, typename Stats>
+void LSQContainer<T, Alloc, Stats>::push(const T & value) {
+  auto scope = this->op_scope(Op::kPush);
+  link_back(create_node(value));
+}
+
+template <typename T, typename Alloc, typename Stats>
+void LSQContainer<T, Alloc, Stats>::push(T &&value) {
+  auto scope = this->op_scope(Op::kPush);
+  link_back(create_node(std::move(value)));
+}
+
+template <typename T, typename Alloc, typename Stats>
+void LSQContainer<T, Alloc, Stats>::pop() {
+  auto scope = this->op_scope(Op::kPop);
   if (empty()) {
-    throw std::logic_error("Error: pop_back(): The LSQContainer is empty");
+    M3MPM_THROW(std::logic_error(
+        "Error: pop_back(): The LSQContainer is empty"));
   }
   if (head_ != nullptr) {
     Node<T> *tmp = tail_;
     tail_ = tail_->pPrev_;
-    delete tmp;
+    destroy_node(tmp);
     if (tail_ != nullptr) {
       tail_->pNext_ = nullptr;
+    } else {
+      head_ = nullptr;
     }
     size_--;
   }
 }
 
-template <typename T>
-bool LSQContainer<T>::empty() {
+template <typename T, typename Alloc, typename Stats>
+size_t LSQContainer<T, Alloc, Stats>::memory_usage(bool deep) const {
+  size_t bytes = sizeof(*this) +
+                 size_ * detail::allocation_size<node_allocator>(1);
+  if constexpr (detail::has_memory_usage<T>::value) {
+    if (deep) {
+      for (Node<T> *node = head_; node != nullptr; node = node->pNext_) {
+        bytes += detail::element_memory_usage(node->data_);
+      }
+    }
+  }
+  return bytes;
+}
+
+template <typename T, typename Alloc, typename Stats>
+bool LSQContainer<T, Alloc, Stats>::empty() {
   return size_ == 0;
 }
 
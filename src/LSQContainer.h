@@ -3,34 +3,67 @@
 #include <stddef.h>
 #include <initializer_list>
 #include <iostream>
+#include <memory>
 
+#include "config.h"
+#include "memory_usage.h"
 #include "node.h"
-
+#include "stats.h"
 
 namespace m3mpm {
-template <typename T>
-class LSQContainer : public Node<T> {
+// Alloc is rebound to Node<T> for every node the container creates. It must
+// be stateless: containers default-construct it on each call instead of
+// storing a copy, so std::allocator_traits<Alloc>::is_always_equal must hold.
+// The container itself holds only the size and the two end pointers, so an
+// empty one takes three words and constructs no T. Stats is the
+// instrumentation policy from stats.h; the default NoStats adds neither
+// size nor code.
+template <typename T, typename Alloc = std::allocator<T>,
+          typename Stats = NoStats>
+class LSQContainer : public Stats {
  protected:
+  using node_allocator =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node<T>>;
+  using node_traits = std::allocator_traits<node_allocator>;
+  static_assert(node_traits::is_always_equal::value,
+                "LSQContainer: Alloc must be a stateless allocator");
+
   size_t size_;
   Node<T> *head_;
   Node<T> *tail_;
+
+  template <typename... Args>
+  Node<T> *create_node(Args &&...args);
+  void destroy_node(Node<T> *node);
+  void link_back(Node<T> *node);
+
  public:
+  using allocator_type = Alloc;
+
   LSQContainer();
   explicit LSQContainer(const std::initializer_list<T> &items);
   explicit LSQContainer(size_t size_n);
   LSQContainer(const LSQContainer &l);
   LSQContainer(LSQContainer &&l);
   ~LSQContainer();
-  LSQContainer<T> &operator=(LSQContainer &&l);
-  LSQContainer<T> &operator=(const LSQContainer &l);
+  LSQContainer &operator=(LSQContainer &&l);
+  LSQContainer &operator=(const LSQContainer &l);
 
   bool empty();
   inline size_t size() { return size_; }
 
   void swap(LSQContainer &other);
   void push(const T &value);
+  void push(T &&value);
   void print() const;
   void pop();
+
+  // Bytes held: the object itself plus every node as the allocator rounds
+  // it (see memory_usage.h). With deep, elements that have a memory_usage()
+  // of their own also add whatever they hold outside their node. Blocks a
+  // pooling allocator keeps on its free lists belong to the pool, not to
+  // any one container, and are not counted.
+  size_t memory_usage(bool deep = false) const;
 };
 }  // namespace m3mpm
 #include "LSQContainer.cpp"
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "containers.h"
+
+namespace {
+constexpr int kBatch = 256;
+constexpr int kMaxPairs = 16;
+
+template <typename T, typename Alloc>
+void put(m3mpm::List<T, Alloc> &items, const T &value) {
+  items.push_back(value);
+}
+
+template <typename T, typename Alloc>
+void take(m3mpm::List<T, Alloc> &items) {
+  items.pop_front();
+}
+
+template <typename Container, typename T>
+void put(Container &items, const T &value) {
+  items.push(value);
+}
+
+template <typename Container>
+void take(Container &items) {
+  items.pop();
+}
+
+template <typename Container>
+struct Channel {
+  std::mutex mutex;
+  Container items;
+};
+
+template <typename Container>
+Channel<Container> &channel(int index) {
+  static Channel<Container> channels[kMaxPairs];
+  return channels[index];
+}
+
+// Threads pair up on a shared channel: the even thread of a pair pushes and
+// the odd one pops, so every node is allocated on one thread and freed on
+// the other. A lone thread pushes and pops its own batches.
+template <typename Container>
+void BM_ProducerConsumer(benchmark::State &state) {
+  Channel<Container> &ch = channel<Container>(state.thread_index() / 2);
+  const bool single = state.threads() == 1;
+  const bool producer = state.thread_index() % 2 == 0;
+  for (auto _ : state) {
+    if (single || producer) {
+      std::lock_guard<std::mutex> lock(ch.mutex);
+      for (int i = 0; i < kBatch; ++i) put(ch.items, static_cast<long>(i));
+    }
+    if (single || !producer) {
+      int popped = 0;
+      while (popped < kBatch) {
+        {
+          std::lock_guard<std::mutex> lock(ch.mutex);
+          for (; popped < kBatch && !ch.items.empty(); ++popped) {
+            take(ch.items);
+          }
+        }
+        if (popped < kBatch) std::this_thread::yield();
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+using HeapAlloc = std::allocator<long>;
+using CacheAlloc = m3mpm::ThreadCachingAllocator<long>;
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, m3mpm::Queue<long, HeapAlloc>)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, m3mpm::Queue<long, CacheAlloc>)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, m3mpm::Stack<long, HeapAlloc>)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, m3mpm::Stack<long, CacheAlloc>)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, m3mpm::List<long, HeapAlloc>)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, m3mpm::List<long, CacheAlloc>)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
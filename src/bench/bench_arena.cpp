@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "containers.h"
+#include "perf_counters.h"
+
+namespace {
+// Nodes are handed out round-robin to kLists lists, so consecutive nodes of
+// one list sit kLists allocations apart and nearly every hop of a traversal
+// lands on a different 4 KiB page.
+constexpr size_t kLists = 1024;
+
+template <typename Alloc>
+void BM_ScatteredTraversal(benchmark::State &state) {
+  const size_t nodes = static_cast<size_t>(state.range(0));
+  std::vector<m3mpm::List<long, Alloc>> lists(kLists);
+  for (size_t i = 0; i < nodes; ++i) {
+    lists[i % kLists].push_back(static_cast<long>(i));
+  }
+
+#ifdef __linux__
+  bench::PerfCounter dtlb(PERF_TYPE_HW_CACHE, bench::kDtlbLoadMisses);
+#else
+  bench::PerfCounter dtlb(0, 0);
+#endif
+  dtlb.start();
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto &items : lists) {
+      for (auto it = items.begin(); it != items.end(); ++it) sum += *it;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  dtlb.stop();
+
+  const double visited = static_cast<double>(state.iterations() * nodes);
+  state.SetItemsProcessed(static_cast<int64_t>(visited));
+  if (dtlb.available()) {
+    state.counters["dTLB-misses/node"] = dtlb.value() / visited;
+  } else {
+    state.SetLabel("dTLB counter unavailable");
+  }
+}
+
+template <typename Alloc>
+void BM_Build(benchmark::State &state) {
+  const long nodes = state.range(0);
+  for (auto _ : state) {
+    m3mpm::List<long, Alloc> items;
+    for (long i = 0; i < nodes; ++i) items.push_back(i);
+    benchmark::DoNotOptimize(items.back());
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+}
+
+using HeapAlloc = std::allocator<long>;
+using ArenaAlloc = m3mpm::HugePageArenaAllocator<long>;
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ScatteredTraversal, HeapAlloc)
+    ->RangeMultiplier(8)
+    ->Range(1 << 16, 1 << 25)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ScatteredTraversal, ArenaAlloc)
+    ->RangeMultiplier(8)
+    ->Range(1 << 16, 1 << 25)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Build, HeapAlloc)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Build, ArenaAlloc)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20);
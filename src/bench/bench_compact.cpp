@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include "containers.h"
+#include "list_layouts.h"
+#include "perf_counters.h"
+
+namespace {
+long traverse(m3mpm::List<long> *items) {
+  long sum = 0;
+  for (auto it = items->begin(); it != items->end(); ++it) sum += *it;
+  return sum;
+}
+
+void BM_TraverseChurned(benchmark::State &state) {
+  m3mpm::List<long> items;
+  bench::fill_scattered(&items, state.range(0));
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) benchmark::DoNotOptimize(traverse(&items));
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["fragmentation"] = items.fragmentation();
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+void BM_TraverseCompacted(benchmark::State &state) {
+  m3mpm::List<long> items;
+  bench::fill_scattered(&items, state.range(0));
+  items.compact();
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) benchmark::DoNotOptimize(traverse(&items));
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["fragmentation"] = items.fragmentation();
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+void BM_Compact(benchmark::State &state) {
+  m3mpm::List<long> items;
+  bench::fill_scattered(&items, state.range(0));
+  for (auto _ : state) items.compact();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_TraverseChurned)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+BENCHMARK(BM_TraverseCompacted)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+BENCHMARK(BM_Compact)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
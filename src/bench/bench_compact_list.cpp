@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <stdint.h>
+
+#include <random>
+
+#include "containers.h"
+#include "perf_counters.h"
+
+namespace {
+// Live heap bytes according to glibc, or 0 where that is not available.
+size_t heap_in_use() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+#else
+  return 0;
+#endif
+}
+
+template <typename List>
+void BM_Build(benchmark::State &state) {
+  const int32_t nodes = static_cast<int32_t>(state.range(0));
+  for (auto _ : state) {
+    List items;
+    for (int32_t i = 0; i < nodes; ++i) items.push_back(i);
+    benchmark::DoNotOptimize(items.back());
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+
+  size_t before = heap_in_use();
+  List items;
+  for (int32_t i = 0; i < nodes; ++i) items.push_back(i);
+  size_t bytes = heap_in_use() - before;
+  if (bytes != 0) {
+    state.counters["heap_bytes/elem"] = static_cast<double>(bytes) / nodes;
+  }
+}
+
+template <typename List>
+void BM_Scan(benchmark::State &state) {
+  List items;
+  for (int32_t i = 0; i < state.range(0); ++i) items.push_back(i);
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = items.begin(); it != items.end(); ++it) sum += *it;
+    benchmark::DoNotOptimize(sum);
+  }
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+template <typename List>
+void BM_Sort(benchmark::State &state) {
+  std::mt19937 gen(3);
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) {
+    perf.stop();
+    state.PauseTiming();
+    List items;
+    for (int32_t i = 0; i < state.range(0); ++i) {
+      items.push_back(static_cast<int32_t>(gen()));
+    }
+    state.ResumeTiming();
+    perf.resume();
+    items.sort();
+    benchmark::DoNotOptimize(items.front());
+  }
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+using NodeList = m3mpm::List<int32_t>;
+using IndexList = m3mpm::CompactList<int32_t>;
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Build, NodeList)->RangeMultiplier(16)->Range(1 << 10,
+                                                                  1 << 22);
+BENCHMARK_TEMPLATE(BM_Build, IndexList)->RangeMultiplier(16)->Range(1 << 10,
+                                                                   1 << 22);
+BENCHMARK_TEMPLATE(BM_Scan, NodeList)->RangeMultiplier(16)->Range(1 << 10,
+                                                                 1 << 22);
+BENCHMARK_TEMPLATE(BM_Scan, IndexList)->RangeMultiplier(16)->Range(1 << 10,
+                                                                  1 << 22);
+// List::sort is quadratic, so it is only measured on small inputs.
+BENCHMARK_TEMPLATE(BM_Sort, NodeList)->RangeMultiplier(4)->Range(1 << 8,
+                                                                1 << 12);
+BENCHMARK_TEMPLATE(BM_Sort, IndexList)->RangeMultiplier(16)->Range(1 << 8,
+                                                                  1 << 20);
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include <deque>
+
+#include "containers.h"
+
+namespace {
+template <typename T, typename Alloc>
+void put_back(m3mpm::Queue<T, Alloc> &items, const T &value) {
+  items.push(value);
+}
+
+template <typename T, typename Alloc>
+void take_front(m3mpm::Queue<T, Alloc> &items) {
+  items.pop();
+}
+
+template <typename Container, typename T>
+void put_back(Container &items, const T &value) {
+  items.push_back(value);
+}
+
+template <typename Container>
+void take_front(Container &items) {
+  items.pop_front();
+}
+
+// FIFO use at a steady working size of state.range(0): every step pops the
+// oldest element and pushes a new one.
+template <typename Container>
+void BM_Fifo(benchmark::State &state) {
+  Container items;
+  for (long i = 0; i < state.range(0); ++i) put_back(items, i);
+  long i = 0;
+  for (auto _ : state) {
+    take_front(items);
+    put_back(items, ++i);
+  }
+  benchmark::DoNotOptimize(items.size());
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Fills to state.range(0) from both ends and drains from both ends.
+template <typename Container>
+void BM_BothEnds(benchmark::State &state) {
+  const long n = state.range(0);
+  for (auto _ : state) {
+    Container items;
+    for (long i = 0; i < n; ++i) {
+      if (i & 1) {
+        items.push_front(i);
+      } else {
+        items.push_back(i);
+      }
+    }
+    long sum = 0;
+    for (long i = 0; i < n; ++i) {
+      if (i & 1) {
+        sum += items.front();
+        items.pop_front();
+      } else {
+        sum += items.back();
+        items.pop_back();
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Container>
+void BM_Scan(benchmark::State &state) {
+  Container items;
+  for (long i = 0; i < state.range(0); ++i) items.push_back(i);
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = items.begin(); it != items.end(); ++it) sum += *it;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Fifo, m3mpm::Queue<long>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Fifo, m3mpm::List<long>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Fifo, m3mpm::Deque<long>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Fifo, std::deque<long>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_BothEnds, m3mpm::List<long>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_BothEnds, m3mpm::Deque<long>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_BothEnds, std::deque<long>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Scan, m3mpm::List<long>)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Scan, m3mpm::Deque<long>)->Range(1 << 4, 1 << 16);
@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+
+#include <type_traits>
+
+#include "containers.h"
+
+namespace {
+// The price of each instrumentation policy on the cheapest operations: a
+// FIFO of state.range(0) elements where every step pushes and pops once.
+// Sampling only matters to LatencyStats.
+template <typename Stats, uint32_t Sampling>
+void BM_ListFifo(benchmark::State &state) {
+  m3mpm::List<int, std::allocator<int>, Stats> items;
+  if constexpr (!std::is_same_v<Stats, m3mpm::NoStats> &&
+                !std::is_same_v<Stats, m3mpm::CountingStats>) {
+    items.set_sampling(Sampling);
+  }
+  for (int i = 0; i < state.range(0); ++i) items.push_back(i);
+  int i = 0;
+  for (auto _ : state) {
+    items.pop_front();
+    items.push_back(++i);
+  }
+  benchmark::DoNotOptimize(items.front());
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+
+using Steady = m3mpm::LatencyStats<m3mpm::NoStats, m3mpm::SteadyTicks>;
+#if defined(__x86_64__) || defined(__i386__)
+using Tsc = m3mpm::LatencyStats<m3mpm::NoStats, m3mpm::TscTicks>;
+#endif
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ListFifo, m3mpm::NoStats, 0)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_ListFifo, m3mpm::CountingStats, 0)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_ListFifo, Steady, 1)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_ListFifo, Steady, 64)->Arg(1000);
+#if defined(__x86_64__) || defined(__i386__)
+BENCHMARK_TEMPLATE(BM_ListFifo, Tsc, 1)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_ListFifo, Tsc, 64)->Arg(1000);
+#endif
@@ -0,0 +1,313 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <queue>
+#include <random>
+#include <stack>
+#include <vector>
+
+#include "containers.h"
+#include "perf_counters.h"
+
+// Every List, Stack and Queue operation next to its standard counterpart,
+// at sizes from 10 to 10^7 elements. items_per_second counts elements
+// handled, so the rates compare across sizes as well as across containers.
+// Traversal, sort, merge, splice, unique and the push/pop runs also report
+// hardware counters per element where the machine exposes them
+// (perf_counters.h).
+namespace {
+using MyList = m3mpm::List<int>;
+using StdList = std::list<int>;
+using StdDeque = std::deque<int>;
+
+std::vector<int> random_values(long n) {
+  std::mt19937 gen(41);
+  std::vector<int> values(n);
+  for (auto &value : values) value = static_cast<int>(gen() % (n + 1));
+  return values;
+}
+
+template <typename Container>
+Container make_from(const std::vector<int> &values) {
+  Container items;
+  for (int value : values) items.push_back(value);
+  return items;
+}
+
+// Runs op on fresh containers built by make, so that operations which
+// consume or reorder their input always start from the same state. The
+// containers are built in batches of about 2^16 elements with the clock
+// stopped, which keeps the pause overhead out of the small sizes.
+template <typename Make, typename Op>
+void consume_batches(benchmark::State &state, Make make, Op op) {
+  const long n = state.range(0);
+  const long batch = std::max(1L, (1L << 16) / n);
+  std::vector<decltype(make())> pool;
+  pool.reserve(batch);
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) {
+    perf.stop();
+    state.PauseTiming();
+    pool.clear();
+    for (long i = 0; i < batch; ++i) pool.push_back(make());
+    state.ResumeTiming();
+    perf.resume();
+    for (auto &items : pool) op(items);
+  }
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * batch * n);
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+// Fills to n at one end and drains from the same end (a stack) or from the
+// other end (a queue).
+template <typename Container>
+void BM_PushBackPopBack(benchmark::State &state) {
+  const long n = state.range(0);
+  for (auto _ : state) {
+    Container items;
+    for (long i = 0; i < n; ++i) items.push_back(static_cast<int>(i));
+    for (long i = 0; i < n; ++i) items.pop_back();
+    benchmark::DoNotOptimize(items.empty());
+  }
+  state.SetItemsProcessed(state.iterations() * n * 2);
+}
+
+template <typename Container>
+void BM_PushFrontPopFront(benchmark::State &state) {
+  const long n = state.range(0);
+  for (auto _ : state) {
+    Container items;
+    for (long i = 0; i < n; ++i) items.push_front(static_cast<int>(i));
+    for (long i = 0; i < n; ++i) items.pop_front();
+    benchmark::DoNotOptimize(items.empty());
+  }
+  state.SetItemsProcessed(state.iterations() * n * 2);
+}
+
+template <typename Container>
+void BM_PushBackPopFront(benchmark::State &state) {
+  const long n = state.range(0);
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) {
+    Container items;
+    for (long i = 0; i < n; ++i) items.push_back(static_cast<int>(i));
+    for (long i = 0; i < n; ++i) items.pop_front();
+    benchmark::DoNotOptimize(items.empty());
+  }
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * n * 2);
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+// One insertion and one erasure next to an iterator held in the middle of
+// a list of n elements; the search for the position is not timed.
+template <typename Container>
+void BM_InsertEraseMiddle(benchmark::State &state) {
+  const long n = state.range(0);
+  Container items = make_from<Container>(random_values(n));
+  auto middle = std::next(items.begin(), n / 2);
+  for (auto _ : state) {
+    auto added = items.insert(middle, 7);
+    items.erase(added);
+  }
+  benchmark::DoNotOptimize(items.size());
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Container>
+void BM_SortRandom(benchmark::State &state) {
+  auto values = random_values(state.range(0));
+  consume_batches(
+      state, [&] { return make_from<Container>(values); },
+      [](Container &items) { items.sort(); });
+}
+
+template <typename Container>
+void BM_SortSorted(benchmark::State &state) {
+  auto values = random_values(state.range(0));
+  std::sort(values.begin(), values.end());
+  Container items = make_from<Container>(values);
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) {
+    items.sort();
+    benchmark::DoNotOptimize(items.front());
+  }
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+// Merges two sorted lists of n / 2 elements each.
+template <typename Container>
+void BM_Merge(benchmark::State &state) {
+  const long n = state.range(0);
+  auto values = random_values(n);
+  std::vector<int> left(values.begin(), values.begin() + n / 2);
+  std::vector<int> right(values.begin() + n / 2, values.end());
+  std::sort(left.begin(), left.end());
+  std::sort(right.begin(), right.end());
+  struct Pair {
+    Container left;
+    Container right;
+  };
+  consume_batches(
+      state,
+      [&] {
+        return Pair{make_from<Container>(left), make_from<Container>(right)};
+      },
+      [](Pair &lists) { lists.left.merge(lists.right); });
+}
+
+// Moves a list of n elements into the middle of another one.
+template <typename Container>
+void BM_Splice(benchmark::State &state) {
+  const long n = state.range(0);
+  auto values = random_values(n);
+  struct Pair {
+    Container target;
+    Container source;
+  };
+  consume_batches(
+      state,
+      [&] {
+        return Pair{make_from<Container>(values), make_from<Container>(values)};
+      },
+      [n](Pair &lists) {
+        auto middle = std::next(lists.target.begin(), n / 2);
+        lists.target.splice(middle, lists.source);
+      });
+}
+
+// Every element appears twice in a row, so unique() drops half of them.
+template <typename Container>
+void BM_Unique(benchmark::State &state) {
+  const long n = state.range(0);
+  std::vector<int> values;
+  for (long i = 0; i < n; ++i) values.push_back(static_cast<int>(i / 2));
+  consume_batches(
+      state, [&] { return make_from<Container>(values); },
+      [](Container &items) { items.unique(); });
+}
+
+template <typename Container>
+void BM_Reverse(benchmark::State &state) {
+  Container items = make_from<Container>(random_values(state.range(0)));
+  for (auto _ : state) {
+    items.reverse();
+    benchmark::DoNotOptimize(items.front());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_Copy(benchmark::State &state) {
+  Container items = make_from<Container>(random_values(state.range(0)));
+  for (auto _ : state) {
+    Container copy(items);
+    benchmark::DoNotOptimize(copy.back());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_Iterate(benchmark::State &state) {
+  Container items = make_from<Container>(random_values(state.range(0)));
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = items.begin(); it != items.end(); ++it) sum += *it;
+    benchmark::DoNotOptimize(sum);
+  }
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+// Stack and Queue through their own interfaces.
+template <typename Container>
+void BM_FillDrain(benchmark::State &state) {
+  const long n = state.range(0);
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) {
+    Container items;
+    for (long i = 0; i < n; ++i) items.push(static_cast<int>(i));
+    for (long i = 0; i < n; ++i) items.pop();
+    benchmark::DoNotOptimize(items.empty());
+  }
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * n * 2);
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+template <typename Container>
+void BM_CopyAdapter(benchmark::State &state) {
+  const long n = state.range(0);
+  Container items;
+  for (long i = 0; i < n; ++i) items.push(static_cast<int>(i));
+  for (auto _ : state) {
+    Container copy(items);
+    benchmark::DoNotOptimize(copy.size());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+using MyStack = m3mpm::Stack<int>;
+using StdStack = std::stack<int>;
+using MyQueue = m3mpm::Queue<int>;
+using StdQueue = std::queue<int>;
+
+void all_sizes(benchmark::internal::Benchmark *b) {
+  b->RangeMultiplier(10)->Range(10, 10000000);
+}
+
+// List::sort() swaps neighbours until nothing moves, which is quadratic on
+// unordered input, so the random sorts stop at 10^4.
+void sort_sizes(benchmark::internal::Benchmark *b) {
+  b->RangeMultiplier(10)->Range(10, 10000);
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_PushBackPopBack, MyList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_PushBackPopBack, StdList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_PushBackPopBack, StdDeque)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_PushFrontPopFront, MyList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_PushFrontPopFront, StdList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_PushFrontPopFront, StdDeque)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_PushBackPopFront, MyList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_PushBackPopFront, StdList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_PushBackPopFront, StdDeque)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_InsertEraseMiddle, MyList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_InsertEraseMiddle, StdList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_SortRandom, MyList)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(BM_SortRandom, StdList)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(BM_SortSorted, MyList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_SortSorted, StdList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Merge, MyList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Merge, StdList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Splice, MyList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Splice, StdList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Unique, MyList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Unique, StdList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Reverse, MyList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Reverse, StdList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Copy, MyList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Copy, StdList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Iterate, MyList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Iterate, StdList)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_Iterate, StdDeque)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_FillDrain, MyStack)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_FillDrain, StdStack)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_FillDrain, MyQueue)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_FillDrain, StdQueue)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_CopyAdapter, MyStack)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_CopyAdapter, StdStack)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_CopyAdapter, MyQueue)->Apply(all_sizes);
+BENCHMARK_TEMPLATE(BM_CopyAdapter, StdQueue)->Apply(all_sizes);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include "containers.h"
+
+// Scaling of List::parallel_reduce, summing a list, from one thread to
+// every hardware thread, next to a plain range-for over the same list. The
+// indexed runs find their chunks through the skip index. The others wait
+// on the one walk that cuts the list, which bounds their speedup when the
+// work per element is as light as an addition, until a list of
+// List::kParallelIndexMin nodes or more builds its index in the first
+// iteration and catches up.
+namespace {
+m3mpm::List<long> make_list(long n) {
+  m3mpm::List<long> items;
+  for (long i = 0; i < n; ++i) items.push_back(i % 1000);
+  return items;
+}
+
+void BM_ParallelReduce(benchmark::State &state) {
+  const long n = state.range(0);
+  const auto threads = static_cast<size_t>(state.range(1));
+  auto items = make_list(n);
+  if (state.range(2) != 0) items.at(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(items.parallel_reduce(0L, std::plus<>(),
+                                                   threads));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_RangeForSum(benchmark::State &state) {
+  const long n = state.range(0);
+  auto items = make_list(n);
+  for (auto _ : state) {
+    long sum = 0;
+    for (long item : items) sum += item;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Sizes from 10^5 to 10^7 at 1, 2, 4, ... threads and at the hardware
+// thread count, with and without the index. Lists of 10^8 longs
+// take over 3 GiB of nodes, so that size is left out here as well.
+void scaling_args(benchmark::internal::Benchmark *b) {
+  const long cores = std::max(1u, std::thread::hardware_concurrency());
+  for (long n = 100000; n <= 10000000; n *= 10) {
+    for (long indexed : {0, 1}) {
+      for (long threads = 1; threads < cores; threads *= 2) {
+        b->Args({n, threads, indexed});
+      }
+      b->Args({n, cores, indexed});
+    }
+  }
+  b->ArgNames({"n", "threads", "indexed"});
+}
+}  // namespace
+
+BENCHMARK(BM_ParallelReduce)
+    ->Apply(scaling_args)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RangeForSum)
+    ->RangeMultiplier(10)
+    ->Range(100000, 10000000)
+    ->Unit(benchmark::kMillisecond);
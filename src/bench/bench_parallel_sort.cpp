@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <list>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "containers.h"
+
+// Scaling of List::parallel_sort from one thread to every hardware thread,
+// next to std::list::sort. Each run sorts a fresh list of random values
+// built with the clock stopped. Threads only pay off once every one of
+// them gets List::kParallelSortGrain nodes or more.
+namespace {
+std::vector<int> random_values(long n) {
+  std::mt19937 gen(53);
+  std::vector<int> values(n);
+  for (auto &value : values) value = static_cast<int>(gen());
+  return values;
+}
+
+void BM_ParallelSort(benchmark::State &state) {
+  const long n = state.range(0);
+  const auto threads = static_cast<size_t>(state.range(1));
+  auto values = random_values(n);
+  for (auto _ : state) {
+    state.PauseTiming();
+    m3mpm::List<int> items;
+    for (int value : values) items.push_back(value);
+    state.ResumeTiming();
+    items.parallel_sort(threads);
+    benchmark::DoNotOptimize(items.front());
+    state.PauseTiming();
+    items.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_StdListSort(benchmark::State &state) {
+  const long n = state.range(0);
+  auto values = random_values(n);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::list<int> items(values.begin(), values.end());
+    state.ResumeTiming();
+    items.sort();
+    benchmark::DoNotOptimize(items.front());
+    state.PauseTiming();
+    items.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Sizes from 10^5 to 10^7 at 1, 2, 4, ... threads and at the hardware
+// thread count. A list of 10^8 ints takes over 3 GiB of nodes, so that
+// size is left out.
+void scaling_args(benchmark::internal::Benchmark *b) {
+  const long cores = std::max(1u, std::thread::hardware_concurrency());
+  for (long n = 100000; n <= 10000000; n *= 10) {
+    for (long threads = 1; threads < cores; threads *= 2) {
+      b->Args({n, threads});
+    }
+    b->Args({n, cores});
+  }
+  b->ArgNames({"n", "threads"});
+}
+}  // namespace
+
+BENCHMARK(BM_ParallelSort)
+    ->Apply(scaling_args)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListSort)
+    ->RangeMultiplier(10)
+    ->Range(100000, 10000000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,254 @@
+#include <benchmark/benchmark.h>
+
+#include <stdint.h>
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "containers.h"
+
+namespace {
+using Entry = std::pair<uint64_t, uint32_t>;
+using Later = std::greater<Entry>;
+
+// The ordered List the schedulers use today: every insert scans from the
+// front for the first later entry.
+m3mpm::List<Entry>::iterator insert_ordered(m3mpm::List<Entry> &items,
+                                     const Entry &entry) {
+  auto pos = items.begin();
+  while (pos != items.end() && *pos < entry) ++pos;
+  return items.insert(pos, entry);
+}
+
+// Random directed graph with about 8 edges per vertex and a path through
+// every vertex, so that all of them are reached.
+struct Graph {
+  std::vector<uint32_t> first;
+  std::vector<uint32_t> target;
+  std::vector<uint32_t> weight;
+};
+
+Graph random_graph(uint32_t vertices) {
+  std::mt19937 gen(40);
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> edges(vertices);
+  for (uint32_t v = 0; v < vertices; ++v) {
+    edges[v].emplace_back((v + 1) % vertices, 1000 + gen() % 1000);
+    for (int e = 0; e < 7; ++e) {
+      edges[v].emplace_back(gen() % vertices, 1 + gen() % 1000);
+    }
+  }
+  Graph graph;
+  for (auto &out : edges) {
+    graph.first.push_back(static_cast<uint32_t>(graph.target.size()));
+    for (auto &edge : out) {
+      graph.target.push_back(edge.first);
+      graph.weight.push_back(edge.second);
+    }
+  }
+  graph.first.push_back(static_cast<uint32_t>(graph.target.size()));
+  return graph;
+}
+
+// Shortest paths with a queue that cannot lower a key: a shorter path
+// pushes another entry and the stale ones are skipped when popped.
+template <typename Queue>
+uint64_t dijkstra_lazy(const Graph &graph, Queue &queue) {
+  const uint32_t n = static_cast<uint32_t>(graph.first.size() - 1);
+  std::vector<uint64_t> dist(n, std::numeric_limits<uint64_t>::max());
+  dist[0] = 0;
+  queue.push(Entry(0, 0));
+  uint64_t total = 0;
+  while (!queue.empty()) {
+    Entry entry = queue.top();
+    queue.pop();
+    if (entry.first != dist[entry.second]) continue;
+    total += entry.first;
+    for (uint32_t e = graph.first[entry.second];
+         e < graph.first[entry.second + 1]; ++e) {
+      uint64_t d = entry.first + graph.weight[e];
+      if (d < dist[graph.target[e]]) {
+        dist[graph.target[e]] = d;
+        queue.push(Entry(d, graph.target[e]));
+      }
+    }
+  }
+  return total;
+}
+
+void BM_DijkstraList(benchmark::State &state) {
+  Graph graph = random_graph(static_cast<uint32_t>(state.range(0)));
+  for (auto _ : state) {
+    struct {
+      m3mpm::List<Entry> items;
+      bool empty() const { return items.empty(); }
+      const Entry &top() const { return items.front(); }
+      void pop() { items.pop_front(); }
+      void push(const Entry &entry) { insert_ordered(items, entry); }
+    } queue;
+    benchmark::DoNotOptimize(dijkstra_lazy(graph, queue));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Queue>
+void BM_DijkstraLazy(benchmark::State &state) {
+  Graph graph = random_graph(static_cast<uint32_t>(state.range(0)));
+  for (auto _ : state) {
+    Queue queue;
+    benchmark::DoNotOptimize(dijkstra_lazy(graph, queue));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The same search keeping one entry per vertex and lowering its key.
+void BM_DijkstraPairingHeap(benchmark::State &state) {
+  using Heap = m3mpm::PairingHeap<Entry, Later>;
+  Graph graph = random_graph(static_cast<uint32_t>(state.range(0)));
+  const uint32_t n = static_cast<uint32_t>(state.range(0));
+  for (auto _ : state) {
+    std::vector<uint64_t> dist(n, std::numeric_limits<uint64_t>::max());
+    std::vector<Heap::handle> queued(n);
+    Heap queue;
+    dist[0] = 0;
+    queue.push(Entry(0, 0));
+    uint64_t total = 0;
+    while (!queue.empty()) {
+      Entry entry = queue.top();
+      queue.pop();
+      total += entry.first;
+      for (uint32_t e = graph.first[entry.second];
+           e < graph.first[entry.second + 1]; ++e) {
+        uint32_t to = graph.target[e];
+        uint64_t d = entry.first + graph.weight[e];
+        if (d >= dist[to]) continue;
+        if (dist[to] == std::numeric_limits<uint64_t>::max()) {
+          queued[to] = queue.push(Entry(d, to));
+        } else {
+          queue.decrease_key(queued[to], Entry(d, to));
+        }
+        dist[to] = d;
+      }
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Timer wheel replacement at a steady state.range(0) armed timers: every
+// step fires the earliest timer and re-arms it, and every fourth step also
+// cancels a random timer and arms it again. The heaps that cannot cancel
+// leave a stale entry behind, told apart by its generation.
+struct TimerLoad {
+  std::mt19937 gen{40};
+  uint64_t now = 0;
+
+  uint64_t delay() { return 1 + gen() % 10000; }
+  uint32_t pick(long n) { return static_cast<uint32_t>(gen() % n); }
+};
+
+void BM_TimersList(benchmark::State &state) {
+  const long n = state.range(0);
+  TimerLoad load;
+  m3mpm::List<Entry> timers;
+  std::vector<m3mpm::List<Entry>::iterator> armed(n);
+  for (uint32_t t = 0; t < n; ++t) {
+    armed[t] = insert_ordered(timers, Entry(load.delay(), t));
+  }
+  long step = 0;
+  for (auto _ : state) {
+    Entry fired = timers.front();
+    timers.pop_front();
+    load.now = fired.first;
+    armed[fired.second] =
+        insert_ordered(timers, Entry(load.now + load.delay(), fired.second));
+    if (++step % 4 == 0) {
+      uint32_t t = load.pick(n);
+      timers.erase(armed[t]);
+      armed[t] = insert_ordered(timers, Entry(load.now + load.delay(), t));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Queue>
+void BM_TimersLazy(benchmark::State &state) {
+  const long n = state.range(0);
+  TimerLoad load;
+  Queue timers;
+  // A timer is (deadline, id * 2^8 + generation).
+  std::vector<uint32_t> generation(n, 0);
+  for (uint32_t t = 0; t < n; ++t) timers.push(Entry(load.delay(), t << 8));
+  long step = 0;
+  for (auto _ : state) {
+    Entry fired = timers.top();
+    timers.pop();
+    uint32_t t = fired.second >> 8;
+    if ((fired.second & 0xff) != generation[t]) continue;
+    load.now = fired.first;
+    timers.push(Entry(load.now + load.delay(), fired.second));
+    if (++step % 4 == 0) {
+      t = load.pick(n);
+      generation[t] = (generation[t] + 1) & 0xff;
+      timers.push(Entry(load.now + load.delay(), t << 8 | generation[t]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_TimersPairingHeap(benchmark::State &state) {
+  using Heap = m3mpm::PairingHeap<Entry, Later>;
+  const long n = state.range(0);
+  TimerLoad load;
+  Heap timers;
+  std::vector<Heap::handle> armed(n);
+  for (uint32_t t = 0; t < n; ++t) {
+    armed[t] = timers.push(Entry(load.delay(), t));
+  }
+  long step = 0;
+  for (auto _ : state) {
+    Entry fired = timers.top();
+    timers.pop();
+    load.now = fired.first;
+    armed[fired.second] =
+        timers.push(Entry(load.now + load.delay(), fired.second));
+    if (++step % 4 == 0) {
+      uint32_t t = load.pick(n);
+      timers.erase(armed[t]);
+      armed[t] = timers.push(Entry(load.now + load.delay(), t));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+using Binary = m3mpm::PriorityQueue<Entry, Later, 2>;
+using FourAry = m3mpm::PriorityQueue<Entry, Later, 4>;
+using StdQueue = std::priority_queue<Entry, std::vector<Entry>, Later>;
+}  // namespace
+
+// The List runs stop where the linear scan makes them take seconds.
+BENCHMARK(BM_DijkstraList)->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+BENCHMARK_TEMPLATE(BM_DijkstraLazy, Binary)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 18);
+BENCHMARK_TEMPLATE(BM_DijkstraLazy, FourAry)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 18);
+BENCHMARK_TEMPLATE(BM_DijkstraLazy, StdQueue)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_DijkstraPairingHeap)->RangeMultiplier(8)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_TimersList)->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+BENCHMARK_TEMPLATE(BM_TimersLazy, Binary)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 18);
+BENCHMARK_TEMPLATE(BM_TimersLazy, FourAry)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 18);
+BENCHMARK_TEMPLATE(BM_TimersLazy, StdQueue)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_TimersPairingHeap)->RangeMultiplier(8)->Range(1 << 6, 1 << 18);
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <stdint.h>
+
+#include <list>
+#include <random>
+#include <vector>
+
+#include "containers.h"
+
+// List::radix_sort against the relinking merge sort (parallel_sort on one
+// thread) and std::list::sort, on events keyed by 64-bit nanosecond
+// timestamps spread over one hour. Such keys share their top two bytes,
+// so the radix sort makes six byte passes. Each run sorts a fresh list
+// built with the clock stopped.
+namespace {
+struct Event {
+  uint64_t timestamp;
+  uint32_t kind;
+  bool operator<(const Event &other) const {
+    return timestamp < other.timestamp;
+  }
+};
+
+std::vector<Event> random_events(long n) {
+  constexpr uint64_t kEpoch = 1700000000000000000ULL;
+  constexpr uint64_t kHourNs = 3600000000000ULL;
+  std::mt19937_64 gen(79);
+  std::vector<Event> events(n);
+  for (auto &event : events) {
+    event.timestamp = kEpoch + gen() % kHourNs;
+    event.kind = static_cast<uint32_t>(gen() % 16);
+  }
+  return events;
+}
+
+template <typename Sort>
+void run_sort(benchmark::State &state, Sort sort) {
+  const long n = state.range(0);
+  auto events = random_events(n);
+  for (auto _ : state) {
+    state.PauseTiming();
+    m3mpm::List<Event> items;
+    for (const Event &event : events) items.push_back(event);
+    state.ResumeTiming();
+    sort(items);
+    benchmark::DoNotOptimize(items.front());
+    state.PauseTiming();
+    items.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_RadixSort(benchmark::State &state) {
+  run_sort(state, [](m3mpm::List<Event> &items) {
+    items.radix_sort([](const Event &event) { return event.timestamp; });
+  });
+}
+
+void BM_MergeSort(benchmark::State &state) {
+  run_sort(state, [](m3mpm::List<Event> &items) { items.parallel_sort(1); });
+}
+
+void BM_StdListSort(benchmark::State &state) {
+  const long n = state.range(0);
+  auto events = random_events(n);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::list<Event> items(events.begin(), events.end());
+    state.ResumeTiming();
+    items.sort();
+    benchmark::DoNotOptimize(items.front());
+    state.PauseTiming();
+    items.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+}  // namespace
+
+BENCHMARK(BM_RadixSort)
+    ->RangeMultiplier(10)
+    ->Range(10000, 10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MergeSort)
+    ->RangeMultiplier(10)
+    ->Range(10000, 10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListSort)
+    ->RangeMultiplier(10)
+    ->Range(10000, 10000000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include "containers.h"
+
+// find (of a value that is not there, so every element is compared),
+// count, min_element and sum over a List and a Deque of 10^6 ints, at each
+// SIMD level: 0 the scalar loops, 1 the 128-bit kernels, 2 the 256-bit
+// ones. Levels the CPU lacks run at the highest level it has. The List
+// still walks one node at a time to gather the values, so it gains less
+// than the Deque, whose blocks the kernels read in place.
+namespace {
+constexpr long kSize = 1000000;
+
+template <typename C>
+C &container() {
+  static C items;
+  if (items.size() == 0) {
+    for (long i = 0; i < kSize; ++i) {
+      items.push_back(static_cast<int>(i % 1000));
+    }
+  }
+  return items;
+}
+
+template <typename C>
+void BM_Find(benchmark::State &state) {
+  C &items = container<C>();
+  m3mpm::set_simd_level(static_cast<m3mpm::SimdLevel>(state.range(0)));
+  for (auto _ : state) benchmark::DoNotOptimize(items.contains(-1));
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+
+template <typename C>
+void BM_Count(benchmark::State &state) {
+  C &items = container<C>();
+  m3mpm::set_simd_level(static_cast<m3mpm::SimdLevel>(state.range(0)));
+  for (auto _ : state) benchmark::DoNotOptimize(items.count(7));
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+
+template <typename C>
+void BM_MinElement(benchmark::State &state) {
+  C &items = container<C>();
+  m3mpm::set_simd_level(static_cast<m3mpm::SimdLevel>(state.range(0)));
+  for (auto _ : state) benchmark::DoNotOptimize(*items.min_element());
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+
+template <typename C>
+void BM_Sum(benchmark::State &state) {
+  C &items = container<C>();
+  m3mpm::set_simd_level(static_cast<m3mpm::SimdLevel>(state.range(0)));
+  for (auto _ : state) benchmark::DoNotOptimize(items.sum());
+  state.SetItemsProcessed(state.iterations() * kSize);
+}
+
+using IntList = m3mpm::List<int>;
+using IntDeque = m3mpm::Deque<int>;
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Find, IntList)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_Count, IntList)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_MinElement, IntList)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_Sum, IntList)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_Find, IntDeque)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_Count, IntDeque)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_MinElement, IntDeque)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_Sum, IntDeque)->DenseRange(0, 2);
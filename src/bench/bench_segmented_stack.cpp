@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+
+#include <stack>
+#include <vector>
+
+#include "containers.h"
+
+namespace {
+// Pushes state.range(0) elements and pops them all again.
+template <typename Container>
+void BM_PushPop(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Container items;
+    for (int i = 0; i < n; ++i) items.push(i);
+    long sum = 0;
+    while (!items.empty()) {
+      sum += items.top();
+      items.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// A stack hovering around a chunk boundary (128 ints fill the first
+// chunk here and the first std::deque block): the worst case for a chunked
+// stack without a spare chunk.
+template <typename Container>
+void BM_BoundaryChurn(benchmark::State &state) {
+  Container items;
+  for (int i = 0; i < 127; ++i) items.push(i);
+  for (auto _ : state) {
+    items.push(1);
+    items.push(2);
+    items.pop();
+    items.pop();
+  }
+  benchmark::DoNotOptimize(items.top());
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_PushPop, m3mpm::Stack<int>)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushPop, m3mpm::SegmentedStack<int>)
+    ->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushPop, std::stack<int>)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushPop, std::stack<int, std::vector<int>>)
+    ->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BoundaryChurn, m3mpm::Stack<int>);
+BENCHMARK_TEMPLATE(BM_BoundaryChurn, m3mpm::SegmentedStack<int>);
+BENCHMARK_TEMPLATE(BM_BoundaryChurn, std::stack<int>);
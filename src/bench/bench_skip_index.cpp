@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "containers.h"
+
+namespace {
+// Order book: a sorted list of prices probed at random price levels.
+void fill_book(m3mpm::List<long> *book, long levels) {
+  for (long i = 0; i < levels; ++i) book->push_back(2 * i);
+}
+
+// Builds the skip index up front so that its O(n) construction stays out
+// of the timed loop.
+void fill_indexed_book(m3mpm::List<long> *book, long levels) {
+  fill_book(book, levels);
+  benchmark::DoNotOptimize(book->at(0));
+}
+
+void BM_PositionalWalk(benchmark::State &state) {
+  m3mpm::List<long> book;
+  fill_book(&book, state.range(0));
+  std::mt19937_64 gen(1);
+  for (auto _ : state) {
+    long pos = static_cast<long>(gen() % book.size());
+    auto it = book.begin();
+    for (long i = 0; i < pos; ++i) ++it;
+    benchmark::DoNotOptimize(*it);
+  }
+}
+
+void BM_PositionalIndexed(benchmark::State &state) {
+  m3mpm::List<long> book;
+  fill_indexed_book(&book, state.range(0));
+  std::mt19937_64 gen(1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(book.at(gen() % book.size()));
+  }
+}
+
+void BM_LowerBoundWalk(benchmark::State &state) {
+  m3mpm::List<long> book;
+  fill_book(&book, state.range(0));
+  std::mt19937_64 gen(1);
+  for (auto _ : state) {
+    long price = static_cast<long>(gen() % (2 * book.size()));
+    auto it = book.begin();
+    while (it != book.end() && *it < price) ++it;
+    benchmark::DoNotOptimize(it);
+  }
+}
+
+void BM_LowerBoundIndexed(benchmark::State &state) {
+  m3mpm::List<long> book;
+  fill_indexed_book(&book, state.range(0));
+  std::mt19937_64 gen(1);
+  for (auto _ : state) {
+    long price = static_cast<long>(gen() % (2 * book.size()));
+    benchmark::DoNotOptimize(book.lower_bound(price));
+  }
+}
+
+// Insert a price level and cancel one, keeping the book size constant:
+// each iteration pays one search plus the index upkeep of both updates.
+void BM_BookUpdateIndexed(benchmark::State &state) {
+  m3mpm::List<long> book;
+  fill_indexed_book(&book, state.range(0));
+  std::mt19937_64 gen(1);
+  for (auto _ : state) {
+    long price = static_cast<long>(gen() % (2 * book.size()));
+    book.insert(book.lower_bound(price), price);
+    book.erase(book.advance(book.begin(), gen() % book.size()));
+  }
+}
+}  // namespace
+
+BENCHMARK(BM_PositionalWalk)->RangeMultiplier(8)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_PositionalIndexed)->RangeMultiplier(8)->Range(1 << 6, 1 << 21);
+BENCHMARK(BM_LowerBoundWalk)->RangeMultiplier(8)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_LowerBoundIndexed)->RangeMultiplier(8)->Range(1 << 6, 1 << 21);
+BENCHMARK(BM_BookUpdateIndexed)->RangeMultiplier(8)->Range(1 << 6, 1 << 21);
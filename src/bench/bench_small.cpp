@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include "containers.h"
+
+namespace {
+// A short-lived container per request: fill it with state.range(0)
+// elements and drain it again. The Small variants stay inline up to 8.
+template <typename Container>
+void BM_FillDrainStack(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Container items;
+    for (int i = 0; i < n; ++i) items.push(i);
+    long sum = 0;
+    while (!items.empty()) {
+      sum += items.top();
+      items.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Container>
+void BM_FillDrainQueue(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Container items;
+    for (int i = 0; i < n; ++i) items.push(i);
+    long sum = 0;
+    while (!items.empty()) {
+      sum += items.front();
+      items.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_FillDrainStack, m3mpm::Stack<int>)
+    ->Arg(4)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(BM_FillDrainStack, m3mpm::SmallStack<int, 8>)
+    ->Arg(4)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(BM_FillDrainQueue, m3mpm::Queue<int>)
+    ->Arg(4)->Arg(8)->Arg(64);
+BENCHMARK_TEMPLATE(BM_FillDrainQueue, m3mpm::SmallQueue<int, 8>)
+    ->Arg(4)->Arg(8)->Arg(64);
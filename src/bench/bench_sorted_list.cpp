@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <set>
+#include <vector>
+
+#include "containers.h"
+
+namespace {
+std::vector<int> random_keys(long n) {
+  std::mt19937 gen(32);
+  std::vector<int> keys(n);
+  for (auto &key : keys) key = static_cast<int>(gen());
+  return keys;
+}
+
+// Building an ordered sequence from unordered input: List appends and sorts
+// once, the ordered containers insert one by one.
+void BM_BuildListSort(benchmark::State &state) {
+  auto keys = random_keys(state.range(0));
+  for (auto _ : state) {
+    m3mpm::List<int> items;
+    for (int key : keys) items.push_back(key);
+    items.sort();
+    benchmark::DoNotOptimize(items.front());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BuildSortedList(benchmark::State &state) {
+  auto keys = random_keys(state.range(0));
+  for (auto _ : state) {
+    m3mpm::SortedList<int> items;
+    for (int key : keys) items.insert(key);
+    benchmark::DoNotOptimize(items.front());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BuildMultiset(benchmark::State &state) {
+  auto keys = random_keys(state.range(0));
+  for (auto _ : state) {
+    std::multiset<int> items;
+    for (int key : keys) items.insert(key);
+    benchmark::DoNotOptimize(*items.begin());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Keeping the sequence ordered while it changes: every step inserts one
+// key and removes the smallest one, as a List user would with push_back
+// followed by sort().
+void BM_ChurnListSort(benchmark::State &state) {
+  auto keys = random_keys(state.range(0));
+  m3mpm::List<int> items;
+  for (int key : keys) items.push_back(key);
+  items.sort();
+  std::mt19937 gen(1);
+  for (auto _ : state) {
+    items.push_back(static_cast<int>(gen()));
+    items.sort();
+    items.pop_front();
+  }
+}
+
+void BM_ChurnSortedList(benchmark::State &state) {
+  auto keys = random_keys(state.range(0));
+  m3mpm::SortedList<int> items;
+  for (int key : keys) items.insert(key);
+  std::mt19937 gen(1);
+  for (auto _ : state) {
+    items.insert(static_cast<int>(gen()));
+    items.pop_front();
+  }
+}
+
+void BM_ChurnMultiset(benchmark::State &state) {
+  auto keys = random_keys(state.range(0));
+  std::multiset<int> items(keys.begin(), keys.end());
+  std::mt19937 gen(1);
+  for (auto _ : state) {
+    items.insert(static_cast<int>(gen()));
+    items.erase(items.begin());
+  }
+}
+
+void BM_FindSortedList(benchmark::State &state) {
+  auto keys = random_keys(state.range(0));
+  m3mpm::SortedList<int> items;
+  for (int key : keys) items.insert(key);
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(items.find(keys[i]));
+    if (++i == keys.size()) i = 0;
+  }
+}
+
+void BM_FindMultiset(benchmark::State &state) {
+  auto keys = random_keys(state.range(0));
+  std::multiset<int> items(keys.begin(), keys.end());
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(items.find(keys[i]));
+    if (++i == keys.size()) i = 0;
+  }
+}
+}  // namespace
+
+// List::sort() is quadratic, so the List runs stop at sizes it finishes.
+BENCHMARK(BM_BuildListSort)->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+BENCHMARK(BM_BuildSortedList)->RangeMultiplier(8)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_BuildMultiset)->RangeMultiplier(8)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_ChurnListSort)->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+BENCHMARK(BM_ChurnSortedList)->RangeMultiplier(8)->Range(1 << 6, 1 << 21);
+BENCHMARK(BM_ChurnMultiset)->RangeMultiplier(8)->Range(1 << 6, 1 << 21);
+BENCHMARK(BM_FindSortedList)->RangeMultiplier(8)->Range(1 << 6, 1 << 21);
+BENCHMARK(BM_FindMultiset)->RangeMultiplier(8)->Range(1 << 6, 1 << 21);
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include "containers.h"
+#include "list_layouts.h"
+#include "perf_counters.h"
+
+namespace {
+enum Layout { kInOrder, kScattered };
+
+// Lists are built once per size and layout and shared by all scan variants.
+m3mpm::List<long> &list_for(const benchmark::State &state) {
+  static m3mpm::List<long> lists[2][32];
+  const long nodes = state.range(0);
+  const int layout = static_cast<int>(state.range(1));
+  int slot = 0;
+  while ((1L << slot) < nodes) ++slot;
+  m3mpm::List<long> &items = lists[layout][slot];
+  if (items.size() != static_cast<size_t>(nodes)) {
+    items.clear();
+    if (layout == kInOrder) {
+      bench::fill_in_order(&items, nodes);
+    } else {
+      bench::fill_scattered(&items, nodes);
+    }
+  }
+  return items;
+}
+
+void BM_ScanIterator(benchmark::State &state) {
+  m3mpm::List<long> &items = list_for(state);
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = items.begin(); it != items.end(); ++it) sum += *it;
+    benchmark::DoNotOptimize(sum);
+  }
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+void BM_ScanForEach(benchmark::State &state) {
+  m3mpm::List<long> &items = list_for(state);
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) {
+    long sum = 0;
+    items.for_each([&sum](long value) { sum += value; });
+    benchmark::DoNotOptimize(sum);
+  }
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+void BM_ScanForEachChunk(benchmark::State &state) {
+  m3mpm::List<long> &items = list_for(state);
+  bench::PerfCounterSet perf;
+  perf.start();
+  for (auto _ : state) {
+    long sum = 0;
+    items.for_each_chunk([&sum](long *const *chunk, size_t count) {
+      for (size_t i = 0; i < count; ++i) sum += *chunk[i];
+    });
+    benchmark::DoNotOptimize(sum);
+  }
+  perf.stop();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  perf.report(state, static_cast<double>(state.items_processed()));
+}
+
+void scan_args(benchmark::internal::Benchmark *b) {
+  for (int layout : {kInOrder, kScattered}) {
+    for (long nodes = 1 << 12; nodes <= 1 << 24; nodes <<= 4) {
+      b->Args({nodes, layout});
+    }
+  }
+  b->ArgNames({"nodes", "scattered"});
+}
+}  // namespace
+
+BENCHMARK(BM_ScanIterator)->Apply(scan_args);
+BENCHMARK(BM_ScanForEach)->Apply(scan_args);
+BENCHMARK(BM_ScanForEachChunk)->Apply(scan_args);
@@ -0,0 +1,425 @@
+// Contention harness: every queue and stack of the library shared between
+// producer and consumer threads behind one std::mutex, the way they are
+// shared today. Reports throughput and the per-element latency of push and
+// pop calls for each container, thread count, batch and element size.
+//
+//   contention.out [--threads=N] [--producers=P --consumers=C]
+//                  [--batch=B] [--bytes=8|64|256|1024] [--items=N]
+//                  [--containers=Queue,Stack,...] [--no-pin] [--csv]
+//
+// Without --threads or --producers/--consumers the run is repeated for 1
+// to std::thread::hardware_concurrency() threads, split evenly between
+// producers and consumers (a single thread alternates between the roles).
+// Every run moves the same --items elements, so the numbers compare across
+// thread counts.
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "containers.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+template <size_t Bytes>
+struct Element {
+  uint64_t seq;
+  std::array<char, Bytes - sizeof(uint64_t)> pad;
+
+  bool operator<(const Element &other) const { return seq < other.seq; }
+};
+
+struct Options {
+  size_t threads = 0;
+  size_t producers = 0;
+  size_t consumers = 0;
+  size_t batch = 1;
+  size_t bytes = 64;
+  size_t items = 1 << 20;
+  std::vector<std::string> containers;
+  bool pin = true;
+  bool csv = false;
+};
+
+struct Result {
+  double seconds = 0;
+  size_t ops = 0;
+  // Nanoseconds per element of every push or pop call.
+  std::vector<uint32_t> latencies;
+};
+
+// The bounded containers refuse a push when full, the others always take
+// it; the lists and the deque are used as FIFO queues.
+template <typename Container, typename E>
+bool put(Container &items, const E &value) {
+  items.push(value);
+  return true;
+}
+template <typename E, size_t N>
+bool put(m3mpm::StaticQueue<E, N> &items, const E &value) {
+  return items.try_push(value);
+}
+template <typename E, size_t N>
+bool put(m3mpm::StaticStack<E, N> &items, const E &value) {
+  return items.try_push(value);
+}
+template <typename E, typename Alloc>
+bool put(m3mpm::Deque<E, Alloc> &items, const E &value) {
+  items.push_back(value);
+  return true;
+}
+template <typename E, typename Alloc>
+bool put(m3mpm::List<E, Alloc> &items, const E &value) {
+  items.push_back(value);
+  return true;
+}
+
+template <typename Container, typename E>
+bool take(Container &items, E &out) {
+  return items.try_pop(out);
+}
+template <typename E, typename Alloc>
+bool take(m3mpm::Deque<E, Alloc> &items, E &out) {
+  return items.try_pop_front(out);
+}
+template <typename E, typename Alloc>
+bool take(m3mpm::List<E, Alloc> &items, E &out) {
+  return items.try_pop_front(out);
+}
+
+// A container and the mutex guarding it; a whole batch moves under one
+// lock.
+template <typename Container>
+class Locked {
+ public:
+  template <typename E>
+  size_t push(const E *values, size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < n; ++i) {
+      if (!put(items_, values[i])) return i;
+    }
+    return n;
+  }
+
+  template <typename E>
+  size_t pop(E *out, size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t i = 0;
+    while (i < n && take(items_, out[i])) ++i;
+    return i;
+  }
+
+ private:
+  std::mutex mutex_;
+  Container items_;
+};
+
+void pin_to_core(size_t core) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(core % CPU_SETSIZE, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)core;
+#endif
+}
+
+size_t hardware_threads() {
+  size_t n = std::thread::hardware_concurrency();
+  return n ? n : 1;
+}
+
+// Times one push or pop call and records its cost per element moved.
+template <typename F>
+size_t timed(std::vector<uint32_t> &latencies, F call) {
+  auto start = Clock::now();
+  size_t moved = call();
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - start)
+                .count();
+  if (moved) latencies.push_back(static_cast<uint32_t>(ns / moved));
+  return moved;
+}
+
+template <typename Container, typename E>
+void produce(Locked<Container> &shared, size_t count, size_t batch,
+             uint64_t first, std::vector<uint32_t> &latencies) {
+  std::vector<E> values(batch);
+  size_t done = 0;
+  while (done < count) {
+    size_t n = std::min(batch, count - done);
+    for (size_t i = 0; i < n; ++i) values[i].seq = first + done + i;
+    size_t sent = 0;
+    while (sent < n) {
+      size_t moved = timed(latencies, [&] {
+        return shared.push(values.data() + sent, n - sent);
+      });
+      sent += moved;
+      if (!moved) std::this_thread::yield();
+    }
+    done += n;
+  }
+}
+
+template <typename Container, typename E>
+void consume(Locked<Container> &shared, std::atomic<size_t> &left,
+             size_t batch, std::vector<uint32_t> &latencies) {
+  std::vector<E> out(batch);
+  while (left.load(std::memory_order_relaxed) > 0) {
+    size_t moved =
+        timed(latencies, [&] { return shared.pop(out.data(), batch); });
+    if (moved) {
+      left.fetch_sub(moved, std::memory_order_relaxed);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+template <typename Container, typename E>
+Result run(const Options &options, size_t producers, size_t consumers) {
+  auto shared = std::make_unique<Locked<Container>>();
+  const size_t threads = producers + consumers;
+  const size_t cores = hardware_threads();
+  std::vector<std::vector<uint32_t>> latencies(std::max<size_t>(threads, 1));
+  for (auto &samples : latencies) {
+    samples.reserve(2 * options.items / options.batch / latencies.size());
+  }
+  Result result;
+  result.ops = 2 * options.items;
+  auto start = Clock::now();
+  if (threads == 0) {
+    // One thread taking both roles in turn. A bounded container may take
+    // only part of a batch; the rest goes in the next round.
+    if (options.pin) pin_to_core(0);
+    std::vector<E> values(options.batch);
+    for (size_t done = 0; done < options.items;) {
+      size_t n = std::min(options.batch, options.items - done);
+      for (size_t i = 0; i < n; ++i) values[i].seq = done + i;
+      size_t pushed = timed(latencies[0],
+                            [&] { return shared->push(values.data(), n); });
+      size_t popped = timed(latencies[0], [&] {
+        return shared->pop(values.data(), pushed);
+      });
+      if (popped == 0) {
+        fprintf(stderr, "contention: the container took no elements\n");
+        exit(1);
+      }
+      done += popped;
+    }
+  } else {
+    std::atomic<size_t> ready(0);
+    std::atomic<size_t> left(options.items);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&, t] {
+        if (options.pin) pin_to_core(t % cores);
+        ready.fetch_add(1);
+        while (ready.load() < threads) std::this_thread::yield();
+        if (t < producers) {
+          size_t share = options.items / producers;
+          size_t first = t * share;
+          if (t + 1 == producers) share = options.items - first;
+          produce<Container, E>(*shared, share, options.batch, first,
+                                latencies[t]);
+        } else {
+          consume<Container, E>(*shared, left, options.batch, latencies[t]);
+        }
+      });
+    }
+    for (auto &worker : workers) worker.join();
+  }
+  result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  for (auto &samples : latencies) {
+    result.latencies.insert(result.latencies.end(), samples.begin(),
+                            samples.end());
+  }
+  return result;
+}
+
+using Runner = std::function<Result(const Options &, size_t, size_t)>;
+
+// Every queue and stack of the library, holding elements of Bytes bytes.
+// The bounded ones hold up to 4096 elements and make producers wait when
+// full.
+template <size_t Bytes>
+std::vector<std::pair<std::string, Runner>> runners() {
+  using E = Element<Bytes>;
+  return {
+      {"Queue", run<m3mpm::Queue<E>, E>},
+      {"SmallQueue", run<m3mpm::SmallQueue<E, 64>, E>},
+      {"StaticQueue", run<m3mpm::StaticQueue<E, 4096>, E>},
+      {"Deque", run<m3mpm::Deque<E>, E>},
+      {"List", run<m3mpm::List<E>, E>},
+      {"PriorityQueue", run<m3mpm::PriorityQueue<E>, E>},
+      {"Stack", run<m3mpm::Stack<E>, E>},
+      {"SmallStack", run<m3mpm::SmallStack<E, 64>, E>},
+      {"StaticStack", run<m3mpm::StaticStack<E, 4096>, E>},
+      {"SegmentedStack", run<m3mpm::SegmentedStack<E>, E>},
+  };
+}
+
+uint32_t percentile(std::vector<uint32_t> &samples, double p) {
+  if (samples.empty()) return 0;
+  size_t k = static_cast<size_t>(p * (samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+  return samples[k];
+}
+
+void report(const Options &options, const std::string &name,
+            size_t producers, size_t consumers, Result &result) {
+  double mops = result.ops / result.seconds / 1e6;
+  uint32_t p50 = percentile(result.latencies, 0.5);
+  uint32_t p99 = percentile(result.latencies, 0.99);
+  uint32_t p999 = percentile(result.latencies, 0.999);
+  size_t threads = producers + consumers;
+  if (threads == 0) producers = consumers = threads = 1;
+  const char *format =
+      options.csv ? "%s,%zu,%zu,%zu,%zu,%zu,%.3f,%u,%u,%u\n"
+                  : "%-15s %7zu %4zu %4zu %5zu %5zu %9.3f %7u %7u %7u\n";
+  printf(format, name.c_str(), threads, producers, consumers, options.batch,
+         options.bytes, mops, p50, p99, p999);
+  fflush(stdout);
+}
+
+bool parse_size(const char *arg, const char *name, size_t &value) {
+  size_t length = strlen(name);
+  if (strncmp(arg, name, length) != 0 || arg[length] != '=') return false;
+  char *end = nullptr;
+  value = strtoull(arg + length + 1, &end, 10);
+  if (*end != '\0') {
+    fprintf(stderr, "contention: bad value in %s\n", arg);
+    exit(2);
+  }
+  return true;
+}
+
+std::vector<std::string> split(const char *list) {
+  std::vector<std::string> names;
+  std::string name;
+  for (const char *c = list;; ++c) {
+    if (*c == ',' || *c == '\0') {
+      if (!name.empty()) names.push_back(name);
+      name.clear();
+      if (*c == '\0') break;
+    } else {
+      name += *c;
+    }
+  }
+  return names;
+}
+
+Options parse(int argc, char *argv[]) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (parse_size(arg, "--threads", options.threads) ||
+        parse_size(arg, "--producers", options.producers) ||
+        parse_size(arg, "--consumers", options.consumers) ||
+        parse_size(arg, "--batch", options.batch) ||
+        parse_size(arg, "--bytes", options.bytes) ||
+        parse_size(arg, "--items", options.items)) {
+      continue;
+    } else if (strncmp(arg, "--containers=", 13) == 0) {
+      options.containers = split(arg + 13);
+    } else if (strcmp(arg, "--no-pin") == 0) {
+      options.pin = false;
+    } else if (strcmp(arg, "--csv") == 0) {
+      options.csv = true;
+    } else {
+      fprintf(stderr, "contention: unknown option %s\n", arg);
+      exit(2);
+    }
+  }
+  if (options.batch == 0 || options.items == 0) {
+    fprintf(stderr, "contention: --batch and --items must be positive\n");
+    exit(2);
+  }
+  if ((options.producers == 0) != (options.consumers == 0)) {
+    fprintf(stderr, "contention: give both --producers and --consumers\n");
+    exit(2);
+  }
+  return options;
+}
+
+// (producers, consumers) pairs to run; (0, 0) is the single-thread run.
+std::vector<std::pair<size_t, size_t>> thread_splits(const Options &options) {
+  if (options.producers) return {{options.producers, options.consumers}};
+  std::vector<std::pair<size_t, size_t>> splits;
+  size_t first = options.threads ? options.threads : 1;
+  size_t last = options.threads ? options.threads : hardware_threads();
+  for (size_t t = first; t <= last; ++t) {
+    if (t == 1) {
+      splits.emplace_back(0, 0);
+    } else {
+      splits.emplace_back((t + 1) / 2, t / 2);
+    }
+  }
+  return splits;
+}
+
+template <size_t Bytes>
+int run_all(const Options &options) {
+  auto all = runners<Bytes>();
+  for (auto &wanted : options.containers) {
+    bool known = std::any_of(all.begin(), all.end(), [&](auto &runner) {
+      return runner.first == wanted;
+    });
+    if (!known) {
+      fprintf(stderr, "contention: unknown container %s\n", wanted.c_str());
+      return 2;
+    }
+  }
+  printf(options.csv ? "container,threads,producers,consumers,batch,bytes,"
+                       "mops,p50_ns,p99_ns,p999_ns\n"
+                     : "container       threads prod cons batch bytes"
+                       "    Mops/s p50(ns) p99(ns) p99.9(ns)\n");
+  for (auto &split : thread_splits(options)) {
+    for (auto &runner : all) {
+      if (!options.containers.empty() &&
+          std::find(options.containers.begin(), options.containers.end(),
+                    runner.first) == options.containers.end()) {
+        continue;
+      }
+      Result result = runner.second(options, split.first, split.second);
+      report(options, runner.first, split.first, split.second, result);
+    }
+  }
+  return 0;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  Options options = parse(argc, argv);
+  switch (options.bytes) {
+    case 8:
+      return run_all<8>(options);
+    case 64:
+      return run_all<64>(options);
+    case 256:
+      return run_all<256>(options);
+    case 1024:
+      return run_all<1024>(options);
+  }
+  fprintf(stderr, "contention: --bytes must be 8, 64, 256 or 1024\n");
+  return 2;
+}
@@ -0,0 +1,36 @@
+#ifndef SRC_BENCH_LIST_LAYOUTS_H_
+#define SRC_BENCH_LIST_LAYOUTS_H_
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "list.h"
+
+namespace bench {
+// Appends nodes values 0..nodes-1 to an empty list, one allocation after
+// the other, so consecutive nodes are evenly spaced in memory.
+template <typename List>
+void fill_in_order(List *items, long nodes) {
+  for (long i = 0; i < nodes; ++i) items->push_back(i);
+}
+
+// Erasing the nodes in random order and appending a replacement after each
+// erase makes the allocator hand the freed blocks back in shuffled order, so
+// the list ends up linked through the heap at random.
+template <typename List>
+void fill_scattered(List *items, long nodes) {
+  std::vector<typename List::iterator> positions;
+  for (long i = 0; i < nodes; ++i) {
+    items->push_back(i);
+    positions.push_back(--items->end());
+  }
+  std::shuffle(positions.begin(), positions.end(), std::mt19937(7));
+  for (auto &pos : positions) {
+    auto value = *pos;
+    items->erase(pos);
+    items->push_back(value);
+  }
+}
+}  // namespace bench
+
+#endif  // SRC_BENCH_LIST_LAYOUTS_H_
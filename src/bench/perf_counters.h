@@ -0,0 +1,172 @@
+#ifndef SRC_BENCH_PERF_COUNTERS_H_
+#define SRC_BENCH_PERF_COUNTERS_H_
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <string.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+// A hardware event of the calling thread, counted in user space through
+// perf_event_open. When the kernel or the hypervisor does not expose the
+// event, available() is false and value() stays 0, so benchmarks still run.
+class PerfCounter {
+ public:
+  PerfCounter(uint32_t type, uint64_t config) : fd_(-1) {
+#ifdef __linux__
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+    (void)type;
+    (void)config;
+#endif
+  }
+  ~PerfCounter() {
+#ifdef __linux__
+    if (fd_ >= 0) close(fd_);
+#endif
+  }
+  PerfCounter(const PerfCounter &) = delete;
+  PerfCounter &operator=(const PerfCounter &) = delete;
+
+  bool available() const { return fd_ >= 0; }
+
+  void start() {
+#ifdef __linux__
+    if (fd_ < 0) return;
+    ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  // Counts on from where stop() left off, for spans the timer skips.
+  void resume() {
+#ifdef __linux__
+    if (fd_ >= 0) ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  void stop() {
+#ifdef __linux__
+    if (fd_ >= 0) ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+  }
+
+  // When more events are open than the PMU has counters, the kernel
+  // multiplexes them and each one only counts part of the time; the count
+  // is scaled up to the whole time the event was enabled.
+  uint64_t value() const {
+    uint64_t count = 0;
+#ifdef __linux__
+    uint64_t data[3];
+    if (fd_ >= 0 && read(fd_, data, sizeof(data)) == sizeof(data)) {
+      count = data[0];
+      if (data[2] != 0 && data[2] < data[1]) {
+        count = static_cast<uint64_t>(static_cast<double>(count) *
+                                      static_cast<double>(data[1]) /
+                                      static_cast<double>(data[2]));
+      }
+    }
+#endif
+    return count;
+  }
+
+ private:
+  int fd_;
+};
+
+#ifdef __linux__
+inline constexpr uint64_t kDtlbLoadMisses =
+    PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+#endif
+
+// The events that tell a layout change from a change in the work done:
+// last-level cache misses, branch misses and dTLB load misses per element,
+// plus instructions per cycle. Each event is opened on its own, so a
+// hypervisor that hides some of them still leaves the others. Wrap the
+// timed loop in start() and stop(), with stop() and resume() around
+// PauseTiming() and ResumeTiming(), then report() the counts next to the
+// wall time.
+class PerfCounterSet {
+ public:
+#ifdef __linux__
+  PerfCounterSet()
+      : cycles_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES),
+        instructions_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS),
+        cache_misses_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES),
+        branch_misses_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES),
+        dtlb_misses_(PERF_TYPE_HW_CACHE, kDtlbLoadMisses) {}
+#else
+  PerfCounterSet()
+      : cycles_(0, 0),
+        instructions_(0, 0),
+        cache_misses_(0, 0),
+        branch_misses_(0, 0),
+        dtlb_misses_(0, 0) {}
+#endif
+
+  void start() {
+    for (PerfCounter *counter : all_) counter->start();
+  }
+  void resume() {
+    for (PerfCounter *counter : all_) counter->resume();
+  }
+  void stop() {
+    for (PerfCounter *counter : all_) counter->stop();
+  }
+
+  // Adds IPC and the misses per element to the run's counters, skipping
+  // the events that could not be opened; with none of them the run is
+  // labelled instead.
+  void report(benchmark::State &state, double items) const {
+    bool any = false;
+    if (cycles_.available() && instructions_.available()) {
+      uint64_t cycles = cycles_.value();
+      if (cycles != 0) {
+        state.counters["IPC"] = static_cast<double>(instructions_.value()) /
+                                static_cast<double>(cycles);
+      }
+      any = true;
+    }
+    any |= per_item(state, "cache-misses/item", cache_misses_, items);
+    any |= per_item(state, "branch-misses/item", branch_misses_, items);
+    any |= per_item(state, "dTLB-misses/item", dtlb_misses_, items);
+    if (!any) state.SetLabel("perf counters unavailable");
+  }
+
+ private:
+  PerfCounter cycles_;
+  PerfCounter instructions_;
+  PerfCounter cache_misses_;
+  PerfCounter branch_misses_;
+  PerfCounter dtlb_misses_;
+
+  PerfCounter *const all_[5] = {&cycles_, &instructions_, &cache_misses_,
+                                &branch_misses_, &dtlb_misses_};
+
+  static bool per_item(benchmark::State &state, const char *name,
+                       const PerfCounter &counter, double items) {
+    if (!counter.available()) return false;
+    if (items > 0) {
+      state.counters[name] = static_cast<double>(counter.value()) / items;
+    }
+    return true;
+  }
+};
+}  // namespace bench
+
+#endif  // SRC_BENCH_PERF_COUNTERS_H_
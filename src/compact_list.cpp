@@ -0,0 +1,586 @@
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace m3mpm {
+template <typename T>
+typename CompactList<T>::compactIterator::reference
+CompactList<T>::compactIterator::operator*() const {
+  if (kCheckedIterators) {
+    if (list_ == nullptr)
+      M3MPM_THROW(std::logic_error("error operator*(): iterator is empty"));
+    if (index_ == kSentinel)
+      M3MPM_THROW(std::logic_error("error operator*(): dereferencing end()"));
+  }
+
+  return list_->values_[index_];
+}
+
+template <typename T>
+typename CompactList<T>::compactIterator::pointer
+CompactList<T>::compactIterator::operator->() const {
+  return std::addressof(**this);
+}
+
+template <typename T>
+typename CompactList<T>::compactIterator &
+CompactList<T>::compactIterator::operator++() {
+  if (kCheckedIterators && list_ == nullptr)
+    M3MPM_THROW(std::logic_error("error operator++(): iterator is empty"));
+
+  index_ = list_->next_[index_];
+  return *this;
+}
+
+template <typename T>
+typename CompactList<T>::compactIterator
+CompactList<T>::compactIterator::operator++(int) {
+  compactIterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+template <typename T>
+typename CompactList<T>::compactIterator &
+CompactList<T>::compactIterator::operator--() {
+  if (kCheckedIterators && list_ == nullptr)
+    M3MPM_THROW(std::logic_error("error operator--(): iterator is empty"));
+
+  index_ = list_->prev_[index_];
+  return *this;
+}
+
+template <typename T>
+typename CompactList<T>::compactIterator
+CompactList<T>::compactIterator::operator--(int) {
+  compactIterator tmp(*this);
+  --*this;
+  return tmp;
+}
+
+template <typename T>
+bool CompactList<T>::compactIterator::operator==(
+    const compactIterator &other) const {
+  return list_ == other.list_ && index_ == other.index_;
+}
+
+template <typename T>
+bool CompactList<T>::compactIterator::operator!=(
+    const compactIterator &other) const {
+  return !this->operator==(other);
+}
+
+template <typename T>
+typename CompactList<T>::compactConstIterator::reference
+CompactList<T>::compactConstIterator::operator*() const {
+  return compactIterator::operator*();
+}
+
+template <typename T>
+typename CompactList<T>::compactConstIterator::pointer
+CompactList<T>::compactConstIterator::operator->() const {
+  return compactIterator::operator->();
+}
+
+template <typename T>
+typename CompactList<T>::compactConstIterator &
+CompactList<T>::compactConstIterator::operator++() {
+  compactIterator::operator++();
+  return *this;
+}
+
+template <typename T>
+typename CompactList<T>::compactConstIterator
+CompactList<T>::compactConstIterator::operator++(int) {
+  compactConstIterator tmp(*this);
+  compactIterator::operator++();
+  return tmp;
+}
+
+template <typename T>
+typename CompactList<T>::compactConstIterator &
+CompactList<T>::compactConstIterator::operator--() {
+  compactIterator::operator--();
+  return *this;
+}
+
+template <typename T>
+typename CompactList<T>::compactConstIterator
+CompactList<T>::compactConstIterator::operator--(int) {
+  compactConstIterator tmp(*this);
+  compactIterator::operator--();
+  return tmp;
+}
+
+template <typename T>
+CompactList<T>::CompactList()
+    : values_(nullptr),
+      next_(nullptr),
+      prev_(nullptr),
+      size_(0),
+      capacity_(0),
+      used_(0),
+      free_(kSentinel) {}
+
+template <typename T>
+CompactList<T>::CompactList(size_type n) : CompactList() {
+  if (n >= max_size()) {
+    M3MPM_THROW(std::out_of_range(
+        "error CompactList(size_type n): over maximum size"));
+  }
+  reserve(n);
+  for (size_type i = 0; i < n; ++i) create_before(kSentinel, value_type());
+}
+
+template <typename T>
+CompactList<T>::CompactList(std::initializer_list<T> const &items)
+    : CompactList() {
+  reserve(items.size());
+  for (const auto &value : items) push_back(value);
+}
+
+template <typename T>
+CompactList<T>::CompactList(const CompactList &l) : CompactList() {
+  reserve(l.size_);
+  for (auto it = l.cbegin(); it != l.cend(); ++it) push_back(*it);
+}
+
+template <typename T>
+CompactList<T>::CompactList(CompactList &&l) noexcept : CompactList() {
+  swap(l);
+}
+
+template <typename T>
+CompactList<T>::~CompactList() {
+  clear();
+  ::operator delete(values_);
+  delete[] next_;
+  delete[] prev_;
+}
+
+template <typename T>
+CompactList<T> &CompactList<T>::operator=(const CompactList &l) {
+  if (this != &l) {
+    CompactList tmp(l);
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T>
+CompactList<T> &CompactList<T>::operator=(CompactList &&l) noexcept {
+  if (this != &l) {
+    clear();
+    swap(l);
+  }
+  return *this;
+}
+
+template <typename T>
+typename CompactList<T>::const_reference CompactList<T>::front() const {
+  if (empty()) {
+    M3MPM_THROW(std::range_error("error front(): the CompactList is empty"));
+  }
+  return values_[next_[kSentinel]];
+}
+
+template <typename T>
+typename CompactList<T>::const_reference CompactList<T>::back() const {
+  if (empty()) {
+    M3MPM_THROW(std::range_error("error back(): the CompactList is empty"));
+  }
+  return values_[prev_[kSentinel]];
+}
+
+template <typename T>
+typename CompactList<T>::size_type CompactList<T>::max_size() const {
+  return std::numeric_limits<handle_type>::max() - 1;
+}
+
+template <typename T>
+void CompactList<T>::reserve(size_type n) {
+  if (n >= max_size()) {
+    M3MPM_THROW(std::out_of_range("error reserve(): over maximum size"));
+  }
+  if (n + 1 > capacity_) grow(n + 1);
+}
+
+template <typename T>
+void CompactList<T>::grow(size_type new_capacity) {
+  // Everything is built in the new buffers before the old ones are
+  // touched, so a failure leaves the list as it was.
+  T *values = static_cast<T *>(::operator new(new_capacity * sizeof(T)));
+  handle_type *next = nullptr;
+  handle_type *prev = nullptr;
+  M3MPM_TRY {
+    next = new handle_type[new_capacity];
+    prev = new handle_type[new_capacity];
+  } M3MPM_CATCH_ALL {
+    delete[] next;
+    ::operator delete(values);
+    M3MPM_RETHROW;
+  }
+  if (capacity_ == 0) {
+    next[kSentinel] = prev[kSentinel] = kSentinel;
+    used_ = 1;
+  } else {
+    std::copy(next_, next_ + used_, next);
+    std::copy(prev_, prev_ + used_, prev);
+    size_type built = 0;
+    M3MPM_TRY {
+      for (handle_type i = next_[kSentinel]; i != kSentinel; i = next_[i]) {
+        new (values + i) T(std::move_if_noexcept(values_[i]));
+        ++built;
+      }
+    } M3MPM_CATCH_ALL {
+      for (handle_type i = next_[kSentinel]; built != 0; i = next_[i]) {
+        values[i].~T();
+        --built;
+      }
+      delete[] prev;
+      delete[] next;
+      ::operator delete(values);
+      M3MPM_RETHROW;
+    }
+    for (handle_type i = next_[kSentinel]; i != kSentinel; i = next_[i]) {
+      values_[i].~T();
+    }
+  }
+  ::operator delete(values_);
+  delete[] next_;
+  delete[] prev_;
+  values_ = values;
+  next_ = next;
+  prev_ = prev;
+  capacity_ = new_capacity;
+}
+
+template <typename T>
+template <typename V>
+typename CompactList<T>::handle_type CompactList<T>::create_before(
+    handle_type pos, V &&value) {
+  handle_type slot = free_;
+  if (slot != kSentinel) {
+    new (values_ + slot) T(std::forward<V>(value));
+    free_ = next_[slot];
+  } else {
+    if (size_ + 1 >= max_size()) {
+      M3MPM_THROW(std::out_of_range(
+          "error CompactList: maximum size exceeded"));
+    }
+    slot = static_cast<handle_type>(used_);
+    if (used_ == capacity_) {
+      // value may refer to an element of this list, which grow() moves.
+      T copy(std::forward<V>(value));
+      size_type grown = capacity_ < 8 ? 8 : capacity_ + capacity_ / 2;
+      grow(grown < max_size() ? grown : max_size());
+      slot = static_cast<handle_type>(used_);
+      new (values_ + slot) T(std::move(copy));
+    } else {
+      new (values_ + slot) T(std::forward<V>(value));
+    }
+    ++used_;
+  }
+  link_before(pos, slot);
+  ++size_;
+  return slot;
+}
+
+template <typename T>
+void CompactList<T>::destroy(handle_type slot) {
+  unlink(slot);
+  values_[slot].~T();
+  next_[slot] = free_;
+  free_ = slot;
+  --size_;
+}
+
+template <typename T>
+void CompactList<T>::link_before(handle_type pos, handle_type slot) {
+  handle_type before = prev_[pos];
+  next_[slot] = pos;
+  prev_[slot] = before;
+  next_[before] = slot;
+  prev_[pos] = slot;
+}
+
+template <typename T>
+void CompactList<T>::unlink(handle_type slot) {
+  next_[prev_[slot]] = next_[slot];
+  prev_[next_[slot]] = prev_[slot];
+}
+
+template <typename T>
+void CompactList<T>::push_front(const_reference value) {
+  create_before(capacity_ ? next_[kSentinel] : kSentinel, value);
+}
+
+template <typename T>
+void CompactList<T>::pop_front() {
+  if (empty()) {
+    M3MPM_THROW(std::range_error(
+        "error pop_front(): the CompactList is empty"));
+  }
+  destroy(next_[kSentinel]);
+}
+
+template <typename T>
+void CompactList<T>::push_back(const_reference value) {
+  create_before(kSentinel, value);
+}
+
+template <typename T>
+void CompactList<T>::pop_back() {
+  if (empty()) {
+    M3MPM_THROW(std::range_error("error pop_back(): the CompactList is empty"));
+  }
+  destroy(prev_[kSentinel]);
+}
+
+template <typename T>
+const typename CompactList<T>::value_type *CompactList<T>::try_front() const {
+  return empty() ? nullptr : values_ + next_[kSentinel];
+}
+
+template <typename T>
+const typename CompactList<T>::value_type *CompactList<T>::try_back() const {
+  return empty() ? nullptr : values_ + prev_[kSentinel];
+}
+
+template <typename T>
+bool CompactList<T>::try_pop_front(value_type &out) {
+  if (empty()) return false;
+  out = std::move(values_[next_[kSentinel]]);
+  destroy(next_[kSentinel]);
+  return true;
+}
+
+template <typename T>
+std::optional<typename CompactList<T>::value_type>
+CompactList<T>::try_pop_front() {
+  if (empty()) return std::nullopt;
+  std::optional<value_type> out(std::move(values_[next_[kSentinel]]));
+  destroy(next_[kSentinel]);
+  return out;
+}
+
+template <typename T>
+bool CompactList<T>::try_pop_back(value_type &out) {
+  if (empty()) return false;
+  out = std::move(values_[prev_[kSentinel]]);
+  destroy(prev_[kSentinel]);
+  return true;
+}
+
+template <typename T>
+std::optional<typename CompactList<T>::value_type>
+CompactList<T>::try_pop_back() {
+  if (empty()) return std::nullopt;
+  std::optional<value_type> out(std::move(values_[prev_[kSentinel]]));
+  destroy(prev_[kSentinel]);
+  return out;
+}
+
+template <typename T>
+void CompactList<T>::clear() {
+  if (capacity_ == 0) return;
+  for (handle_type i = next_[kSentinel]; i != kSentinel; i = next_[i]) {
+    values_[i].~T();
+  }
+  next_[kSentinel] = prev_[kSentinel] = kSentinel;
+  size_ = 0;
+  used_ = 1;
+  free_ = kSentinel;
+}
+
+template <typename T>
+void CompactList<T>::swap(CompactList &other) noexcept {
+  std::swap(values_, other.values_);
+  std::swap(next_, other.next_);
+  std::swap(prev_, other.prev_);
+  std::swap(size_, other.size_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(used_, other.used_);
+  std::swap(free_, other.free_);
+}
+
+template <typename T>
+void CompactList<T>::reverse() {
+  if (empty()) return;
+  handle_type i = kSentinel;
+  do {
+    std::swap(next_[i], prev_[i]);
+    i = prev_[i];
+  } while (i != kSentinel);
+}
+
+template <typename T>
+typename CompactList<T>::iterator CompactList<T>::begin() {
+  return iterator(this, capacity_ ? next_[kSentinel] : kSentinel);
+}
+
+template <typename T>
+typename CompactList<T>::iterator CompactList<T>::end() {
+  return iterator(this, kSentinel);
+}
+
+template <typename T>
+typename CompactList<T>::const_iterator CompactList<T>::cbegin() const {
+  return const_iterator(this, capacity_ ? next_[kSentinel] : kSentinel);
+}
+
+template <typename T>
+typename CompactList<T>::const_iterator CompactList<T>::cend() const {
+  return const_iterator(this, kSentinel);
+}
+
+template <typename T>
+void CompactList<T>::sort() {
+  if (size_ < 2) return;
+
+  // Bottom-up merge sort over the next_ chain, which ends at the sentinel
+  // (index 0). bins[i] holds a sorted run of 2^i slots that precede every
+  // slot of bins[i - 1]; ties keep the earlier slot first.
+  auto merge_runs = [this](handle_type a, handle_type b) {
+    handle_type head = kSentinel;
+    handle_type *tail = &head;
+    while (a != kSentinel && b != kSentinel) {
+      if (values_[b] < values_[a]) {
+        *tail = b;
+        tail = &next_[b];
+        b = next_[b];
+      } else {
+        *tail = a;
+        tail = &next_[a];
+        a = next_[a];
+      }
+    }
+    *tail = a != kSentinel ? a : b;
+    return head;
+  };
+
+  handle_type bins[64] = {};
+  handle_type cur = next_[kSentinel];
+  while (cur != kSentinel) {
+    handle_type run = cur;
+    cur = next_[cur];
+    next_[run] = kSentinel;
+    size_type i = 0;
+    for (; bins[i] != kSentinel; ++i) {
+      run = merge_runs(bins[i], run);
+      bins[i] = kSentinel;
+    }
+    bins[i] = run;
+  }
+  handle_type sorted = kSentinel;
+  for (handle_type bin : bins) {
+    if (bin != kSentinel) sorted = merge_runs(bin, sorted);
+  }
+
+  handle_type before = kSentinel;
+  for (handle_type i = sorted; i != kSentinel; i = next_[i]) {
+    prev_[i] = before;
+    before = i;
+  }
+  next_[kSentinel] = sorted;
+  prev_[kSentinel] = before;
+}
+
+template <typename T>
+void CompactList<T>::erase(iterator pos) {
+  if (pos.list_ != this || pos.index_ == kSentinel) {
+    M3MPM_THROW(std::range_error(
+        "error erase(): the iterator is empty or points past the end"));
+  }
+  destroy(pos.index_);
+}
+
+template <typename T>
+void CompactList<T>::unique() {
+  if (size_ < 2) return;
+  handle_type i = next_[next_[kSentinel]];
+  while (i != kSentinel) {
+    handle_type following = next_[i];
+    if (values_[i] == values_[prev_[i]]) destroy(i);
+    i = following;
+  }
+}
+
+template <typename T>
+typename CompactList<T>::iterator CompactList<T>::insert(
+    iterator pos, const_reference value) {
+  return iterator(this, create_before(pos.index_, value));
+}
+
+template <typename T>
+void CompactList<T>::merge(CompactList &other) {
+  if (this == &other) return;
+  reserve(size_ + other.size_);
+  handle_type pos = next_[kSentinel];
+  for (handle_type i = other.cbegin().index_; i != kSentinel;
+       i = other.next_[i]) {
+    while (pos != kSentinel && !(other.values_[i] < values_[pos])) {
+      pos = next_[pos];
+    }
+    create_before(pos, std::move(other.values_[i]));
+  }
+  other.clear();
+}
+
+template <typename T>
+void CompactList<T>::splice(const_iterator pos, CompactList &other) {
+  if (this == &other || other.empty()) return;
+  if (size_ + other.size_ >= max_size()) {
+    M3MPM_THROW(std::out_of_range("splice() error: maximum size exceeded"));
+  }
+  reserve(size_ + other.size_);
+  for (handle_type i = other.next_[kSentinel]; i != kSentinel;
+       i = other.next_[i]) {
+    create_before(pos.index_, std::move(other.values_[i]));
+  }
+  other.clear();
+}
+
+template <typename T>
+template <typename... Args>
+typename CompactList<T>::iterator CompactList<T>::emplace(const_iterator pos,
+                                                          Args &&...args) {
+  handle_type last = pos.index_;
+  if constexpr (sizeof...(Args) == 0) {
+    last = create_before(pos.index_, value_type());
+  } else {
+    ((last = create_before(pos.index_, std::forward<Args>(args))), ...);
+  }
+  return iterator(this, last);
+}
+
+template <typename T>
+template <typename... Args>
+void CompactList<T>::emplace_back(Args &&...args) {
+  if constexpr (sizeof...(Args) == 0) {
+    create_before(kSentinel, value_type());
+  } else {
+    (create_before(kSentinel, std::forward<Args>(args)), ...);
+  }
+}
+
+template <typename T>
+template <typename... Args>
+void CompactList<T>::emplace_front(Args &&...args) {
+  if constexpr (sizeof...(Args) == 0) {
+    push_front(value_type());
+  } else {
+    handle_type pos = begin().index_;
+    (create_before(pos, std::forward<Args>(args)), ...);
+  }
+}
+
+template <typename T>
+void CompactList<T>::print() const {
+  for (auto it = cbegin(); it != cend(); ++it) std::cout << *it << " ";
+  std::cout << std::endl;
+}
+
+}  // namespace m3mpm
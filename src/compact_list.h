@@ -0,0 +1,165 @@
+#ifndef SRC_M3MPM_COMPACT_LIST_H_
+#define SRC_M3MPM_COMPACT_LIST_H_
+#include <stddef.h>
+#include <stdint.h>
+
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+
+#include "config.h"
+
+namespace m3mpm {
+// Doubly linked list with the List interface whose links are 32-bit slot
+// indices instead of pointers. Elements live in one contiguous array and
+// the next/prev indices in two more, so a CompactList<int32_t> spends 12
+// bytes per element where List<int32_t> spends a 24-byte heap node. Slot 0
+// is the sentinel behind end(); erased slots are chained into a free list
+// and reused before the arrays grow. Growing moves the elements, so
+// pointers and references into the list are invalidated by insertions,
+// while handles (slot indices) stay valid until their element is erased.
+template <typename T>
+class CompactList {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using handle_type = uint32_t;
+
+  // Bidirectional iterators, checked as configured in config.h.
+  class compactIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    CompactList *list_;
+    handle_type index_;
+
+    compactIterator() : list_(nullptr), index_(0) {}
+    compactIterator(const CompactList *list, handle_type index)
+        : list_(const_cast<CompactList *>(list)), index_(index) {}
+
+    reference operator*() const;
+    pointer operator->() const;
+    compactIterator &operator++();
+    compactIterator operator++(int);
+    compactIterator &operator--();
+    compactIterator operator--(int);
+    bool operator==(const compactIterator &other) const;
+    bool operator!=(const compactIterator &other) const;
+  };
+
+  class compactConstIterator : public compactIterator {
+   public:
+    using pointer = const T *;
+    using reference = const T &;
+
+    compactConstIterator() : compactIterator() {}
+    compactConstIterator(const CompactList *list, handle_type index)
+        : compactIterator(list, index) {}
+    compactConstIterator(const compactIterator &other)
+        : compactIterator(other) {}
+
+    reference operator*() const;
+    pointer operator->() const;
+    compactConstIterator &operator++();
+    compactConstIterator operator++(int);
+    compactConstIterator &operator--();
+    compactConstIterator operator--(int);
+  };
+  using iterator = compactIterator;
+  using const_iterator = compactConstIterator;
+
+ public:
+  CompactList();
+  explicit CompactList(size_type n);
+  explicit CompactList(std::initializer_list<T> const &items);
+  CompactList(const CompactList &l);
+  CompactList(CompactList &&l) noexcept;
+  ~CompactList();
+  CompactList &operator=(const CompactList &l);
+  CompactList &operator=(CompactList &&l) noexcept;
+
+  const_reference front() const;
+  const_reference back() const;
+
+  size_type size() const { return size_; }
+  size_type max_size() const;
+  bool empty() const { return size_ == 0; }
+  size_type capacity() const { return capacity_ == 0 ? 0 : capacity_ - 1; }
+  void reserve(size_type n);
+
+  void push_front(const_reference value);
+  void pop_front();
+  void push_back(const_reference value);
+  void pop_back();
+  void clear();
+  void swap(CompactList &other) noexcept;
+
+  // front(), back() and the pops without the exception path: an empty list
+  // gives null, false or an empty optional.
+  const value_type *try_front() const;
+  const value_type *try_back() const;
+  bool try_pop_front(value_type &out);
+  std::optional<value_type> try_pop_front();
+  bool try_pop_back(value_type &out);
+  std::optional<value_type> try_pop_back();
+  void reverse();
+
+  iterator begin();
+  iterator end();
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+
+  void sort();
+  void erase(iterator pos);
+  void unique();
+  iterator insert(iterator pos, const_reference value);
+  void merge(CompactList &other);
+  void splice(const_iterator pos, CompactList &other);
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args);
+  template <typename... Args>
+  void emplace_back(Args &&...args);
+  template <typename... Args>
+  void emplace_front(Args &&...args);
+
+  // Handles name an element by its slot and survive growth, sort(),
+  // reverse() and every insertion or erasure of other elements.
+  handle_type handle(const_iterator pos) const { return pos.index_; }
+  iterator find(handle_type h) { return iterator(this, h); }
+  reference get(handle_type h) { return values_[h]; }
+  const_reference get(handle_type h) const { return values_[h]; }
+
+  void print() const;
+
+ private:
+  static constexpr handle_type kSentinel = 0;
+
+  T *values_;
+  handle_type *next_;
+  handle_type *prev_;
+  size_type size_;
+  size_type capacity_;
+  // Slots below used_ have been handed out at least once; the erased ones
+  // among them are chained through next_ starting at free_.
+  size_type used_;
+  handle_type free_;
+
+  void grow(size_type new_capacity);
+  template <typename V>
+  handle_type create_before(handle_type pos, V &&value);
+  void destroy(handle_type slot);
+  void link_before(handle_type pos, handle_type slot);
+  void unlink(handle_type slot);
+};
+}  // namespace m3mpm
+#include "compact_list.cpp"
+#endif  // SRC_M3MPM_COMPACT_LIST_H_
@@ -0,0 +1,54 @@
+#ifndef SRC_M3MPM_CONFIG_H_
+#define SRC_M3MPM_CONFIG_H_
+#include <stdio.h>
+#include <stdlib.h>
+
+// Checked iterators throw std::logic_error when an empty iterator is
+// dereferenced or moved, and when end() is dereferenced, except for List:
+// its end() is the sentinel node, which holds the value-initialized element
+// front() and back() return for an empty list, and dereferences to it.
+// Unchecked iterators compile down to a plain load per dereference and
+// increment. Debug builds are checked and NDEBUG builds unchecked unless
+// M3MPM_CHECKED_ITERATORS is defined to 0 or 1.
+#ifndef M3MPM_CHECKED_ITERATORS
+#ifdef NDEBUG
+#define M3MPM_CHECKED_ITERATORS 0
+#else
+#define M3MPM_CHECKED_ITERATORS 1
+#endif
+#endif
+
+// Errors are reported by throwing. When exceptions are disabled
+// (-fno-exceptions) the same checks print the exception's message and
+// abort instead, and the cleanup blocks around allocations compile away;
+// the non-throwing try_ accessors never reach either path.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#define M3MPM_HAS_EXCEPTIONS 1
+#else
+#define M3MPM_HAS_EXCEPTIONS 0
+#endif
+
+#if M3MPM_HAS_EXCEPTIONS
+#define M3MPM_THROW(exception) throw exception
+#define M3MPM_TRY try
+#define M3MPM_CATCH_ALL catch (...)
+#define M3MPM_RETHROW throw
+#else
+#define M3MPM_THROW(exception) ::m3mpm::detail::fail((exception).what())
+#define M3MPM_TRY if (true)
+#define M3MPM_CATCH_ALL if (false)
+#define M3MPM_RETHROW ((void)0)
+#endif
+
+namespace m3mpm {
+inline constexpr bool kCheckedIterators = M3MPM_CHECKED_ITERATORS != 0;
+
+namespace detail {
+[[noreturn]] inline void fail(const char *what) {
+  fprintf(stderr, "m3mpm: %s\n", what);
+  abort();
+}
+}  // namespace detail
+}  // namespace m3mpm
+
+#endif  // SRC_M3MPM_CONFIG_H_
@@ -1,8 +1,21 @@
 #ifndef SRC_M3MPM_CONTAINERS_H_
 #define SRC_M3MPM_CONTAINERS_H_
 
+#include "compact_list.h"
+#include "deque.h"
+#include "huge_page_allocator.h"
+#include "latency.h"
 #include "list.h"
+#include "pairing_heap.h"
+#include "priority_queue.h"
 #include "queue.h"
+#include "segmented_stack.h"
+#include "small_queue.h"
+#include "small_stack.h"
+#include "sorted_list.h"
 #include "stack.h"
+#include "static_queue.h"
+#include "static_stack.h"
+#include "thread_cache_allocator.h"
 
 #endif  // SRC_M3MPM_CONTAINERS_H_
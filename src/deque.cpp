@@ -0,0 +1,523 @@
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace m3mpm {
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeIterator::reference
+Deque<T, Alloc>::dequeIterator::operator*() const {
+  if (kCheckedIterators && deque_ == nullptr)
+    M3MPM_THROW(std::logic_error("error operator*(): iterator is empty"));
+  if (kCheckedIterators && index_ >= deque_->size_)
+    M3MPM_THROW(std::logic_error("error operator*(): dereferencing end()"));
+
+  return *deque_->slot(index_);
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeIterator::pointer
+Deque<T, Alloc>::dequeIterator::operator->() const {
+  return std::addressof(**this);
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeIterator &
+Deque<T, Alloc>::dequeIterator::operator++() {
+  if (kCheckedIterators && deque_ == nullptr)
+    M3MPM_THROW(std::logic_error("error operator++(): iterator is empty"));
+
+  ++index_;
+  return *this;
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeIterator
+Deque<T, Alloc>::dequeIterator::operator++(int) {
+  dequeIterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeIterator &
+Deque<T, Alloc>::dequeIterator::operator--() {
+  if (kCheckedIterators && deque_ == nullptr)
+    M3MPM_THROW(std::logic_error("error operator--(): iterator is empty"));
+
+  --index_;
+  return *this;
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeIterator
+Deque<T, Alloc>::dequeIterator::operator--(int) {
+  dequeIterator tmp(*this);
+  --*this;
+  return tmp;
+}
+
+template <typename T, typename Alloc>
+bool Deque<T, Alloc>::dequeIterator::operator==(
+    const dequeIterator &other) const {
+  return deque_ == other.deque_ && index_ == other.index_;
+}
+
+template <typename T, typename Alloc>
+bool Deque<T, Alloc>::dequeIterator::operator!=(
+    const dequeIterator &other) const {
+  return !this->operator==(other);
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeConstIterator::reference
+Deque<T, Alloc>::dequeConstIterator::operator*() const {
+  return dequeIterator::operator*();
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeConstIterator::pointer
+Deque<T, Alloc>::dequeConstIterator::operator->() const {
+  return dequeIterator::operator->();
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeConstIterator &
+Deque<T, Alloc>::dequeConstIterator::operator++() {
+  dequeIterator::operator++();
+  return *this;
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeConstIterator
+Deque<T, Alloc>::dequeConstIterator::operator++(int) {
+  dequeConstIterator tmp(*this);
+  dequeIterator::operator++();
+  return tmp;
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeConstIterator &
+Deque<T, Alloc>::dequeConstIterator::operator--() {
+  dequeIterator::operator--();
+  return *this;
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::dequeConstIterator
+Deque<T, Alloc>::dequeConstIterator::operator--(int) {
+  dequeConstIterator tmp(*this);
+  dequeIterator::operator--();
+  return tmp;
+}
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>::Deque()
+    : map_(nullptr),
+      map_size_(0),
+      first_(0),
+      blocks_(0),
+      start_(0),
+      size_(0),
+      spare_(nullptr) {}
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>::Deque(std::initializer_list<T> const &items) : Deque() {
+  for (auto &value : items) push_back(value);
+}
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>::Deque(const Deque &d) : Deque() {
+  for (size_type i = 0; i < d.size_; ++i) push_back(d[i]);
+}
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>::Deque(Deque &&d) noexcept : Deque() {
+  swap(d);
+}
+
+template <typename T, typename Alloc>
+Deque<T, Alloc>::~Deque() {
+  clear();
+  typename value_traits::allocator_type value_alloc;
+  typename map_traits::allocator_type map_alloc;
+  if (spare_) value_traits::deallocate(value_alloc, spare_, kBlockSize);
+  if (map_) map_traits::deallocate(map_alloc, map_, map_size_);
+}
+
+template <typename T, typename Alloc>
+Deque<T, Alloc> &Deque<T, Alloc>::operator=(const Deque &d) {
+  if (this != &d) {
+    Deque copy(d);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename T, typename Alloc>
+Deque<T, Alloc> &Deque<T, Alloc>::operator=(Deque &&d) noexcept {
+  if (this != &d) {
+    Deque moved(std::move(d));
+    swap(moved);
+  }
+  return *this;
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::swap(Deque &other) noexcept {
+  std::swap(map_, other.map_);
+  std::swap(map_size_, other.map_size_);
+  std::swap(first_, other.first_);
+  std::swap(blocks_, other.blocks_);
+  std::swap(start_, other.start_);
+  std::swap(size_, other.size_);
+  std::swap(spare_, other.spare_);
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::const_reference Deque<T, Alloc>::front() const {
+  if (!size_)
+    M3MPM_THROW(std::range_error("error front(): the Deque is empty"));
+  return *slot(0);
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::const_reference Deque<T, Alloc>::back() const {
+  if (!size_) M3MPM_THROW(std::range_error("error back(): the Deque is empty"));
+  return *slot(size_ - 1);
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::reference Deque<T, Alloc>::at(size_type pos) {
+  if (pos >= size_)
+    M3MPM_THROW(std::out_of_range("error at(): position out of range"));
+  return *slot(pos);
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::const_reference Deque<T, Alloc>::at(
+    size_type pos) const {
+  if (pos >= size_)
+    M3MPM_THROW(std::out_of_range("error at(): position out of range"));
+  return *slot(pos);
+}
+
+template <typename T, typename Alloc>
+T *Deque<T, Alloc>::acquire_block() {
+  if (spare_) {
+    T *block = spare_;
+    spare_ = nullptr;
+    return block;
+  }
+  typename value_traits::allocator_type alloc;
+  return value_traits::allocate(alloc, kBlockSize);
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::release_block(T *block) {
+  if (!spare_) {
+    spare_ = block;
+  } else {
+    typename value_traits::allocator_type alloc;
+    value_traits::deallocate(alloc, block, kBlockSize);
+  }
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::reshape_map() {
+  // At least one free entry on each side of the blocks once this is done.
+  size_type size = map_size_;
+  if (blocks_ + 2 > size / 2) size = std::max<size_type>(8, 2 * size);
+  size_type first = (size - blocks_) / 2;
+  if (size == map_size_ && first < first_) {
+    std::move(map_ + first_, map_ + first_ + blocks_, map_ + first);
+  } else if (size == map_size_) {
+    std::move_backward(map_ + first_, map_ + first_ + blocks_,
+                       map_ + first + blocks_);
+  } else {
+    typename map_traits::allocator_type alloc;
+    T **map = map_traits::allocate(alloc, size);
+    std::copy(map_ + first_, map_ + first_ + blocks_, map + first);
+    if (map_) map_traits::deallocate(alloc, map_, map_size_);
+    map_ = map;
+    map_size_ = size;
+  }
+  first_ = first;
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::add_block_front() {
+  if (first_ == 0) reshape_map();
+  map_[first_ - 1] = acquire_block();
+  --first_;
+  ++blocks_;
+  start_ += kBlockSize;
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::add_block_back() {
+  if (first_ + blocks_ == map_size_) reshape_map();
+  map_[first_ + blocks_] = acquire_block();
+  ++blocks_;
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::push_front(const_reference value) {
+  emplace_front(value);
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::push_front(value_type &&value) {
+  emplace_front(std::move(value));
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::push_back(const_reference value) {
+  emplace_back(value);
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::push_back(value_type &&value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename Deque<T, Alloc>::reference Deque<T, Alloc>::emplace_front(
+    Args &&...args) {
+  const bool added = start_ == 0;
+  if (added) add_block_front();
+  T *element = map_[first_ + (start_ - 1) / kBlockSize] +
+               (start_ - 1) % kBlockSize;
+  typename value_traits::allocator_type alloc;
+  M3MPM_TRY {
+    value_traits::construct(alloc, element, std::forward<Args>(args)...);
+  } M3MPM_CATCH_ALL {
+    if (added) {
+      release_block(map_[first_++]);
+      --blocks_;
+      start_ -= kBlockSize;
+    }
+    M3MPM_RETHROW;
+  }
+  --start_;
+  ++size_;
+  return *element;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename Deque<T, Alloc>::reference Deque<T, Alloc>::emplace_back(
+    Args &&...args) {
+  const bool added = start_ + size_ == blocks_ * kBlockSize;
+  if (added) add_block_back();
+  T *element = slot(size_);
+  typename value_traits::allocator_type alloc;
+  M3MPM_TRY {
+    value_traits::construct(alloc, element, std::forward<Args>(args)...);
+  } M3MPM_CATCH_ALL {
+    if (added) release_block(map_[first_ + --blocks_]);
+    M3MPM_RETHROW;
+  }
+  ++size_;
+  return *element;
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::pop_front() {
+  if (!size_)
+    M3MPM_THROW(std::range_error("error pop_front(): the Deque is empty"));
+  typename value_traits::allocator_type alloc;
+  value_traits::destroy(alloc, slot(0));
+  ++start_;
+  --size_;
+  if (start_ == kBlockSize) {
+    release_block(map_[first_]);
+    ++first_;
+    --blocks_;
+    start_ = 0;
+  }
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::pop_back() {
+  if (!size_)
+    M3MPM_THROW(std::range_error("error pop_back(): the Deque is empty"));
+  typename value_traits::allocator_type alloc;
+  value_traits::destroy(alloc, slot(size_ - 1));
+  --size_;
+  if (start_ + size_ == (blocks_ - 1) * kBlockSize) {
+    release_block(map_[first_ + blocks_ - 1]);
+    --blocks_;
+    if (!blocks_) start_ = 0;
+  }
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::clear() {
+  typename value_traits::allocator_type alloc;
+  for (size_type i = 0; i < size_; ++i) value_traits::destroy(alloc, slot(i));
+  for (size_type i = 0; i < blocks_; ++i) release_block(map_[first_ + i]);
+  first_ = map_size_ / 2;
+  blocks_ = 0;
+  start_ = 0;
+  size_ = 0;
+}
+
+template <typename T, typename Alloc>
+const typename Deque<T, Alloc>::value_type *Deque<T, Alloc>::try_front()
+    const {
+  return size_ ? slot(0) : nullptr;
+}
+
+template <typename T, typename Alloc>
+const typename Deque<T, Alloc>::value_type *Deque<T, Alloc>::try_back() const {
+  return size_ ? slot(size_ - 1) : nullptr;
+}
+
+template <typename T, typename Alloc>
+bool Deque<T, Alloc>::try_pop_front(value_type &out) {
+  if (!size_) return false;
+  out = std::move(*slot(0));
+  pop_front();
+  return true;
+}
+
+template <typename T, typename Alloc>
+std::optional<typename Deque<T, Alloc>::value_type>
+Deque<T, Alloc>::try_pop_front() {
+  if (!size_) return std::nullopt;
+  std::optional<value_type> out(std::move(*slot(0)));
+  pop_front();
+  return out;
+}
+
+template <typename T, typename Alloc>
+bool Deque<T, Alloc>::try_pop_back(value_type &out) {
+  if (!size_) return false;
+  out = std::move(*slot(size_ - 1));
+  pop_back();
+  return true;
+}
+
+template <typename T, typename Alloc>
+std::optional<typename Deque<T, Alloc>::value_type>
+Deque<T, Alloc>::try_pop_back() {
+  if (!size_) return std::nullopt;
+  std::optional<value_type> out(std::move(*slot(size_ - 1)));
+  pop_back();
+  return out;
+}
+
+template <typename T, typename Alloc>
+template <typename F>
+void Deque<T, Alloc>::scan_blocks(F f) const {
+  for (size_type pos = 0; pos < size_;) {
+    size_type count =
+        std::min(kBlockSize - (start_ + pos) % kBlockSize, size_ - pos);
+    if (!f(static_cast<const T *>(slot(pos)), count, pos)) return;
+    pos += count;
+  }
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::size_type Deque<T, Alloc>::find_pos(
+    const_reference value) const {
+  size_type found = size_;
+  scan_blocks([&](const T *data, size_type count, size_type pos) {
+    size_type i = detail::simd_find(data, count, value);
+    if (i == count) return true;
+    found = pos + i;
+    return false;
+  });
+  return found;
+}
+
+template <typename T, typename Alloc>
+template <bool kMax>
+typename Deque<T, Alloc>::size_type Deque<T, Alloc>::extreme_pos() const {
+  if (size_ == 0) return 0;
+  // std::min_element keeps a NaN it starts from; the kernels skip NaNs.
+  if constexpr (std::is_floating_point_v<T>) {
+    if (*slot(0) != *slot(0)) return 0;
+  }
+  size_type best = 0;
+  scan_blocks([&](const T *data, size_type count, size_type pos) {
+    size_type i = kMax ? detail::simd_max(data, count)
+                       : detail::simd_min(data, count);
+    if (i != count &&
+        (kMax ? *slot(best) < data[i] : data[i] < *slot(best))) {
+      best = pos + i;
+    }
+    return true;
+  });
+  return best;
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::iterator Deque<T, Alloc>::find(
+    const_reference value) {
+  return iterator(this, find_pos(value));
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::const_iterator Deque<T, Alloc>::find(
+    const_reference value) const {
+  return const_iterator(this, find_pos(value));
+}
+
+template <typename T, typename Alloc>
+bool Deque<T, Alloc>::contains(const_reference value) const {
+  return find_pos(value) != size_;
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::size_type Deque<T, Alloc>::count(
+    const_reference value) const {
+  size_type total = 0;
+  scan_blocks([&](const T *data, size_type count, size_type) {
+    total += detail::simd_count(data, count, value);
+    return true;
+  });
+  return total;
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::iterator Deque<T, Alloc>::min_element() {
+  return iterator(this, extreme_pos<false>());
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::const_iterator Deque<T, Alloc>::min_element()
+    const {
+  return const_iterator(this, extreme_pos<false>());
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::iterator Deque<T, Alloc>::max_element() {
+  return iterator(this, extreme_pos<true>());
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::const_iterator Deque<T, Alloc>::max_element()
+    const {
+  return const_iterator(this, extreme_pos<true>());
+}
+
+template <typename T, typename Alloc>
+typename Deque<T, Alloc>::value_type Deque<T, Alloc>::sum() const {
+  value_type total = value_type();
+  scan_blocks([&total](const T *data, size_type count, size_type) {
+    total = static_cast<T>(total + detail::simd_sum(data, count));
+    return true;
+  });
+  return total;
+}
+
+template <typename T, typename Alloc>
+void Deque<T, Alloc>::print() const {
+  for (auto it = cbegin(); it != cend(); ++it) std::cout << *it << " ";
+  std::cout << std::endl;
+}
+
+}  // namespace m3mpm
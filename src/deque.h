@@ -0,0 +1,187 @@
+#ifndef SRC_M3MPM_DEQUE_H_
+#define SRC_M3MPM_DEQUE_H_
+#include <stddef.h>
+
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+#include "config.h"
+#include "simd.h"
+
+namespace m3mpm {
+// Double-ended queue kept in fixed-size blocks of kBlockBytes, reached
+// through a map of block pointers. Pushing and popping at either end is
+// O(1) (amortized over the occasional map growth) and touches contiguous
+// memory, and element i is found with one division, so operator[] is O(1)
+// as well. A block emptied by a pop is kept as a spare for the next block
+// that a push needs, which makes a deque used as a FIFO queue stop
+// allocating once it has reached its working size. Elements never move,
+// but iterators are positions: pushing or popping at the front shifts
+// what they point to. Alloc follows the LSQContainer rules: it must be
+// stateless.
+template <typename T, typename Alloc = std::allocator<T>>
+class Deque {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using allocator_type = Alloc;
+
+  static constexpr size_type kBlockBytes = 512;
+  static constexpr size_type kBlockSize =
+      sizeof(T) < kBlockBytes ? kBlockBytes / sizeof(T) : 1;
+
+  // Bidirectional iterators with the List iterator interface, checked as
+  // configured in config.h.
+  class dequeIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    Deque *deque_;
+    size_type index_;
+
+    dequeIterator() : deque_(nullptr), index_(0) {}
+    dequeIterator(const Deque *deque, size_type index)
+        : deque_(const_cast<Deque *>(deque)), index_(index) {}
+
+    reference operator*() const;
+    pointer operator->() const;
+    dequeIterator &operator++();
+    dequeIterator operator++(int);
+    dequeIterator &operator--();
+    dequeIterator operator--(int);
+    bool operator==(const dequeIterator &other) const;
+    bool operator!=(const dequeIterator &other) const;
+  };
+
+  class dequeConstIterator : public dequeIterator {
+   public:
+    using pointer = const T *;
+    using reference = const T &;
+
+    dequeConstIterator() : dequeIterator() {}
+    dequeConstIterator(const Deque *deque, size_type index)
+        : dequeIterator(deque, index) {}
+    dequeConstIterator(const dequeIterator &other) : dequeIterator(other) {}
+
+    reference operator*() const;
+    pointer operator->() const;
+    dequeConstIterator &operator++();
+    dequeConstIterator operator++(int);
+    dequeConstIterator &operator--();
+    dequeConstIterator operator--(int);
+  };
+  using iterator = dequeIterator;
+  using const_iterator = dequeConstIterator;
+
+ public:
+  Deque();
+  explicit Deque(std::initializer_list<T> const &items);
+  Deque(const Deque &d);
+  Deque(Deque &&d) noexcept;
+  ~Deque();
+  Deque &operator=(const Deque &d);
+  Deque &operator=(Deque &&d) noexcept;
+
+  const_reference front() const;
+  const_reference back() const;
+  reference operator[](size_type pos) { return *slot(pos); }
+  const_reference operator[](size_type pos) const { return *slot(pos); }
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void push_front(const_reference value);
+  void push_front(value_type &&value);
+  void push_back(const_reference value);
+  void push_back(value_type &&value);
+  template <typename... Args>
+  reference emplace_front(Args &&...args);
+  template <typename... Args>
+  reference emplace_back(Args &&...args);
+  void pop_front();
+  void pop_back();
+  // Destroys the elements and releases every block but the spare.
+  void clear();
+  void swap(Deque &other) noexcept;
+
+  const value_type *try_front() const;
+  const value_type *try_back() const;
+  bool try_pop_front(value_type &out);
+  std::optional<value_type> try_pop_front();
+  bool try_pop_back(value_type &out);
+  std::optional<value_type> try_pop_back();
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, size_); }
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+  const_iterator cend() const { return const_iterator(this, size_); }
+
+  // Linear search and reductions with the results of their List
+  // counterparts. A block holds its elements contiguously, so the kernels
+  // of simd.h read them in place, a block at a time, with no gathering.
+  iterator find(const_reference value);
+  const_iterator find(const_reference value) const;
+  bool contains(const_reference value) const;
+  size_type count(const_reference value) const;
+  iterator min_element();
+  const_iterator min_element() const;
+  iterator max_element();
+  const_iterator max_element() const;
+  value_type sum() const;
+
+  void print() const;
+
+ private:
+  using value_traits = std::allocator_traits<
+      typename std::allocator_traits<Alloc>::template rebind_alloc<T>>;
+  using map_traits = std::allocator_traits<
+      typename std::allocator_traits<Alloc>::template rebind_alloc<T *>>;
+  static_assert(value_traits::is_always_equal::value,
+                "Deque: Alloc must be a stateless allocator");
+
+  // map_[first_] .. map_[first_ + blocks_ - 1] are the blocks in use; the
+  // elements occupy positions start_ .. start_ + size_ - 1 of their
+  // concatenation.
+  T **map_;
+  size_type map_size_;
+  size_type first_;
+  size_type blocks_;
+  size_type start_;
+  size_type size_;
+  T *spare_;
+
+  T *slot(size_type pos) const {
+    size_type offset = start_ + pos;
+    return map_[first_ + offset / kBlockSize] + offset % kBlockSize;
+  }
+  // Calls f(data, count, pos) on the contiguous runs of elements in order,
+  // data holding the count elements from position pos, until f returns
+  // false.
+  template <typename F>
+  void scan_blocks(F f) const;
+  size_type find_pos(const_reference value) const;
+  template <bool kMax>
+  size_type extreme_pos() const;
+  T *acquire_block();
+  void release_block(T *block);
+  // Recentres the blocks in the map, doubling it when it is over half full.
+  void reshape_map();
+  void add_block_front();
+  void add_block_back();
+};
+}  // namespace m3mpm
+#include "deque.cpp"
+#endif  // SRC_M3MPM_DEQUE_H_
@@ -0,0 +1,94 @@
+#include <stdint.h>
+#include <sys/mman.h>
+
+#include <new>
+#include <thread>
+
+namespace m3mpm {
+
+inline void *HugePageArena::map(size_t bytes) {
+  // Over-reserve by one chunk so the usable range can start on a huge page
+  // boundary, then hand the unaligned slack back.
+  size_t reserved = bytes + kChunkSize;
+  void *raw = mmap(nullptr, reserved, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (raw == MAP_FAILED) M3MPM_THROW(std::bad_alloc());
+
+  uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+  uintptr_t aligned =
+      (begin + kChunkSize - 1) & ~static_cast<uintptr_t>(kChunkSize - 1);
+  size_t head = aligned - begin;
+  if (head != 0) munmap(raw, head);
+  size_t tail = reserved - head - bytes;
+  if (tail != 0) munmap(reinterpret_cast<char *>(aligned + bytes), tail);
+#ifdef MADV_HUGEPAGE
+  madvise(reinterpret_cast<void *>(aligned), bytes, MADV_HUGEPAGE);
+#endif
+  return reinterpret_cast<void *>(aligned);
+}
+
+inline void *HugePageArena::allocate_chunk() {
+  while (lock_.exchange(true, std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+  if (region_ == region_end_) {
+    M3MPM_TRY {
+      region_ = static_cast<char *>(map(kRegionSize));
+    } M3MPM_CATCH_ALL {
+      lock_.store(false, std::memory_order_release);
+      M3MPM_RETHROW;
+    }
+    region_end_ = region_ + kRegionSize;
+  }
+  void *chunk = region_;
+  region_ += kChunkSize;
+  chunks_.fetch_add(1, std::memory_order_relaxed);
+  lock_.store(false, std::memory_order_release);
+  return chunk;
+}
+
+inline void *HugePageArena::allocate_bytes(size_t bytes) {
+  if (bytes < kChunkSize) return ::operator new(bytes);
+  return map((bytes + kChunkSize - 1) & ~(kChunkSize - 1));
+}
+
+inline void HugePageArena::deallocate_bytes(void *p, size_t bytes) noexcept {
+  if (bytes < kChunkSize) {
+    ::operator delete(p);
+  } else {
+    munmap(p, (bytes + kChunkSize - 1) & ~(kChunkSize - 1));
+  }
+}
+
+template <typename T>
+T *HugePageArenaAllocator<T>::allocate(size_t n) {
+  using pool = HugePageNodePool<sizeof(T), alignof(T)>;
+  if (n == 1 && pool::kPooled) return static_cast<T *>(pool::allocate());
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "HugePageArenaAllocator: over-aligned types are not supported");
+  return static_cast<T *>(HugePageArena::allocate_bytes(n * sizeof(T)));
+}
+
+template <typename T>
+void HugePageArenaAllocator<T>::deallocate(T *p, size_t n) noexcept {
+  using pool = HugePageNodePool<sizeof(T), alignof(T)>;
+  if (n == 1 && pool::kPooled) {
+    pool::deallocate(p);
+  } else {
+    HugePageArena::deallocate_bytes(p, n * sizeof(T));
+  }
+}
+
+template <typename T>
+size_t HugePageArenaAllocator<T>::allocation_size(size_t n) {
+  using pool = HugePageNodePool<sizeof(T), alignof(T)>;
+  if (n == 1 && pool::kPooled) return pool::block_size();
+  size_t bytes = n * sizeof(T);
+  if (bytes < HugePageArena::kChunkSize) {
+    return detail::heap_allocation_size(bytes);
+  }
+  return (bytes + HugePageArena::kChunkSize - 1) &
+         ~(HugePageArena::kChunkSize - 1);
+}
+
+}  // namespace m3mpm
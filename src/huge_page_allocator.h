@@ -0,0 +1,90 @@
+#ifndef SRC_M3MPM_HUGE_PAGE_ALLOCATOR_H_
+#define SRC_M3MPM_HUGE_PAGE_ALLOCATOR_H_
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+#include "config.h"
+#include "memory_usage.h"
+#include "thread_cache_allocator.h"
+
+namespace m3mpm {
+// Process-wide reservation of anonymous memory advised for transparent huge
+// pages (MADV_HUGEPAGE). Regions of kRegionSize are reserved lazily and cut
+// into kChunkSize chunks, each aligned so that it can be backed by a single
+// 2 MiB page. Memory is never returned to the system.
+class HugePageArena {
+ public:
+  static constexpr size_t kChunkSize = 2 * 1024 * 1024;
+  static constexpr size_t kRegionSize = 256 * kChunkSize;
+
+  static void *allocate_chunk();
+  // Chunks handed out by allocate_chunk() so far.
+  static size_t chunk_count() {
+    return chunks_.load(std::memory_order_relaxed);
+  }
+  // Mappings of their own for requests of at least one chunk, such as slabs
+  // holding a whole list; smaller requests are served by operator new.
+  static void *allocate_bytes(size_t bytes);
+  static void deallocate_bytes(void *p, size_t bytes) noexcept;
+
+ private:
+  static void *map(size_t bytes);
+
+  static inline std::atomic<bool> lock_{false};
+  static inline char *region_ = nullptr;
+  static inline char *region_end_ = nullptr;
+  static inline std::atomic<size_t> chunks_{0};
+};
+
+// Slabs for ThreadCachePool: whole HugePageArena chunks, so each slab is a
+// single 2 MiB page.
+struct HugePageSlabs {
+  static constexpr size_t kSlabSize = HugePageArena::kChunkSize;
+  static constexpr size_t kMaxBlockSize = kSlabSize / 64;
+  static void *allocate_slab() { return HugePageArena::allocate_chunk(); }
+};
+
+// Fixed-size blocks bumped out of HugePageArena chunks, with the thread
+// caches of ThreadCachePool: a block freed on another thread goes back to
+// the thread whose chunk it came from, and the cache of an exiting thread,
+// the rest of its chunk included, is adopted by the next new thread.
+template <size_t Size, size_t Align>
+using HugePageNodePool = ThreadCachePool<Size, Align, HugePageSlabs>;
+
+// Stateless allocator that places container nodes in huge-page backed
+// arena memory, so that traversing a large List, Queue or Stack touches as
+// few TLB entries as possible.
+template <typename T>
+class HugePageArenaAllocator {
+ public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  HugePageArenaAllocator() noexcept {}
+  template <typename U>
+  HugePageArenaAllocator(const HugePageArenaAllocator<U> &) noexcept {}
+
+  T *allocate(size_t n);
+  void deallocate(T *p, size_t n) noexcept;
+  // Bytes set aside by allocate(n): one pool block for a pooled node, whole
+  // huge pages from a chunk up and a heap block in between.
+  static size_t allocation_size(size_t n);
+};
+
+template <typename T, typename U>
+bool operator==(const HugePageArenaAllocator<T> &,
+                const HugePageArenaAllocator<U> &) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const HugePageArenaAllocator<T> &,
+                const HugePageArenaAllocator<U> &) {
+  return false;
+}
+}  // namespace m3mpm
+#include "huge_page_allocator.cpp"
+#endif  // SRC_M3MPM_HUGE_PAGE_ALLOCATOR_H_
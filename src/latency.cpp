@@ -0,0 +1,75 @@
+namespace m3mpm {
+
+inline size_t LatencyHistogram::bucket_of(uint64_t value) {
+  if (value < kSubBuckets) return static_cast<size_t>(value);
+  unsigned shift = 63 - __builtin_clzll(value) - kSubBits;
+  return (shift + 1) * kSubBuckets +
+         static_cast<size_t>((value >> shift) & (kSubBuckets - 1));
+}
+
+inline uint64_t LatencyHistogram::bucket_top(size_t bucket) {
+  if (bucket < kSubBuckets) return bucket;
+  unsigned shift = static_cast<unsigned>(bucket / kSubBuckets) - 1;
+  uint64_t base = (kSubBuckets + bucket % kSubBuckets) << shift;
+  return base + ((uint64_t(1) << shift) - 1);
+}
+
+inline void LatencyHistogram::record(uint64_t value) {
+  ++counts_[bucket_of(value)];
+  ++count_;
+  if (value < min_) min_ = value;
+  if (value > max_) max_ = value;
+}
+
+inline void LatencyHistogram::merge(const LatencyHistogram &other) {
+  for (size_t i = 0; i < kBuckets; ++i) counts_[i] += other.counts_[i];
+  count_ += other.count_;
+  if (other.min_ < min_) min_ = other.min_;
+  if (other.max_ > max_) max_ = other.max_;
+}
+
+inline void LatencyHistogram::reset() { *this = LatencyHistogram(); }
+
+inline uint64_t LatencyHistogram::percentile(double p) const {
+  if (count_ == 0) return 0;
+  if (p <= 0) return min();
+  uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(count_));
+  if (rank < p * static_cast<double>(count_)) ++rank;
+  if (rank > count_) rank = count_;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      uint64_t top = bucket_top(i);
+      return top < max_ ? top : max_;
+    }
+  }
+  return max_;
+}
+
+template <typename Base, typename Clock>
+const LatencyHistogram &LatencyStats<Base, Clock>::latency(Op op) const {
+  static const LatencyHistogram kEmpty;
+  const auto &histogram = histograms_[static_cast<size_t>(op)];
+  return histogram ? *histogram : kEmpty;
+}
+
+template <typename Base, typename Clock>
+void LatencyStats<Base, Clock>::reset_latency() {
+  for (auto &histogram : histograms_) histogram.reset();
+  countdown_ = sampling_;
+}
+
+template <typename Base, typename Clock>
+void LatencyStats<Base, Clock>::dump_latency(std::ostream &out) const {
+  for (size_t i = 0; i < static_cast<size_t>(Op::kCount); ++i) {
+    const LatencyHistogram &h = latency(static_cast<Op>(i));
+    if (h.count() == 0) continue;
+    out << op_name(static_cast<Op>(i)) << ": n=" << h.count()
+        << " p50=" << h.percentile(0.5) << " p90=" << h.percentile(0.9)
+        << " p99=" << h.percentile(0.99) << " p99.9=" << h.percentile(0.999)
+        << " max=" << h.max() << ' ' << Clock::kUnit << '\n';
+  }
+}
+
+}  // namespace m3mpm
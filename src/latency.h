@@ -0,0 +1,142 @@
+#ifndef SRC_M3MPM_LATENCY_H_
+#define SRC_M3MPM_LATENCY_H_
+#include <stddef.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <new>
+
+#include "stats.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace m3mpm {
+// Log-linear histogram of durations in the manner of HdrHistogram: values
+// below 2^kSubBits are kept exactly, larger ones in 2^kSubBits buckets per
+// power of two, so any reported value is within 1 / 2^kSubBits (about 3%)
+// of the true one. Recording is a count increment; the full 64-bit range
+// takes 1920 buckets (15 KiB).
+class LatencyHistogram {
+ public:
+  static constexpr unsigned kSubBits = 5;
+  static constexpr size_t kSubBuckets = size_t(1) << kSubBits;
+  static constexpr size_t kBuckets = (64 - kSubBits + 1) * kSubBuckets;
+
+  void record(uint64_t value);
+  void merge(const LatencyHistogram &other);
+  void reset();
+
+  uint64_t count() const { return count_; }
+  uint64_t min() const { return count_ ? min_ : 0; }
+  uint64_t max() const { return max_; }
+  // The smallest value v such that a share p (0..1) of the samples are not
+  // above v, up to the bucket precision; 0 with no samples.
+  uint64_t percentile(double p) const;
+
+ private:
+  uint64_t counts_[kBuckets] = {};
+  uint64_t count_ = 0;
+  uint64_t min_ = UINT64_MAX;
+  uint64_t max_ = 0;
+
+  static size_t bucket_of(uint64_t value);
+  // The largest value that falls into bucket.
+  static uint64_t bucket_top(size_t bucket);
+};
+
+// Clocks for LatencyStats. SteadyTicks counts nanoseconds through
+// std::chrono::steady_clock; TscTicks reads the x86 time-stamp counter,
+// which is cheaper but counts reference cycles and is not serializing, so
+// very short calls may be measured a little short.
+struct SteadyTicks {
+  static constexpr const char *kUnit = "ns";
+  static uint64_t now() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+struct TscTicks {
+  static constexpr const char *kUnit = "cycles";
+  static uint64_t now() { return __rdtsc(); }
+};
+#endif
+
+// Instrumentation policy that times one in every sampling() calls of each
+// counted operation and keeps a LatencyHistogram per operation, allocated
+// when the operation is first sampled. It adds to Base, another policy
+// (LatencyStats<CountingStats> also counts), whose op_scope() runs at the
+// start of every call. Histograms are per container and not shared between
+// threads.
+template <typename Base = NoStats, typename Clock = SteadyTicks>
+class LatencyStats : public Base {
+ public:
+  static constexpr uint32_t kDefaultSampling = 64;
+
+  LatencyStats() = default;
+  // Containers copy and move their elements, not their measurements.
+  LatencyStats(const LatencyStats &) : LatencyStats() {}
+  LatencyStats &operator=(const LatencyStats &) { return *this; }
+
+  // Times one call in every n; 1 times every call and 0 none.
+  void set_sampling(uint32_t n) {
+    sampling_ = n;
+    countdown_ = n;
+  }
+  uint32_t sampling() const { return sampling_; }
+
+  // The samples of op so far, in Clock units.
+  const LatencyHistogram &latency(Op op) const;
+  void reset_latency();
+  // One line per sampled operation: sample count, p50, p90, p99, p99.9 and
+  // the maximum.
+  void dump_latency(std::ostream &out) const;
+
+ protected:
+  class Scope {
+   public:
+    Scope(const LatencyStats *owner, Op op)
+        : owner_(owner), op_(op), start_(owner ? Clock::now() : 0) {}
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+    ~Scope() {
+      if (owner_) owner_->record(op_, Clock::now() - start_);
+    }
+
+   private:
+    const LatencyStats *owner_;
+    Op op_;
+    uint64_t start_;
+  };
+
+  Scope op_scope(Op op) const {
+    Base::op_scope(op);
+    if (sampling_ == 0 || --countdown_ != 0) return Scope(nullptr, op);
+    countdown_ = sampling_;
+    return Scope(this, op);
+  }
+
+ private:
+  uint32_t sampling_ = kDefaultSampling;
+  mutable uint32_t countdown_ = kDefaultSampling;
+  mutable std::unique_ptr<LatencyHistogram>
+      histograms_[static_cast<size_t>(Op::kCount)];
+
+  // A histogram that cannot be allocated just drops the sample: this runs
+  // in destructors and must not throw.
+  void record(Op op, uint64_t ticks) const {
+    auto &histogram = histograms_[static_cast<size_t>(op)];
+    if (!histogram) histogram.reset(new (std::nothrow) LatencyHistogram());
+    if (histogram) histogram->record(ticks);
+  }
+};
+}  // namespace m3mpm
+#include "latency.cpp"
+#endif  // SRC_M3MPM_LATENCY_H_
@@ -1,66 +1,130 @@
 namespace m3mpm {
-template <typename T>
-typename List<T>::reference List<T>::iterator::operator*() {
-  if (pNode_ == nullptr)
-    throw std::logic_error("error operator*(): iterator is empty");
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listIterator::reference
+List<T, Alloc, Stats>::listIterator::operator*() const {
+  if (kCheckedIterators && pNode_ == nullptr)
+    M3MPM_THROW(std::logic_error("error operator*(): iterator is empty"));
 
   return pNode_->data_;
 }
 
-template <typename T>
-typename List<T>::listIterator &List<T>::listIterator::operator++() {
-  if (pNode_->pNext_) pNode_ = pNode_->pNext_;
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listIterator::pointer
+List<T, Alloc, Stats>::listIterator::operator->() const {
+  return std::addressof(**this);
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listIterator &
+List<T, Alloc, Stats>::listIterator::operator++() {
+  if (kCheckedIterators && pNode_ == nullptr)
+    M3MPM_THROW(std::logic_error("error operator++(): iterator is empty"));
+
+  pNode_ = pNode_->pNext_;
   return *this;
 }
 
-template <typename T>
-typename List<T>::listIterator &List<T>::listIterator::operator--() {
-  if (pNode_->pPrev_) pNode_ = pNode_->pPrev_;
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listIterator
+List<T, Alloc, Stats>::listIterator::operator++(int) {
+  listIterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listIterator &
+List<T, Alloc, Stats>::listIterator::operator--() {
+  if (kCheckedIterators && pNode_ == nullptr)
+    M3MPM_THROW(std::logic_error("error operator--(): iterator is empty"));
+
+  pNode_ = pNode_->pPrev_;
   return *this;
 }
 
-template <typename T>
-typename List<T>::listIterator &List<T>::listIterator::operator=(
-    const listIterator &other) {
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listIterator
+List<T, Alloc, Stats>::listIterator::operator--(int) {
+  listIterator tmp(*this);
+  --*this;
+  return tmp;
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listIterator &
+List<T, Alloc, Stats>::listIterator::operator=(const listIterator &other) {
   this->pNode_ = other.pNode_;
   return *this;
 }
 
-template <typename T>
-bool List<T>::listIterator::operator==(const listIterator &other) const {
-  bool res = false;
-  if (this->pNode_ == other.pNode_) {
-    res = true;
-  }
-  return res;
+template <typename T, typename Alloc, typename Stats>
+bool List<T, Alloc, Stats>::listIterator::operator==(
+    const listIterator &other) const {
+  return this->pNode_ == other.pNode_;
+}
+
+template <typename T, typename Alloc, typename Stats>
+bool List<T, Alloc, Stats>::listIterator::operator!=(
+    const listIterator &other) const {
+  return this->pNode_ != other.pNode_;
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listConstIterator::reference
+List<T, Alloc, Stats>::listConstIterator::operator*() const {
+  return listIterator::operator*();
 }
 
-template <typename T>
-bool List<T>::listIterator::operator!=(const listIterator &other) const {
-  bool res = this->operator==(other);
-  return !res;
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listConstIterator::pointer
+List<T, Alloc, Stats>::listConstIterator::operator->() const {
+  return listIterator::operator->();
 }
 
-template <typename T>
-typename List<T>::const_reference List<T>::const_iterator::operator*() {
-  if (this->pNode_ == nullptr)
-    throw std::logic_error("error operator*(): iterator is empty");
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listConstIterator &
+List<T, Alloc, Stats>::listConstIterator::operator++() {
+  listIterator::operator++();
+  return *this;
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listConstIterator
+List<T, Alloc, Stats>::listConstIterator::operator++(int) {
+  listConstIterator tmp(*this);
+  listIterator::operator++();
+  return tmp;
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listConstIterator &
+List<T, Alloc, Stats>::listConstIterator::operator--() {
+  listIterator::operator--();
+  return *this;
+}
 
-  return this->pNode_->data_;
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listConstIterator
+List<T, Alloc, Stats>::listConstIterator::operator--(int) {
+  listConstIterator tmp(*this);
+  listIterator::operator--();
+  return tmp;
 }
 
-template <typename T>
-List<T>::List() : LSQContainer<T>() {
-  p_after_tail_ = new Node<T>();
+template <typename T, typename Alloc, typename Stats>
+List<T, Alloc, Stats>::List() : LSQContainer<T, Alloc, Stats>() {
+  p_after_tail_ = this->create_node();
+  p_after_tail_->pNext_ = p_after_tail_->pPrev_ = p_after_tail_;
 }
 
-template <typename T>
-List<T>::List(size_type n) : List() {
+template <typename T, typename Alloc, typename Stats>
+List<T, Alloc, Stats>::List(size_type n) : List() {
   if (n >= max_size()) {
-    throw std::out_of_range("error list(size_type n): over maximum size");
+    M3MPM_THROW(std::out_of_range(
+        "error list(size_type n): over maximum size"));
   }
   for (size_type i = 0; i < n; ++i) {
-    Node<T> *tmp = new Node<T>();
+    Node<T> *tmp = this->create_node();
     if (!this->head_ && !this->tail_) {
       this->head_ = this->tail_ = tmp;
       tmp->pNext_ = p_after_tail_;
@@ -78,35 +142,38 @@ List<T>::List(size_type n) : List() {
   }
 }
 
-template <typename T>
-List<T>::List(std::initializer_list<T> const &items)
-    : LSQContainer<T>::LSQContainer(items) {
-  p_after_tail_ = new Node<T>();
-  this->head_->pPrev_ = p_after_tail_;
-  this->tail_->pNext_ = p_after_tail_;
-  p_after_tail_->pPrev_ = this->tail_;
-  p_after_tail_->pNext_ = this->head_;
+template <typename T, typename Alloc, typename Stats>
+List<T, Alloc, Stats>::List(std::initializer_list<T> const &items)
+    : LSQContainer<T, Alloc, Stats>::LSQContainer(items) {
+  p_after_tail_ = this->create_node();
+  p_after_tail_->pNext_ = p_after_tail_->pPrev_ = p_after_tail_;
+  if (this->head_) {
+    this->head_->pPrev_ = p_after_tail_;
+    this->tail_->pNext_ = p_after_tail_;
+    p_after_tail_->pPrev_ = this->tail_;
+    p_after_tail_->pNext_ = this->head_;
+  }
 }
 
-template <typename T>
-List<T>::List(const List &l) : List() {
+template <typename T, typename Alloc, typename Stats>
+List<T, Alloc, Stats>::List(const List &l) : List() {
+  auto scope = this->op_scope(Op::kCopy);
+  this->on_hops(l.size_);
   auto it = l.cbegin();
   while (it != l.cend()) {
     this->push_back(*it);
     ++it;
   }
-  p_after_tail_->pNext_ = this->head_;
-  p_after_tail_->pPrev_ = this->tail_;
-  this->size_ = l.size_;
 }
 
-template <typename T>
-List<T>::List(List &&l) : List() {
+template <typename T, typename Alloc, typename Stats>
+List<T, Alloc, Stats>::List(List &&l) : List() {
   *this = std::move(l);
 }
 
-template <typename T>
-typename List<T>::const_reference List<T>::front() const {
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::const_reference
+List<T, Alloc, Stats>::front() const {
   if (!this->head_) {
     value_type &d = this->p_after_tail_->data_;
     return d;
@@ -116,8 +183,9 @@ typename List<T>::const_reference List<T>::front() const {
   }
 }
 
-template <typename T>
-typename List<T>::const_reference List<T>::back() const {
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::const_reference
+List<T, Alloc, Stats>::back() const {
   if (!this->tail_) {
     value_type &d = this->p_after_tail_->data_;
     return d;
@@ -127,19 +195,21 @@ typename List<T>::const_reference List<T>::back() const {
   }
 }
 
-template <typename T>
-typename List<T>::size_type List<T>::size() const {
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::size_type List<T, Alloc, Stats>::size() const {
   return this->size_;
 }
 
-template <typename T>
-typename List<T>::size_type List<T>::max_size() const {
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::size_type
+List<T, Alloc, Stats>::max_size() const {
   return std::numeric_limits<size_t>::max() / (sizeof(Node<T>) * 2);
 }
 
-template <typename T>
-void List<T>::push_front(const_reference value) {
-  Node<T> *tmp = new Node<T>(value);
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::push_front(const_reference value) {
+  auto scope = this->op_scope(Op::kPush);
+  Node<T> *tmp = this->create_node(value);
   if (!this->head_ && !this->tail_) {
     this->head_ = this->tail_ = tmp;
     tmp->pNext_ = p_after_tail_;
@@ -154,28 +224,33 @@ void List<T>::push_front(const_reference value) {
     this->head_ = tmp;
   }
   this->size_++;
+  if (index_) index_inserted(tmp);
 }
 
-template <typename T>
-void List<T>::pop_front() {
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::pop_front() {
+  auto scope = this->op_scope(Op::kPop);
   if (this->head_ == nullptr) {
-    throw std::range_error("error pop_front(): the List is empty");
+    M3MPM_THROW(std::range_error("error pop_front(): the List is empty"));
   }
   Node<T> *tmp = this->head_;
+  if (index_) index_erasing(tmp);
   if (this->head_->pNext_ != p_after_tail_) {
     this->head_ = this->head_->pNext_;
     this->head_->pPrev_ = p_after_tail_;
     p_after_tail_->pNext_ = this->head_;
   } else {
     this->head_ = this->tail_ = nullptr;
+    p_after_tail_->pNext_ = p_after_tail_->pPrev_ = p_after_tail_;
   }
-  delete tmp;
+  release_node(tmp);
   this->size_--;
 }
 
-template <typename T>
-void List<T>::push_back(const_reference value) {
-  Node<T> *tmp = new Node<T>(value);
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::push_back(const_reference value) {
+  auto scope = this->op_scope(Op::kPush);
+  Node<T> *tmp = this->create_node(value);
   if (!this->head_ && !this->tail_) {
     this->head_ = this->tail_ = tmp;
     tmp->pNext_ = p_after_tail_;
@@ -190,42 +265,101 @@ void List<T>::push_back(const_reference value) {
     this->tail_ = tmp;
   }
   this->size_++;
+  if (index_) index_inserted(tmp);
 }
 
-template <typename T>
-void List<T>::pop_back() {
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::pop_back() {
+  auto scope = this->op_scope(Op::kPop);
   if (this->tail_ == nullptr) {
-    throw std::range_error("error pop_back(): the List is empty");
+    M3MPM_THROW(std::range_error("error pop_back(): the List is empty"));
   }
   Node<T> *tmp = this->tail_;
+  if (index_) index_erasing(tmp);
   if (this->tail_->pPrev_ != p_after_tail_) {
     this->tail_ = this->tail_->pPrev_;
     this->tail_->pNext_ = p_after_tail_;
     p_after_tail_->pPrev_ = this->tail_;
   } else {
     this->head_ = this->tail_ = nullptr;
+    p_after_tail_->pNext_ = p_after_tail_->pPrev_ = p_after_tail_;
   }
-  delete tmp;
+  release_node(tmp);
   this->size_--;
 }
 
-template <typename T>
-void List<T>::clear() {
+template <typename T, typename Alloc, typename Stats>
+const typename List<T, Alloc, Stats>::value_type *
+List<T, Alloc, Stats>::try_front() const {
+  return this->head_ ? &this->head_->data_ : nullptr;
+}
+
+template <typename T, typename Alloc, typename Stats>
+const typename List<T, Alloc, Stats>::value_type *
+List<T, Alloc, Stats>::try_back() const {
+  return this->tail_ ? &this->tail_->data_ : nullptr;
+}
+
+template <typename T, typename Alloc, typename Stats>
+bool List<T, Alloc, Stats>::try_pop_front(value_type &out) {
+  if (!this->head_) return false;
+  out = std::move(this->head_->data_);
+  pop_front();
+  return true;
+}
+
+template <typename T, typename Alloc, typename Stats>
+std::optional<typename List<T, Alloc, Stats>::value_type>
+List<T, Alloc, Stats>::try_pop_front() {
+  if (!this->head_) return std::nullopt;
+  std::optional<value_type> out(std::move(this->head_->data_));
+  pop_front();
+  return out;
+}
+
+template <typename T, typename Alloc, typename Stats>
+bool List<T, Alloc, Stats>::try_pop_back(value_type &out) {
+  if (!this->tail_) return false;
+  out = std::move(this->tail_->data_);
+  pop_back();
+  return true;
+}
+
+template <typename T, typename Alloc, typename Stats>
+std::optional<typename List<T, Alloc, Stats>::value_type>
+List<T, Alloc, Stats>::try_pop_back() {
+  if (!this->tail_) return std::nullopt;
+  std::optional<value_type> out(std::move(this->tail_->data_));
+  pop_back();
+  return out;
+}
+
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::clear() {
+  auto scope = this->op_scope(Op::kClear);
+  drop_index();
   while (this->size_) {
     pop_front();
   }
 }
 
-template <typename T>
-void List<T>::swap(List &other) {
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::swap(List &other) {
   std::swap(this->size_, other.size_);
   std::swap(this->head_, other.head_);
   std::swap(this->tail_, other.tail_);
   std::swap(this->p_after_tail_, other.p_after_tail_);
+  std::swap(slab_, other.slab_);
+  std::swap(slab_size_, other.slab_size_);
+  std::swap(slab_live_, other.slab_live_);
+  index_ = other.index_.exchange(index_);
+  this->on_swap(other);
 }
 
-template <typename T>
-void List<T>::reverse() {
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::reverse() {
+  auto scope = this->op_scope(Op::kReverse);
+  this->on_hops(this->size_);
   if (!this->empty()) {
     size_type left = 0;
     size_type right = this->size_ - 1;
@@ -241,36 +375,43 @@ void List<T>::reverse() {
   }
 }
 
-template <typename T>
-List<T> &List<T>::operator=(List<T> &&l) {
+template <typename T, typename Alloc, typename Stats>
+List<T, Alloc, Stats> &List<T, Alloc, Stats>::operator=(List &&l) {
   if (this == &l)
-    throw std::invalid_argument("error operator=: moving object to itself");
+    M3MPM_THROW(std::invalid_argument(
+        "error operator=: moving object to itself"));
 
   if (!this->empty()) {
     this->clear();
   }
-  delete p_after_tail_;
+  drop_index();
+  if (p_after_tail_) this->destroy_node(p_after_tail_);
+  this->on_swap(l);
 
   this->head_ = l.head_;
   this->tail_ = l.tail_;
   this->size_ = l.size_;
   this->p_after_tail_ = l.p_after_tail_;
+  slab_ = l.slab_;
+  slab_size_ = l.slab_size_;
+  slab_live_ = l.slab_live_;
+  index_ = l.index_.exchange(nullptr);
 
-  l.p_after_tail_->pNext_ = nullptr;
-  l.p_after_tail_->pPrev_ = nullptr;
   l.head_ = l.tail_ = l.p_after_tail_ = nullptr;
   l.size_ = 0;
+  l.slab_ = nullptr;
+  l.slab_size_ = l.slab_live_ = 0;
 
   return *this;
 }
 
-template <typename T>
-bool List<T>::empty() const {
+template <typename T, typename Alloc, typename Stats>
+bool List<T, Alloc, Stats>::empty() const {
   return this->size_ == 0;
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::begin() {
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::iterator List<T, Alloc, Stats>::begin() {
   if (!this->empty()) {
     return iterator(this->head_);
   } else {
@@ -278,8 +419,8 @@ typename List<T>::iterator List<T>::begin() {
   }
 }
 
-template <typename T>
-typename List<T>::iterator List<T>::end() {
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::iterator List<T, Alloc, Stats>::end() {
   if (!this->empty()) {
     return iterator(p_after_tail_);
   } else {
@@ -287,8 +428,9 @@ typename List<T>::iterator List<T>::end() {
   }
 }
 
-template <typename T>
-typename List<T>::const_iterator List<T>::cbegin() const {
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::const_iterator
+List<T, Alloc, Stats>::cbegin() const {
   if (!this->empty()) {
     return const_iterator(this->head_);
   } else {
@@ -296,8 +438,9 @@ typename List<T>::const_iterator List<T>::cbegin() const {
   }
 }
 
-template <typename T>
-typename List<T>::const_iterator List<T>::cend() const {
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::const_iterator
+List<T, Alloc, Stats>::cend() const {
   if (!this->empty()) {
     return const_iterator(p_after_tail_);
   } else {
@@ -305,8 +448,9 @@ typename List<T>::const_iterator List<T>::cend() const {
   }
 }
 
-template <typename T>
-void List<T>::sort() {
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::sort() {
+  auto scope = this->op_scope(Op::kSort);
   if (!this->empty()) {
     size_type left = 0;
     size_type right = this->size_ - 1;
@@ -320,6 +464,7 @@ void List<T>::sort() {
         }
         ++iter;
       }
+      this->on_hops(right - left + 1);
       --right;
       --iter;
 
@@ -335,6 +480,7 @@ void List<T>::sort() {
         }
         --iter;
       }
+      this->on_hops(right - left + 1);
       ++left;
       ++iter;
 
@@ -345,14 +491,186 @@ void List<T>::sort() {
   }
 }
 
-template <typename T>
-void List<T>::erase(iterator pos) {
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::parallel_sort(size_type threads) {
+  using detail::Chain;
+  auto scope = this->op_scope(Op::kSort);
+  const size_type n = this->size_;
+  if (n < 2) return;
+  const size_type runs = std::max<size_type>(
+      1, std::min(detail::thread_count(threads), n / kParallelSortGrain));
+  // Nodes sampled, evenly spaced over the list, to choose the splitters.
+  constexpr size_type kSamples = 64;
+
+  // All scratch up front: running out of memory leaves the list untouched.
+  std::vector<Chain<T>> chains(runs);
+  std::vector<Chain<T>> pieces(runs > 1 ? runs * runs : 0);
+  std::vector<const T *> samples(runs > 1 ? runs * kSamples : 0);
+  std::vector<const T *> splitters(runs - 1);
+  std::vector<Node<T> *> firsts(runs, this->head_);
+  std::vector<size_type> hops(runs, 0);
+  std::vector<std::exception_ptr> errors(runs);
+
+  // Run i starts at position first_of(i). The boundaries and the samples
+  // come from the skip index when there is one, in O(log n) each, and from
+  // a single walk otherwise; that walk is the one step the threads do not
+  // share.
+  auto first_of = [n, runs](size_type i) {
+    return i * (n / runs) + std::min(i, n % runs);
+  };
+  const size_type stride = n / (runs * kSamples);
+  SkipIndex<T> *const index = built_index();
+  if (runs > 1 && index) {
+    for (size_type i = 1; i < runs; ++i) firsts[i] = index->at(first_of(i));
+    for (size_type k = 0; k < samples.size(); ++k) {
+      samples[k] = &index->at(k * stride)->data_;
+    }
+  } else if (runs > 1) {
+    Node<T> *node = this->head_;
+    size_type next_run = 1;
+    for (size_type pos = 0; pos < n; ++pos, node = node->pNext_) {
+      if (pos % stride == 0 && pos / stride < samples.size()) {
+        samples[pos / stride] = &node->data_;
+      }
+      if (next_run < runs && pos == first_of(next_run)) {
+        firsts[next_run++] = node;
+      }
+    }
+    this->on_hops(n);
+  }
+  drop_index();
+
+  this->head_->pPrev_ = nullptr;
+  this->tail_->pNext_ = nullptr;
+  for (size_type i = 0; i < runs; ++i) {
+    Chain<T> &run = chains[i];
+    run.head_ = firsts[i];
+    run.tail_ = i + 1 < runs ? firsts[i + 1]->pPrev_ : this->tail_;
+    run.size_ = first_of(i + 1) - first_of(i);
+    run.head_->pPrev_ = nullptr;
+    run.tail_->pNext_ = nullptr;
+  }
+
+  // On failure every node is still in exactly one of the chains or pieces.
+  auto fail_if_any = [&]() {
+    for (auto &error : errors) {
+      if (!error) continue;
+      Chain<T> all;
+      for (auto &run : chains) detail::concat_chains(all, run);
+      for (auto &piece : pieces) detail::concat_chains(all, piece);
+      Node<T> *prev = nullptr;
+      for (Node<T> *item = all.head_; item != nullptr; item = item->pNext_) {
+        item->pPrev_ = prev;
+        prev = item;
+      }
+      attach_chain(all);
+#if M3MPM_HAS_EXCEPTIONS
+      std::rethrow_exception(error);
+#endif
+    }
+  };
+
+  detail::run_tasks(
+      runs,
+      [&](size_t i) {
+        size_type local = 0;
+        detail::sort_chain(chains[i], local);
+        hops[i] = local;
+      },
+      errors);
+  fail_if_any();
+  if (runs > 1) {
+    M3MPM_TRY {
+      std::sort(samples.begin(), samples.end(),
+                [](const T *a, const T *b) { return *a < *b; });
+    } M3MPM_CATCH_ALL {
+      errors[0] = std::current_exception();
+    }
+    fail_if_any();
+    for (size_type j = 0; j + 1 < runs; ++j) {
+      splitters[j] = samples[(j + 1) * kSamples];
+    }
+
+    detail::run_tasks(
+        runs,
+        [&](size_t i) {
+          size_type local = 0;
+          detail::split_chain(chains[i], splitters, &pieces[i * runs], local);
+          hops[i] += local;
+        },
+        errors);
+    fail_if_any();
+    // Bucket j gathers piece j of every run, in run order, and merges them
+    // pairwise; ties keep the earlier run first.
+    detail::run_tasks(
+        runs,
+        [&](size_t j) {
+          size_type local = 0;
+          for (size_type width = 1; width < runs; width *= 2) {
+            for (size_type i = 0; i + width < runs; i += 2 * width) {
+              detail::merge_chains(pieces[i * runs + j],
+                                   pieces[(i + width) * runs + j], local);
+            }
+          }
+          hops[j] += local;
+        },
+        errors);
+    fail_if_any();
+    for (size_type j = 0; j < runs; ++j) {
+      detail::concat_chains(chains[0], pieces[j]);
+    }
+  }
+  size_type total = 0;
+  for (size_type count : hops) total += count;
+  this->on_hops(total);
+  attach_chain(chains[0]);
+}
+
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::radix_sort() {
+  radix_sort([](const_reference item) { return item; });
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename Key>
+void List<T, Alloc, Stats>::radix_sort(Key key) {
+  auto scope = this->op_scope(Op::kSort);
+  if (this->size_ < 2) return;
+  drop_index();
+  this->head_->pPrev_ = nullptr;
+  this->tail_->pNext_ = nullptr;
+  detail::Chain<T> chain{this->head_, this->tail_, this->size_};
+  size_type hops = 0;
+  M3MPM_TRY {
+    detail::radix_sort_chain(chain, key, hops);
+  } M3MPM_CATCH_ALL {
+    attach_chain(chain);
+    this->on_hops(hops);
+    M3MPM_RETHROW;
+  }
+  attach_chain(chain);
+  this->on_hops(hops);
+}
+
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::attach_chain(detail::Chain<T> &c) {
+  this->head_ = c.head_;
+  this->tail_ = c.tail_;
+  this->head_->pPrev_ = p_after_tail_;
+  this->tail_->pNext_ = p_after_tail_;
+  p_after_tail_->pNext_ = this->head_;
+  p_after_tail_->pPrev_ = this->tail_;
+}
+
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::erase(iterator pos) {
+  auto scope = this->op_scope(Op::kErase);
   if (pos.pNode_ == nullptr) {
-    throw std::range_error(
-        "error erase(): the iterator is empty or the List is empty");
+    M3MPM_THROW(std::range_error(
+        "error erase(): the iterator is empty or the List is empty"));
   } else if (pos.pNode_ == this->p_after_tail_) {
-    throw std::range_error(
-        "error erase(): pointer being freed was not allocated");
+    M3MPM_THROW(std::range_error(
+        "error erase(): pointer being freed was not allocated"));
   }
 
   if (pos.pNode_ == this->head_) {
@@ -361,15 +679,18 @@ void List<T>::erase(iterator pos) {
     this->pop_back();
   } else {
     Node<T> *tmp = pos.pNode_;
+    if (index_) index_erasing(tmp);
     pos.pNode_->pPrev_->pNext_ = pos.pNode_->pNext_;
     pos.pNode_->pNext_->pPrev_ = pos.pNode_->pPrev_;
-    delete tmp;
+    release_node(tmp);
     this->size_--;
   }
 }
 
-template <typename T>
-void List<T>::unique() {
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::unique() {
+  auto scope = this->op_scope(Op::kUnique);
+  this->on_hops(this->size_);
   if (!this->empty()) {
     iterator pos;
     iterator pos_del;
@@ -386,9 +707,10 @@ void List<T>::unique() {
   }
 }
 
-template <typename T>
-typename List<T>::listIterator List<T>::insert(iterator pos,
-                                               const_reference value) {
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::listIterator List<T, Alloc, Stats>::insert(
+    iterator pos, const_reference value) {
+  auto scope = this->op_scope(Op::kInsert);
   Node<T> *tmp;
   if (this->empty()) {
     this->push_front(value);
@@ -400,19 +722,22 @@ typename List<T>::listIterator List<T>::insert(iterator pos,
     this->push_back(value);
     tmp = this->tail_;
   } else {
-    tmp = new Node<T>(value);
+    tmp = this->create_node(value);
     tmp->pNext_ = pos.pNode_;
     tmp->pPrev_ = pos.pNode_->pPrev_;
 
     pos.pNode_->pPrev_->pNext_ = tmp;
     pos.pNode_->pPrev_ = tmp;
     this->size_++;
+    if (index_) index_inserted(tmp);
   }
   return iterator(tmp);
 }
 
-template <typename T>
-void List<T>::merge(List &other) {
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::merge(List &other) {
+  auto scope = this->op_scope(Op::kMerge);
+  this->on_hops(this->size_ + other.size_);
   if (this->empty()) {
     this->swap(other);
   } else if (!this->empty() && !other.empty()) {
@@ -439,10 +764,11 @@ void List<T>::merge(List &other) {
   other.clear();
 }
 
-template <typename T>
-void List<T>::splice(const_iterator pos, List &other) {
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::splice(const_iterator pos, List &other) {
+  auto scope = this->op_scope(Op::kSplice);
   if (this->size() + other.size() >= this->max_size()) {
-    throw std::out_of_range("splice() error: maximum size exceeded");
+    M3MPM_THROW(std::out_of_range("splice() error: maximum size exceeded"));
   }
   if (!other.empty()) {
     iterator it_other = other.begin();
@@ -454,17 +780,595 @@ void List<T>::splice(const_iterator pos, List &other) {
   }
 }
 
-template <typename T>
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::release_node(Node<T> *node) {
+  std::less<const Node<T> *> before;
+  if (slab_ && !before(node, slab_) && before(node, slab_ + slab_size_)) {
+    using node_traits = typename LSQContainer<T, Alloc, Stats>::node_traits;
+    typename LSQContainer<T, Alloc, Stats>::node_allocator alloc;
+    node_traits::destroy(alloc, node);
+    this->on_destroy();
+    if (--slab_live_ == 0) {
+      node_traits::deallocate(alloc, slab_, slab_size_);
+      this->on_deallocate(slab_size_ * sizeof(Node<T>));
+      slab_ = nullptr;
+      slab_size_ = 0;
+    }
+  } else {
+    this->destroy_node(node);
+  }
+}
+
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::compact() {
+  using node_traits = typename LSQContainer<T, Alloc, Stats>::node_traits;
+  if (this->empty()) return;
+  drop_index();
+
+  const size_type n = this->size_;
+  typename LSQContainer<T, Alloc, Stats>::node_allocator alloc;
+  Node<T> *slab = node_traits::allocate(alloc, n);
+  this->on_allocate(n * sizeof(Node<T>));
+  this->on_hops(n);
+  size_type built = 0;
+  M3MPM_TRY {
+    for (Node<T> *node = this->head_; built < n; node = node->pNext_) {
+      node_traits::construct(alloc, slab + built,
+                             std::move_if_noexcept(node->data_));
+      ++built;
+    }
+  } M3MPM_CATCH_ALL {
+    for (size_type i = 0; i < built; ++i) node_traits::destroy(alloc, slab + i);
+    node_traits::deallocate(alloc, slab, n);
+    this->on_deallocate(n * sizeof(Node<T>));
+    M3MPM_RETHROW;
+  }
+  this->on_construct(n);
+
+  Node<T> *node = this->head_;
+  for (size_type i = 0; i < n; ++i) {
+    Node<T> *next = node->pNext_;
+    release_node(node);
+    node = next;
+  }
+
+  for (size_type i = 0; i < n; ++i) {
+    slab[i].pPrev_ = i == 0 ? p_after_tail_ : slab + i - 1;
+    slab[i].pNext_ = i + 1 == n ? p_after_tail_ : slab + i + 1;
+  }
+  this->head_ = slab;
+  this->tail_ = slab + n - 1;
+  p_after_tail_->pNext_ = this->head_;
+  p_after_tail_->pPrev_ = this->tail_;
+  slab_ = slab;
+  slab_size_ = slab_live_ = n;
+}
+
+template <typename T, typename Alloc, typename Stats>
+double List<T, Alloc, Stats>::fragmentation() const {
+  if (this->size_ < 2) return 0.0;
+
+  this->on_hops(this->size_ - 1);
+  size_type scattered = 0;
+  const Node<T> *node = this->head_;
+  for (size_type i = 1; i < this->size_; ++i) {
+    const Node<T> *next = node->pNext_;
+    uintptr_t from = reinterpret_cast<uintptr_t>(node);
+    uintptr_t to = reinterpret_cast<uintptr_t>(next);
+    if (to <= from || to - from > 2 * sizeof(Node<T>)) ++scattered;
+    node = next;
+  }
+  return static_cast<double>(scattered) / static_cast<double>(this->size_ - 1);
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::size_type List<T, Alloc, Stats>::memory_usage(
+    bool deep) const {
+  using node_allocator =
+      typename LSQContainer<T, Alloc, Stats>::node_allocator;
+  const size_type node_bytes = detail::allocation_size<node_allocator>(1);
+  // Slab nodes are paid for by the slab, live or not.
+  size_type bytes = sizeof(*this) + (this->size_ - slab_live_) * node_bytes;
+  if (p_after_tail_) bytes += node_bytes;
+  if (slab_) bytes += detail::allocation_size<node_allocator>(slab_size_);
+  if (SkipIndex<T> *index = built_index()) {
+    bytes += detail::heap_allocation_size(sizeof(SkipIndex<T>)) +
+             index->memory_usage();
+  }
+  if constexpr (detail::has_memory_usage<T>::value) {
+    if (deep) {
+      this->on_hops(this->size_);
+      const Node<T> *node = this->head_;
+      for (size_type i = 0; i < this->size_; ++i, node = node->pNext_) {
+        bytes += detail::element_memory_usage(node->data_);
+      }
+    }
+  }
+  return bytes;
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::reference
+List<T, Alloc, Stats>::at(size_type pos) {
+  if (pos >= this->size_) {
+    M3MPM_THROW(std::out_of_range("error at(): position out of range"));
+  }
+  return index().at(pos)->data_;
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::const_reference List<T, Alloc, Stats>::at(
+    size_type pos) const {
+  if (pos >= this->size_) {
+    M3MPM_THROW(std::out_of_range("error at(): position out of range"));
+  }
+  return index().at(pos)->data_;
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::iterator List<T, Alloc, Stats>::advance(
+    iterator it, difference_type n) {
+  if (it.pNode_ == nullptr) {
+    M3MPM_THROW(std::logic_error("error advance(): iterator is empty"));
+  }
+  size_type from =
+      it.pNode_ == p_after_tail_ ? this->size_ : index().rank(it.pNode_);
+  if ((n < 0 && static_cast<size_type>(-n) > from) ||
+      (n > 0 && static_cast<size_type>(n) > this->size_ - from)) {
+    M3MPM_THROW(std::out_of_range("error advance(): position out of range"));
+  }
+  size_type to = from + n;
+  if (to == this->size_) return end();
+  return iterator(index().at(to));
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::iterator List<T, Alloc, Stats>::lower_bound(
+    const_reference value) {
+  if (this->empty()) return end();
+  return iterator(index().lower_bound(value));
+}
+
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::drop_index() {
+  delete index_.exchange(nullptr);
+}
+
+template <typename T, typename Alloc, typename Stats>
+SkipIndex<T> &List<T, Alloc, Stats>::index() const {
+  SkipIndex<T> *index = built_index();
+  if (index == nullptr) {
+    // Concurrent const lookups may each build one; the first published
+    // wins and the others are discarded.
+    SkipIndex<T> *built = new SkipIndex<T>(p_after_tail_, this->size_);
+    if (index_.compare_exchange_strong(index, built,
+                                       std::memory_order_acq_rel,
+                                       std::memory_order_acquire)) {
+      index = built;
+    } else {
+      delete built;
+    }
+  }
+  return *index;
+}
+
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::index_inserted(Node<T> *node) {
+  // The index is only a cache: if it cannot grow, drop it and let the next
+  // lookup rebuild it rather than fail an insertion that already happened.
+  M3MPM_TRY {
+    built_index()->on_insert(node);
+  } M3MPM_CATCH_ALL {
+    drop_index();
+  }
+}
+
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::index_erasing(Node<T> *node) {
+  built_index()->on_erase(node);
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename F>
+void List<T, Alloc, Stats>::visit_nodes(Node<T> *node, size_type n, F f) {
+  uintptr_t stride = 0;
+  for (; n != 0; --n) {
+    Node<T> *next = node->pNext_;
+    uintptr_t from = reinterpret_cast<uintptr_t>(node);
+    uintptr_t to = reinterpret_cast<uintptr_t>(next);
+    // Only a stride the last hop repeated is worth extrapolating.
+    if (to - from == stride) {
+      __builtin_prefetch(
+          reinterpret_cast<const void *>(to + stride * kPrefetchDistance));
+    }
+    stride = to - from;
+    f(node);
+    node = next;
+  }
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename F>
+void List<T, Alloc, Stats>::for_each(F f) {
+  this->on_hops(this->size_);
+  visit_nodes(this->head_, this->size_, [&f](Node<T> *node) {
+    f(node->data_);
+  });
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename F>
+void List<T, Alloc, Stats>::for_each(F f) const {
+  this->on_hops(this->size_);
+  visit_nodes(this->head_, this->size_, [&f](const Node<T> *node) {
+    f(static_cast<const_reference>(node->data_));
+  });
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename List<T, Alloc, Stats>::size_type Chunk, typename F>
+void List<T, Alloc, Stats>::for_each_chunk(F f) {
+  static_assert(Chunk > 0, "for_each_chunk: Chunk must be positive");
+  value_type *items[Chunk];
+  size_type count = 0;
+  this->on_hops(this->size_);
+  visit_nodes(this->head_, this->size_, [&](Node<T> *node) {
+    items[count++] = &node->data_;
+    if (count == Chunk) {
+      f(static_cast<value_type *const *>(items), count);
+      count = 0;
+    }
+  });
+  if (count != 0) f(static_cast<value_type *const *>(items), count);
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename List<T, Alloc, Stats>::size_type Chunk, typename F>
+void List<T, Alloc, Stats>::for_each_chunk(F f) const {
+  static_assert(Chunk > 0, "for_each_chunk: Chunk must be positive");
+  const value_type *items[Chunk];
+  size_type count = 0;
+  this->on_hops(this->size_);
+  visit_nodes(this->head_, this->size_, [&](const Node<T> *node) {
+    items[count++] = &node->data_;
+    if (count == Chunk) {
+      f(static_cast<const value_type *const *>(items), count);
+      count = 0;
+    }
+  });
+  if (count != 0) f(static_cast<const value_type *const *>(items), count);
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::size_type List<T, Alloc, Stats>::distance(
+    const Node<T> *first, const Node<T> *last) const {
+  if (first == last) return 0;
+  if (first == this->head_ && last == p_after_tail_) return this->size_;
+  if (SkipIndex<T> *index = built_index()) {
+    size_type to = last == p_after_tail_ ? this->size_ : index->rank(last);
+    return to - index->rank(first);
+  }
+  size_type n = 0;
+  for (; first != last; first = first->pNext_) ++n;
+  this->on_hops(n);
+  return n;
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename V>
+void List<T, Alloc, Stats>::parallel_chunks(Node<T> *first, size_type n,
+                                            size_type threads,
+                                            V visit) const {
+  this->on_hops(n);
+  const size_type chunks = (n + kParallelGrain - 1) / kParallelGrain;
+  const size_type tasks = std::min(detail::thread_count(threads), chunks);
+  if (tasks < 2) {
+    if (n != 0) visit(0, first, n);
+    return;
+  }
+  auto count_of = [n](size_type c) {
+    return std::min(kParallelGrain, n - c * kParallelGrain);
+  };
+  if (n >= kParallelIndexMin && !built_index()) {
+    // Like the index's other users, the scan can do without it.
+    M3MPM_TRY {
+      this->index();
+    } M3MPM_CATCH_ALL {
+    }
+  }
+  SkipIndex<T> *const index = built_index();
+  std::vector<Node<T> *> starts(index ? 0 : chunks);
+  std::vector<std::exception_ptr> errors(tasks);
+  std::atomic<size_type> next{0};
+  std::atomic<size_type> published{0};
+  std::atomic<bool> failed{false};
+  const size_type offset = index ? index->rank(first) : 0;
+
+  // Without the index, task 0 walks the list once and publishes where each
+  // chunk starts; a thread that claims a chunk ahead of the walk waits for
+  // it. Task 0 joins the others once the walk is done.
+  auto start_of = [&](size_type c) {
+    if (index) return index->at(offset + c * kParallelGrain);
+    while (published.load(std::memory_order_acquire) <= c) {
+      std::this_thread::yield();
+    }
+    return starts[c];
+  };
+  detail::run_tasks(
+      tasks,
+      [&](size_t task) {
+        if (task == 0 && !index) {
+          Node<T> *node = first;
+          for (size_type c = 0; c < chunks; ++c) {
+            starts[c] = node;
+            published.store(c + 1, std::memory_order_release);
+            if (c + 1 < chunks) {
+              visit_nodes(node, kParallelGrain,
+                          [&node](Node<T> *at) { node = at->pNext_; });
+            }
+          }
+        }
+        for (size_type c = 0; !failed.load(std::memory_order_relaxed) &&
+                              (c = next.fetch_add(1)) < chunks;) {
+          M3MPM_TRY {
+            visit(c, start_of(c), count_of(c));
+          } M3MPM_CATCH_ALL {
+            failed.store(true, std::memory_order_relaxed);
+            M3MPM_RETHROW;
+          }
+        }
+      },
+      errors);
+  detail::rethrow_first(errors);
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename F>
+void List<T, Alloc, Stats>::parallel_for_each(F f, size_type threads) {
+  if (this->size_ != 0) parallel_for_each(begin(), end(), f, threads);
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename F>
+void List<T, Alloc, Stats>::parallel_for_each(iterator first, iterator last,
+                                              F f, size_type threads) {
+  if (first.pNode_ == nullptr || last.pNode_ == nullptr) {
+    M3MPM_THROW(
+        std::logic_error("error parallel_for_each(): iterator is empty"));
+  }
+  auto apply = [&f](Node<T> *node) { f(node->data_); };
+  parallel_chunks(first.pNode_, distance(first.pNode_, last.pNode_), threads,
+                  [&apply](size_type, Node<T> *node, size_type count) {
+                    visit_nodes(node, count, apply);
+                  });
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename U, typename Op>
+U List<T, Alloc, Stats>::parallel_reduce(U init, Op op,
+                                         size_type threads) const {
+  if (this->size_ == 0) return init;
+  return parallel_reduce(cbegin(), cend(), std::move(init), op, threads);
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename U, typename Op>
+U List<T, Alloc, Stats>::parallel_reduce(const_iterator first,
+                                         const_iterator last, U init, Op op,
+                                         size_type threads) const {
+  if (first.pNode_ == nullptr || last.pNode_ == nullptr) {
+    M3MPM_THROW(
+        std::logic_error("error parallel_reduce(): iterator is empty"));
+  }
+  const size_type n = distance(first.pNode_, last.pNode_);
+  if (n == 0) return init;
+  // One partial result per chunk, not per thread, so that the order in
+  // which op meets the elements does not depend on the scheduling.
+  std::vector<U> partials((n + kParallelGrain - 1) / kParallelGrain, init);
+  parallel_chunks(first.pNode_, n, threads,
+                  [&](size_type c, Node<T> *node, size_type count) {
+                    U acc = std::move(partials[c]);
+                    visit_nodes(node, count,
+                                [&](const Node<T> *at) {
+                                  acc = op(std::move(acc),
+                                           static_cast<const T &>(at->data_));
+                                });
+                    partials[c] = std::move(acc);
+                  });
+  if (partials.size() == 1) return std::move(partials[0]);
+  U result = std::move(init);
+  for (U &partial : partials) {
+    result = op(std::move(result), std::move(partial));
+  }
+  return result;
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename F>
+void List<T, Alloc, Stats>::parallel_transform(F f, size_type threads) {
+  if (this->size_ != 0) parallel_transform(begin(), end(), f, threads);
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename F>
+void List<T, Alloc, Stats>::parallel_transform(iterator first, iterator last,
+                                               F f, size_type threads) {
+  if (first.pNode_ == nullptr || last.pNode_ == nullptr) {
+    M3MPM_THROW(
+        std::logic_error("error parallel_transform(): iterator is empty"));
+  }
+  auto apply = [&f](Node<T> *node) { node->data_ = f(node->data_); };
+  parallel_chunks(first.pNode_, distance(first.pNode_, last.pNode_), threads,
+                  [&apply](size_type, Node<T> *node, size_type count) {
+                    visit_nodes(node, count, apply);
+                  });
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <typename F>
+void List<T, Alloc, Stats>::scan_batches(F f) const {
+  T values[kSimdBatch];
+  Node<T> *node = this->head_;
+  size_type left = this->size_;
+  size_type hops = 0;
+  while (left != 0) {
+    const size_type count = std::min(left, kSimdBatch);
+    Node<T> *first = node;
+    size_type i = 0;
+    visit_nodes(node, count, [&](Node<T> *at) {
+      values[i++] = at->data_;
+      node = at->pNext_;
+    });
+    hops += count;
+    left -= count;
+    if (!f(static_cast<const T *>(values), count, first)) break;
+  }
+  this->on_hops(hops);
+}
+
+template <typename T, typename Alloc, typename Stats>
+Node<T> *List<T, Alloc, Stats>::find_node(const_reference value) const {
+  if constexpr (detail::kSimdElement<T>) {
+    Node<T> *found = p_after_tail_;
+    scan_batches([&](const T *values, size_type count, Node<T> *first) {
+      size_type i = detail::simd_find(values, count, value);
+      if (i == count) return true;
+      for (; i != 0; --i) first = first->pNext_;
+      found = first;
+      return false;
+    });
+    return found;
+  } else {
+    Node<T> *node = this->head_;
+    size_type hops = 0;
+    while (hops < this->size_ && !(node->data_ == value)) {
+      node = node->pNext_;
+      ++hops;
+    }
+    this->on_hops(hops);
+    return hops < this->size_ ? node : p_after_tail_;
+  }
+}
+
+template <typename T, typename Alloc, typename Stats>
+template <bool kMax>
+Node<T> *List<T, Alloc, Stats>::extreme_node() const {
+  if (this->size_ == 0) return p_after_tail_;
+  Node<T> *best = this->head_;
+  if constexpr (detail::kSimdElement<T>) {
+    // std::min_element keeps a NaN it starts from; the kernels skip NaNs.
+    if constexpr (std::is_floating_point_v<T>) {
+      if (best->data_ != best->data_) return best;
+    }
+    T best_value = best->data_;
+    scan_batches([&](const T *values, size_type count, Node<T> *first) {
+      size_type i = kMax ? detail::simd_max(values, count)
+                         : detail::simd_min(values, count);
+      if (i != count &&
+          (kMax ? best_value < values[i] : values[i] < best_value)) {
+        best_value = values[i];
+        for (; i != 0; --i) first = first->pNext_;
+        best = first;
+      }
+      return true;
+    });
+  } else {
+    this->on_hops(this->size_);
+    visit_nodes(this->head_, this->size_, [&best](Node<T> *node) {
+      if (kMax ? best->data_ < node->data_ : node->data_ < best->data_) {
+        best = node;
+      }
+    });
+  }
+  return best;
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::iterator List<T, Alloc, Stats>::find(
+    const_reference value) {
+  return iterator(find_node(value));
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::const_iterator List<T, Alloc, Stats>::find(
+    const_reference value) const {
+  return const_iterator(find_node(value));
+}
+
+template <typename T, typename Alloc, typename Stats>
+bool List<T, Alloc, Stats>::contains(const_reference value) const {
+  return find_node(value) != p_after_tail_;
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::size_type List<T, Alloc, Stats>::count(
+    const_reference value) const {
+  size_type total = 0;
+  if constexpr (detail::kSimdElement<T>) {
+    scan_batches([&](const T *values, size_type count, Node<T> *) {
+      total += detail::simd_count(values, count, value);
+      return true;
+    });
+  } else {
+    this->on_hops(this->size_);
+    visit_nodes(this->head_, this->size_, [&](Node<T> *node) {
+      if (node->data_ == value) ++total;
+    });
+  }
+  return total;
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::iterator
+List<T, Alloc, Stats>::min_element() {
+  return iterator(extreme_node<false>());
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::const_iterator
+List<T, Alloc, Stats>::min_element() const {
+  return const_iterator(extreme_node<false>());
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::iterator
+List<T, Alloc, Stats>::max_element() {
+  return iterator(extreme_node<true>());
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::const_iterator
+List<T, Alloc, Stats>::max_element() const {
+  return const_iterator(extreme_node<true>());
+}
+
+template <typename T, typename Alloc, typename Stats>
+typename List<T, Alloc, Stats>::value_type List<T, Alloc, Stats>::sum()
+    const {
+  value_type total = value_type();
+  if constexpr (detail::kSimdElement<T>) {
+    scan_batches([&total](const T *values, size_type count, Node<T> *) {
+      total = static_cast<T>(total + detail::simd_sum(values, count));
+      return true;
+    });
+  } else {
+    this->on_hops(this->size_);
+    visit_nodes(this->head_, this->size_, [&total](Node<T> *node) {
+      total = total + node->data_;
+    });
+  }
+  return total;
+}
+
+template <typename T, typename Alloc, typename Stats>
 template <typename... Args>
-typename List<T>::listIterator List<T>::emplace(const_iterator pos,
-                                                Args &&...args) {
-  List<T> tmp_l{args...};
+typename List<T, Alloc, Stats>::listIterator List<T, Alloc, Stats>::emplace(
+    const_iterator pos, Args &&...args) {
+  List tmp_l{args...};
   size_t size_args = tmp_l.size();
   iterator tmp_it;
   if (size_args == 0) {
-    Node<T> *tmp_n = new Node<T>();
-    tmp_it = this->insert(pos, tmp_n->data_);
-    delete tmp_n;
+    tmp_it = this->insert(pos, value_type());
   } else {
     for (iterator i = tmp_l.begin(); i != tmp_l.end(); ++i) {
       tmp_it = this->insert(pos, *i);
@@ -473,15 +1377,13 @@ typename List<T>::listIterator List<T>::emplace(const_iterator pos,
   return tmp_it;
 }
 
-template <typename T>
+template <typename T, typename Alloc, typename Stats>
 template <typename... Args>
-void List<T>::emplace_back(Args &&...args) {
-  List<T> tmp_l{args...};
+void List<T, Alloc, Stats>::emplace_back(Args &&...args) {
+  List tmp_l{args...};
   size_t size_args = tmp_l.size();
   if (size_args == 0) {
-    Node<T> *tmp_n = new Node<T>();
-    this->push_back(tmp_n->data_);
-    delete tmp_n;
+    this->push_back(value_type());
   } else {
     for (iterator i = tmp_l.begin(); i != tmp_l.end(); ++i) {
       this->push_back(*i);
@@ -489,15 +1391,13 @@ void List<T>::emplace_back(Args &&...args) {
   }
 }
 
-template <typename T>
+template <typename T, typename Alloc, typename Stats>
 template <typename... Args>
-void List<T>::emplace_front(Args &&...args) {
-  List<T> tmp_l{args...};
+void List<T, Alloc, Stats>::emplace_front(Args &&...args) {
+  List tmp_l{args...};
   size_t size_args = tmp_l.size();
   if (size_args == 0) {
-    Node<T> *tmp_n = new Node<T>();
-    this->push_front(tmp_n->data_);
-    delete tmp_n;
+    this->push_front(value_type());
   } else {
     for (iterator i = --tmp_l.end(); i != --tmp_l.begin(); --i) {
       this->push_front(*i);
@@ -505,8 +1405,8 @@ void List<T>::emplace_front(Args &&...args) {
   }
 }
 
-template <typename T>
-void List<T>::print() {
+template <typename T, typename Alloc, typename Stats>
+void List<T, Alloc, Stats>::print() {
   Node<T> *tmp = this->head_;
   if (this->p_after_tail_) {
     if (tmp == nullptr) {
@@ -1,21 +1,49 @@
 #ifndef SRC_M3MPM_LIST_H_
 #define SRC_M3MPM_LIST_H_
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
 #include <exception>
+#include <functional>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "LSQContainer.h"
+#include "config.h"
+#include "list_sort.h"
+#include "parallel.h"
+#include "simd.h"
+#include "skip_index.h"
 namespace m3mpm {
-template <typename T>
-class List : public LSQContainer<T> {
+template <typename T, typename Alloc = std::allocator<T>,
+          typename Stats = NoStats>
+class List : public LSQContainer<T, Alloc, Stats> {
  public:
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
   using size_type = size_t;
+  using difference_type = ptrdiff_t;
 
+  // Bidirectional iterators over a ring closed by the sentinel behind end(),
+  // so stepping past either end wraps around; *end() is the sentinel's
+  // value-initialized element. With M3MPM_CHECKED_ITERATORS (see config.h)
+  // dereferencing or moving an empty iterator throws std::logic_error;
+  // without it that is undefined, as for std::list.
   class listIterator {
-   private:
    public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
     Node<T> *pNode_;
 
     listIterator() : pNode_(nullptr) {}
@@ -23,9 +51,12 @@ class List : public LSQContainer<T> {
     explicit listIterator(const List &l) : pNode_(l.head_) {}
     listIterator(const listIterator &other) : pNode_(other.pNode_) {}
 
-    reference operator*();
+    reference operator*() const;
+    pointer operator->() const;
     listIterator &operator++();
+    listIterator operator++(int);
     listIterator &operator--();
+    listIterator operator--(int);
     listIterator &operator=(const listIterator &other);
     bool operator!=(const listIterator &other) const;
     bool operator==(const listIterator &other) const;
@@ -33,17 +64,63 @@ class List : public LSQContainer<T> {
 
   class listConstIterator : public listIterator {
    public:
+    using pointer = const T *;
+    using reference = const T &;
+
     listConstIterator() : listIterator() {}
     explicit listConstIterator(Node<T> *node) : listIterator(node) {}
-    explicit listConstIterator(const List<T> &l) : listIterator(l) {}
+    explicit listConstIterator(const List &l) : listIterator(l) {}
+    listConstIterator(const listIterator &other) : listIterator(other) {}
     listConstIterator(const listConstIterator &other) : listIterator(other) {}
-    const_reference operator*();
+    listConstIterator &operator=(const listConstIterator &other) = default;
+
+    reference operator*() const;
+    pointer operator->() const;
+    listConstIterator &operator++();
+    listConstIterator operator++(int);
+    listConstIterator &operator--();
+    listConstIterator operator--(int);
   };
   using iterator = listIterator;
   using const_iterator = listConstIterator;
 
  private:
   Node<T> *p_after_tail_;
+  // Contiguous block filled by compact(); nodes inside it are destroyed in
+  // place and the block is returned once the last of them is erased.
+  Node<T> *slab_ = nullptr;
+  size_type slab_size_ = 0;
+  size_type slab_live_ = 0;
+  // Built by the first positional or ordered lookup, then maintained by
+  // every insertion and erasure until clear(), compact() or drop_index().
+  // Const lookups may build it concurrently, so it is published atomically.
+  mutable std::atomic<SkipIndex<T> *> index_{nullptr};
+
+  SkipIndex<T> &index() const;
+  SkipIndex<T> *built_index() const {
+    return index_.load(std::memory_order_acquire);
+  }
+  void index_inserted(Node<T> *node);
+  void index_erasing(Node<T> *node);
+  void release_node(Node<T> *node);
+  // Takes back the nodes of c, in order, as the whole content of the list.
+  void attach_chain(detail::Chain<T> &c);
+  template <typename F>
+  static void visit_nodes(Node<T> *node, size_type n, F f);
+  // Number of nodes from first up to last, through the index when built.
+  size_type distance(const Node<T> *first, const Node<T> *last) const;
+  // Calls visit(chunk, node, count) for the kParallelGrain chunks of the n
+  // nodes from first, concurrently as described at parallel_for_each().
+  template <typename V>
+  void parallel_chunks(Node<T> *first, size_type n, size_type threads,
+                       V visit) const;
+  // Calls f(values, count, first) on the values of the next kSimdBatch
+  // nodes, starting at first, until f returns false or the list ends.
+  template <typename F>
+  void scan_batches(F f) const;
+  Node<T> *find_node(const_reference value) const;
+  template <bool kMax>
+  Node<T> *extreme_node() const;
 
  public:
   List();
@@ -53,7 +130,7 @@ class List : public LSQContainer<T> {
   List(List &&l);
   ~List() {
     clear();
-    delete p_after_tail_;
+    if (p_after_tail_) this->destroy_node(p_after_tail_);
   }
 
   const_reference front() const;
@@ -68,8 +145,17 @@ class List : public LSQContainer<T> {
   void pop_back();
   void clear();
   void swap(List &other);
+
+  // try_ forms of front(), back() and the pops for an often empty list:
+  // null, false or an empty optional instead of an exception.
+  const value_type *try_front() const;
+  const value_type *try_back() const;
+  bool try_pop_front(value_type &out);
+  std::optional<value_type> try_pop_front();
+  bool try_pop_back(value_type &out);
+  std::optional<value_type> try_pop_back();
   void reverse();
-  List<T> &operator=(List &&l);
+  List &operator=(List &&l);
 
   bool empty() const;
   iterator begin();
@@ -78,12 +164,144 @@ class List : public LSQContainer<T> {
   const_iterator cend() const;
 
   void sort();
+  // Stable merge sort by relinking: no element is copied or moved, and
+  // iterators keep pointing at the same elements, which sort() does not
+  // promise. The chain is cut into one run per thread, at least
+  // kParallelSortGrain nodes each, and splitters are sampled from it; the
+  // runs are sorted concurrently, cut again at the splitters, and the
+  // pieces between two splitters are merged concurrently. Only the cutting
+  // is serial: one walk, or O(log n) steps per cut while the skip index is
+  // built. threads = 0 uses every hardware thread and threads = 1 sorts on
+  // the calling thread, in O(n log n) either way. Drops the skip index. If
+  // a comparison throws, the list keeps all its elements in an unspecified
+  // order.
+  static constexpr size_type kParallelSortGrain = 1 << 14;
+  void parallel_sort(size_type threads = 0);
+  // Stable LSD radix sort for integral or floating-point T, or for any T
+  // through a projection key(element) that returns such a key, e.g. an
+  // event's timestamp. The key bits and node addresses are copied into an
+  // array in one walk, sorted there byte by byte with counting passes that
+  // skip the bytes every key shares, and the nodes are relinked in the
+  // resulting order: O(n) per differing key byte, no comparisons, and no
+  // element copied or moved. The array takes two (key, pointer) pairs per
+  // element while it runs. Floats order -0.0 before +0.0, with NaNs at the
+  // end of their sign (see detail::radix_bits). Like parallel_sort(), it
+  // keeps iterators on their elements and drops the skip index; if key
+  // throws, the list is left as it was.
+  void radix_sort();
+  template <typename Key>
+  void radix_sort(Key key);
   void erase(iterator pos);
   void unique();
   iterator insert(iterator pos, const_reference value);
   void merge(List &other);
   void splice(const_iterator pos, List &other);
 
+  // Moves every element, in traversal order, into a single contiguous slab
+  // and relinks the list through it. Invalidates all iterators, pointers and
+  // references to elements; end() stays valid.
+  void compact();
+  // Share of links whose next node does not start within two node sizes
+  // after the current one: 0 right after compact(), close to 1 once churn
+  // has scattered the nodes over the heap. Costs one traversal.
+  double fragmentation() const;
+  // Bytes held, counted as LSQContainer::memory_usage() does, plus the
+  // sentinel, the whole slab of the last compact() for as long as any of
+  // its nodes is live, and the skip index while there is one.
+  size_type memory_usage(bool deep = false) const;
+
+  // Positional access and ordered search through a skip index over the
+  // node chain, O(log n) expected. The index is built on first use in O(n)
+  // and from then on costs every insertion and erasure O(log n) expected
+  // time plus about 30 bytes per element; drop_index() releases it. Const
+  // at() may be called from several threads at once, even before the index
+  // exists. lower_bound() requires the list to be sorted in ascending order.
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+  iterator advance(iterator it, difference_type n);
+  iterator lower_bound(const_reference value);
+  bool indexed() const { return index_ != nullptr; }
+  void drop_index();
+
+  // Bulk visitation for full scans. The loop runs size() steps instead of
+  // comparing iterators with end(), and when the last two hops had the same
+  // stride it prefetches the address kPrefetchDistance hops further along
+  // it. That pays off when consecutive nodes are evenly spaced (after
+  // compact(), with an arena allocator, or when nodes were pushed in order).
+  // Scattered lists see no gain from it: their strides rarely repeat, so
+  // they get no prefetches and stay bound by the chain of cache misses,
+  // like the iterator loop.
+  static constexpr size_type kPrefetchDistance = 64;
+  template <typename F>
+  void for_each(F f);
+  template <typename F>
+  void for_each(F f) const;
+  // Same walk as for_each(), but hands the elements over in batches:
+  // f(items, count) with items an array of up to Chunk element pointers.
+  template <size_type Chunk = 64, typename F>
+  void for_each_chunk(F f);
+  template <size_type Chunk = 64, typename F>
+  void for_each_chunk(F f) const;
+
+  // Data-parallel scans over the list or over [first, last). The nodes are
+  // cut into chunks of kParallelGrain that the threads claim one by one,
+  // so a thread held up by a slow chunk leaves the rest to the others.
+  // Through the skip index every thread finds the start of its chunk in
+  // O(log n). A scan of kParallelIndexMin nodes or more builds the index
+  // first if the list has none: a one-off cost of several serial scans,
+  // which later scans and lookups then reuse (see at() for what the index
+  // costs to keep; drop_index() releases it). Without the index the
+  // calling thread walks the list once and the others start on a chunk as
+  // soon as the walk has passed its first node, so throughput is capped by
+  // that one serial walk however many threads join in. f and op are
+  // called concurrently and must not change the list's structure.
+  // threads = 0 uses every hardware thread; lists below two chunks are
+  // scanned on the calling thread. There is no thread pool: every call
+  // starts its threads and joins them before returning, which short scans
+  // do not win back. Without the index a range costs one more walk to count
+  // its nodes. The first exception thrown by f or op is rethrown once every
+  // thread has stopped.
+  static constexpr size_type kParallelGrain = 1 << 12;
+  static constexpr size_type kParallelIndexMin = kParallelGrain << 6;
+  template <typename F>
+  void parallel_for_each(F f, size_type threads = 0);
+  template <typename F>
+  void parallel_for_each(iterator first, iterator last, F f,
+                         size_type threads = 0);
+  // Each chunk folds its elements into a copy of init, calling
+  // op(acc, element); the chunk results are then folded in list order with
+  // op(acc, partial). op must be associative and init its identity, as 0
+  // is for a sum.
+  template <typename U, typename Op>
+  U parallel_reduce(U init, Op op, size_type threads = 0) const;
+  template <typename U, typename Op>
+  U parallel_reduce(const_iterator first, const_iterator last, U init, Op op,
+                    size_type threads = 0) const;
+  // Replaces every element x with f(x).
+  template <typename F>
+  void parallel_transform(F f, size_type threads = 0);
+  template <typename F>
+  void parallel_transform(iterator first, iterator last, F f,
+                          size_type threads = 0);
+
+  // Linear search and reductions. For arithmetic T the values are copied
+  // kSimdBatch nodes at a time into a buffer that the vector kernels of
+  // simd.h scan, so the walk is the only part left one node at a time;
+  // other types are compared in the walk itself. min_element() and
+  // max_element() pick the first smallest or largest element, as the std
+  // algorithms do, and end() for an empty list. sum() adds into T(); see
+  // simd.h for how a float sum rounds.
+  static constexpr size_type kSimdBatch = 64;
+  iterator find(const_reference value);
+  const_iterator find(const_reference value) const;
+  bool contains(const_reference value) const;
+  size_type count(const_reference value) const;
+  iterator min_element();
+  const_iterator min_element() const;
+  iterator max_element();
+  const_iterator max_element() const;
+  value_type sum() const;
+
   template <typename... Args>
   iterator emplace(const_iterator pos, Args &&...args);
   template <typename... Args>
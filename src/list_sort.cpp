@@ -0,0 +1,235 @@
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace m3mpm {
+namespace detail {
+
+template <typename T>
+void concat_chains(Chain<T> &a, Chain<T> &b) {
+  if (b.head_ == nullptr) return;
+  if (a.head_ == nullptr) {
+    a = b;
+  } else {
+    a.tail_->pNext_ = b.head_;
+    b.head_->pPrev_ = a.tail_;
+    a.tail_ = b.tail_;
+    a.size_ += b.size_;
+  }
+  b = Chain<T>();
+}
+
+template <typename T>
+void merge_chains(Chain<T> &a, Chain<T> &b, size_t &hops) {
+  if (b.head_ == nullptr) return;
+  if (a.head_ == nullptr) {
+    a = b;
+    b = Chain<T>();
+    return;
+  }
+  const size_t total = a.size_ + b.size_;
+  Chain<T> out;
+  Node<T> *last = nullptr;
+  M3MPM_TRY {
+    // Ties go to a, which keeps the merge stable. Consecutive nodes of one
+    // run are linked already, so links are only written where the merge
+    // switches runs.
+    while (a.head_ != nullptr && b.head_ != nullptr) {
+      Node<T> *&from = b.head_->data_ < a.head_->data_ ? b.head_ : a.head_;
+      Node<T> *node = from;
+      from = node->pNext_;
+      if (last == nullptr) {
+        out.head_ = node;
+        node->pPrev_ = nullptr;
+      } else if (last->pNext_ != node) {
+        last->pNext_ = node;
+        node->pPrev_ = last;
+      }
+      last = node;
+    }
+  } M3MPM_CATCH_ALL {
+    if (last != nullptr) {
+      last->pNext_ = nullptr;
+      out.tail_ = last;
+    }
+    concat_chains(out, a);
+    concat_chains(out, b);
+    out.size_ = total;
+    a = out;
+    M3MPM_RETHROW;
+  }
+  hops += total;
+  Chain<T> &rest = a.head_ != nullptr ? a : b;
+  last->pNext_ = rest.head_;
+  rest.head_->pPrev_ = last;
+  out.tail_ = rest.tail_;
+  out.size_ = total;
+  a = out;
+  b = Chain<T>();
+}
+
+template <typename T>
+void sort_chain(Chain<T> &c, size_t &hops) {
+  if (c.size_ < 2) return;
+  // bins[i] is empty or a sorted run of 2^i nodes, a higher bin holding
+  // earlier nodes, as in the classic std::list::sort.
+  constexpr size_t kBins = 64;
+  Chain<T> bins[kBins];
+  Chain<T> carry;
+  Chain<T> rest = c;
+  size_t filled = 0;
+  M3MPM_TRY {
+    while (rest.head_ != nullptr) {
+      Node<T> *node = rest.head_;
+      rest.head_ = node->pNext_;
+      --rest.size_;
+      node->pNext_ = nullptr;
+      node->pPrev_ = nullptr;
+      carry = Chain<T>{node, node, 1};
+      size_t i = 0;
+      for (; bins[i].head_ != nullptr; ++i) {
+        merge_chains(bins[i], carry, hops);
+        carry = bins[i];
+        bins[i] = Chain<T>();
+      }
+      bins[i] = carry;
+      carry = Chain<T>();
+      if (i >= filled) filled = i + 1;
+    }
+    for (size_t i = 0; i < filled; ++i) {
+      merge_chains(bins[i], carry, hops);
+      carry = bins[i];
+      bins[i] = Chain<T>();
+    }
+  } M3MPM_CATCH_ALL {
+    for (size_t i = 0; i < filled; ++i) concat_chains(carry, bins[i]);
+    if (rest.head_ != nullptr) concat_chains(carry, rest);
+    c = carry;
+    M3MPM_RETHROW;
+  }
+  c = carry;
+}
+
+template <typename T>
+void split_chain(Chain<T> &c, const std::vector<const T *> &splitters,
+                 Chain<T> *pieces, size_t &hops) {
+  const size_t count = splitters.size() + 1;
+  for (size_t j = 0; j < count; ++j) pieces[j] = Chain<T>();
+  // Walk first and cut afterwards, so that a throwing comparison leaves c
+  // whole.
+  std::vector<Node<T> *> first(count, nullptr);
+  std::vector<Node<T> *> before(count, nullptr);
+  std::vector<size_t> sizes(count, 0);
+  size_t piece = 0;
+  Node<T> *prev = nullptr;
+  for (Node<T> *node = c.head_; node != nullptr; node = node->pNext_) {
+    while (piece + 1 < count && !(node->data_ < *splitters[piece])) ++piece;
+    if (first[piece] == nullptr) {
+      first[piece] = node;
+      before[piece] = prev;
+    }
+    ++sizes[piece];
+    prev = node;
+  }
+  hops += c.size_;
+  Node<T> *tail = c.tail_;
+  for (size_t j = count; j-- > 0;) {
+    if (first[j] == nullptr) continue;
+    pieces[j] = Chain<T>{first[j], tail, sizes[j]};
+    first[j]->pPrev_ = nullptr;
+    tail = before[j];
+    if (tail != nullptr) tail->pNext_ = nullptr;
+  }
+  c = Chain<T>();
+}
+
+template <typename K>
+auto radix_bits(K key) {
+  static_assert(std::is_arithmetic_v<K>,
+                "radix sort needs an integral or floating-point key");
+  if constexpr (std::is_same_v<K, bool>) {
+    return static_cast<uint8_t>(key);
+  } else if constexpr (std::is_floating_point_v<K>) {
+    static_assert(sizeof(K) == 4 || sizeof(K) == 8,
+                  "radix sort supports float and double keys only");
+    using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+    constexpr U kSign = U(1) << (8 * sizeof(U) - 1);
+    U bits;
+    memcpy(&bits, &key, sizeof(bits));
+    return (bits & kSign) ? static_cast<U>(~bits) : bits | kSign;
+  } else {
+    using U = std::make_unsigned_t<K>;
+    U bits = static_cast<U>(key);
+    if constexpr (std::is_signed_v<K>) {
+      bits ^= U(1) << (8 * sizeof(U) - 1);
+    }
+    return bits;
+  }
+}
+
+template <typename T, typename Key>
+void radix_sort_chain(Chain<T> &c, Key &key, size_t &hops) {
+  const size_t n = c.size_;
+  if (n < 2) return;
+  using Bits = decltype(radix_bits(key(c.head_->data_)));
+  struct Entry {
+    Bits bits;
+    Node<T> *node;
+  };
+  constexpr size_t kDigits = sizeof(Bits);
+  std::unique_ptr<Entry[]> entries(new Entry[n]);
+  std::unique_ptr<Entry[]> scratch(new Entry[n]);
+
+  // The one walk that calls key also counts every byte of every key.
+  size_t counts[kDigits][kRadixBuckets] = {};
+  size_t i = 0;
+  for (Node<T> *node = c.head_; node != nullptr; node = node->pNext_, ++i) {
+    Bits bits = static_cast<Bits>(radix_bits(key(node->data_)));
+    entries[i] = Entry{bits, node};
+    for (size_t digit = 0; digit < kDigits; ++digit) {
+      ++counts[digit][(bits >> (8 * digit)) & 0xff];
+    }
+  }
+  hops += n;
+
+  Entry *from = entries.get();
+  Entry *to = scratch.get();
+  for (size_t digit = 0; digit < kDigits; ++digit) {
+    const size_t shift = 8 * digit;
+    size_t *count = counts[digit];
+    // A byte shared by every key would leave the order as it is.
+    if (count[(from[0].bits >> shift) & 0xff] == n) continue;
+    size_t offsets[kRadixBuckets];
+    size_t offset = 0;
+    for (size_t b = 0; b < kRadixBuckets; ++b) {
+      offsets[b] = offset;
+      offset += count[b];
+    }
+    for (size_t j = 0; j < n; ++j) {
+      to[offsets[(from[j].bits >> shift) & 0xff]++] = from[j];
+    }
+    std::swap(from, to);
+  }
+
+  // The nodes are relinked in sorted order, their addresses prefetched a
+  // few entries ahead since they are scattered over the heap.
+  constexpr size_t kAhead = 16;
+  Node<T> *prev = nullptr;
+  for (size_t j = 0; j < n; ++j) {
+    if (j + kAhead < n) __builtin_prefetch(from[j + kAhead].node);
+    Node<T> *node = from[j].node;
+    node->pPrev_ = prev;
+    if (prev != nullptr) prev->pNext_ = node;
+    prev = node;
+  }
+  prev->pNext_ = nullptr;
+  c.head_ = from[0].node;
+  c.tail_ = prev;
+  hops += n;
+}
+
+}  // namespace detail
+}  // namespace m3mpm
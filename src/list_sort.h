@@ -0,0 +1,64 @@
+#ifndef SRC_M3MPM_LIST_SORT_H_
+#define SRC_M3MPM_LIST_SORT_H_
+#include <stddef.h>
+
+#include <vector>
+
+#include "config.h"
+#include "node.h"
+
+namespace m3mpm {
+namespace detail {
+// A run of nodes linked through pNext_ and ended by nullptr. The sorting
+// steps below keep pPrev_ right inside the runs they build, so a sorted
+// run can be put back in a list without another pass.
+template <typename T>
+struct Chain {
+  Node<T> *head_ = nullptr;
+  Node<T> *tail_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Appends b to a and leaves b empty.
+template <typename T>
+void concat_chains(Chain<T> &a, Chain<T> &b);
+
+// Stable merge of two sorted runs into a; b is left empty. If a comparison
+// throws, a still holds every node of both runs, in no particular order.
+// hops counts the nodes placed.
+template <typename T>
+void merge_chains(Chain<T> &a, Chain<T> &b, size_t &hops);
+
+// Stable bottom-up merge sort of a run by relinking, O(n log n) and without
+// moving any element. A throwing comparison leaves every node in c.
+template <typename T>
+void sort_chain(Chain<T> &c, size_t &hops);
+
+// Cuts a sorted run into splitters.size() + 1 pieces: piece j takes the
+// elements not less than splitter j - 1 and less than splitter j. Nothing
+// is cut when a comparison throws.
+template <typename T>
+void split_chain(Chain<T> &c, const std::vector<const T *> &splitters,
+                 Chain<T> *pieces, size_t &hops);
+
+// The bits of an integral or floating-point key as an unsigned integer of
+// the same size that orders as the key does. Floats flip the sign bit of
+// positive values and every bit of negative ones, so -0.0 comes before
+// +0.0 and NaNs go to the end of their sign.
+template <typename K>
+auto radix_bits(K key);
+
+// Stable LSD radix sort of a run, keyed by key(element). One walk copies
+// each node's key bits and address into an array and counts every key
+// byte; each byte that differs between keys is then a counting-sort pass
+// over the array, the least significant first, and a last walk relinks
+// the nodes in sorted order. The passes run over contiguous memory rather
+// than chasing the links again. key is only called in the first walk, and
+// if it throws, c is left as it was.
+inline constexpr size_t kRadixBuckets = 256;
+template <typename T, typename Key>
+void radix_sort_chain(Chain<T> &c, Key &key, size_t &hops);
+}  // namespace detail
+}  // namespace m3mpm
+#include "list_sort.cpp"
+#endif  // SRC_M3MPM_LIST_SORT_H_
@@ -0,0 +1,67 @@
+#ifndef SRC_M3MPM_MEMORY_USAGE_H_
+#define SRC_M3MPM_MEMORY_USAGE_H_
+#include <stddef.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace m3mpm {
+namespace detail {
+// Bytes that a glibc-style malloc (and so operator new) takes for a request
+// of the given size: the request plus one size word of chunk header,
+// rounded up to two words, and never less than four words. Other mallocs
+// round in steps of the same order.
+constexpr size_t heap_allocation_size(size_t bytes) {
+  constexpr size_t kWord = sizeof(size_t);
+  size_t chunk = (bytes + kWord + 2 * kWord - 1) & ~(2 * kWord - 1);
+  return chunk < 4 * kWord ? 4 * kWord : chunk;
+}
+
+// An allocator reports its own rounding through a static
+// allocation_size(n); any other one is taken to sit on operator new.
+template <typename Alloc, typename = void>
+struct reports_allocation_size : std::false_type {};
+template <typename Alloc>
+struct reports_allocation_size<
+    Alloc, std::void_t<decltype(Alloc::allocation_size(size_t()))>>
+    : std::true_type {};
+
+template <typename Alloc>
+size_t allocation_size(size_t n) {
+  if constexpr (reports_allocation_size<Alloc>::value) {
+    return Alloc::allocation_size(n);
+  } else {
+    return heap_allocation_size(n * sizeof(typename Alloc::value_type));
+  }
+}
+
+template <typename T, typename = void>
+struct has_deep_memory_usage : std::false_type {};
+template <typename T>
+struct has_deep_memory_usage<
+    T, std::void_t<decltype(std::declval<const T &>().memory_usage(true))>>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct has_memory_usage : has_deep_memory_usage<T> {};
+template <typename T>
+struct has_memory_usage<
+    T, std::void_t<decltype(std::declval<const T &>().memory_usage())>>
+    : std::true_type {};
+
+// What an element holds beyond its own sizeof(T), which the node holding it
+// already accounts for.
+template <typename T>
+size_t element_memory_usage(const T &item) {
+  size_t bytes;
+  if constexpr (has_deep_memory_usage<T>::value) {
+    bytes = item.memory_usage(true);
+  } else {
+    bytes = item.memory_usage();
+  }
+  return bytes > sizeof(T) ? bytes - sizeof(T) : 0;
+}
+}  // namespace detail
+}  // namespace m3mpm
+
+#endif  // SRC_M3MPM_MEMORY_USAGE_H_
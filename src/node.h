@@ -1,5 +1,7 @@
 #ifndef SRC_M3MPM_NODE_H_
 #define SRC_M3MPM_NODE_H_
+#include <utility>
+
 namespace m3mpm {
 template <typename T>
 class Node {
@@ -8,7 +10,10 @@ class Node {
   Node *pNext_;
   Node *pPrev_;
   Node(): data_(), pNext_(nullptr), pPrev_(nullptr) {}
-  explicit Node(const T &data) : Node() {data_ = data;}
+  explicit Node(const T &data)
+      : data_(data), pNext_(nullptr), pPrev_(nullptr) {}
+  explicit Node(T &&data)
+      : data_(std::move(data)), pNext_(nullptr), pPrev_(nullptr) {}
 };
 }  // namespace m3mpm
 #endif  // SRC_M3MPM_NODE_H_
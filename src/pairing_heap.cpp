@@ -0,0 +1,308 @@
+#include <utility>
+#include <vector>
+
+namespace m3mpm {
+
+template <typename T, typename Compare, typename Alloc>
+template <typename... Args>
+typename PairingHeap<T, Compare, Alloc>::HeapNode *
+PairingHeap<T, Compare, Alloc>::create_node(Args &&...args) {
+  node_allocator alloc;
+  HeapNode *node = node_traits::allocate(alloc, 1);
+  M3MPM_TRY {
+    node_traits::construct(alloc, node, std::forward<Args>(args)...);
+  } M3MPM_CATCH_ALL {
+    node_traits::deallocate(alloc, node, 1);
+    M3MPM_RETHROW;
+  }
+  return node;
+}
+
+template <typename T, typename Compare, typename Alloc>
+void PairingHeap<T, Compare, Alloc>::destroy_node(HeapNode *node) {
+  node_allocator alloc;
+  node_traits::destroy(alloc, node);
+  node_traits::deallocate(alloc, node, 1);
+}
+
+template <typename T, typename Compare, typename Alloc>
+PairingHeap<T, Compare, Alloc>::PairingHeap(const Compare &comp)
+    : root_(nullptr), size_(0), comp_(comp) {}
+
+template <typename T, typename Compare, typename Alloc>
+PairingHeap<T, Compare, Alloc>::PairingHeap(
+    std::initializer_list<value_type> const &items, const Compare &comp)
+    : PairingHeap(comp) {
+  M3MPM_TRY {
+    for (auto &value : items) push(value);
+  } M3MPM_CATCH_ALL {
+    clear();
+    M3MPM_RETHROW;
+  }
+}
+
+template <typename T, typename Compare, typename Alloc>
+PairingHeap<T, Compare, Alloc>::PairingHeap(const PairingHeap &h)
+    : PairingHeap(h.comp_) {
+  append_all(h);
+}
+
+template <typename T, typename Compare, typename Alloc>
+PairingHeap<T, Compare, Alloc>::PairingHeap(PairingHeap &&h) noexcept
+    : root_(h.root_), size_(h.size_), comp_(h.comp_) {
+  h.root_ = nullptr;
+  h.size_ = 0;
+}
+
+template <typename T, typename Compare, typename Alloc>
+PairingHeap<T, Compare, Alloc> &PairingHeap<T, Compare, Alloc>::operator=(
+    const PairingHeap &h) {
+  if (this != &h) {
+    PairingHeap copy(h);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare, typename Alloc>
+PairingHeap<T, Compare, Alloc> &PairingHeap<T, Compare, Alloc>::operator=(
+    PairingHeap &&h) noexcept {
+  if (this != &h) {
+    clear();
+    swap(h);
+  }
+  return *this;
+}
+
+// The copy gets the same elements, not the same shape: each one is pushed
+// again, which is O(1) apiece.
+template <typename T, typename Compare, typename Alloc>
+void PairingHeap<T, Compare, Alloc>::append_all(const PairingHeap &h) {
+  if (!h.root_) return;
+  std::vector<const HeapNode *> pending(1, h.root_);
+  M3MPM_TRY {
+    while (!pending.empty()) {
+      const HeapNode *node = pending.back();
+      pending.pop_back();
+      push(node->value_);
+      for (const HeapNode *c = node->child_; c; c = c->next_) {
+        pending.push_back(c);
+      }
+    }
+  } M3MPM_CATCH_ALL {
+    clear();
+    M3MPM_RETHROW;
+  }
+}
+
+template <typename T, typename Compare, typename Alloc>
+void PairingHeap<T, Compare, Alloc>::clear() {
+  // Walks the tree without a stack: a node's children are spliced in
+  // front of its remaining siblings before the node is freed.
+  HeapNode *node = root_;
+  while (node) {
+    HeapNode *next = node->next_;
+    if (HeapNode *child = node->child_) {
+      HeapNode *last = child;
+      while (last->next_) last = last->next_;
+      last->next_ = next;
+      next = child;
+    }
+    destroy_node(node);
+    node = next;
+  }
+  root_ = nullptr;
+  size_ = 0;
+}
+
+template <typename T, typename Compare, typename Alloc>
+void PairingHeap<T, Compare, Alloc>::swap(PairingHeap &other) noexcept {
+  using std::swap;
+  swap(root_, other.root_);
+  swap(size_, other.size_);
+  swap(comp_, other.comp_);
+}
+
+template <typename T, typename Compare, typename Alloc>
+void PairingHeap<T, Compare, Alloc>::merge(PairingHeap &other) {
+  if (this == &other || !other.root_) return;
+  root_ = root_ ? meld(root_, other.root_) : other.root_;
+  size_ += other.size_;
+  other.root_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename T, typename Compare, typename Alloc>
+typename PairingHeap<T, Compare, Alloc>::const_reference
+PairingHeap<T, Compare, Alloc>::top() const {
+  if (!root_) M3MPM_THROW(std::logic_error("PairingHeap is empty"));
+  return root_->value_;
+}
+
+template <typename T, typename Compare, typename Alloc>
+typename PairingHeap<T, Compare, Alloc>::handle
+PairingHeap<T, Compare, Alloc>::push(const_reference value) {
+  return insert(create_node(value));
+}
+
+template <typename T, typename Compare, typename Alloc>
+typename PairingHeap<T, Compare, Alloc>::handle
+PairingHeap<T, Compare, Alloc>::push(value_type &&value) {
+  return insert(create_node(std::move(value)));
+}
+
+template <typename T, typename Compare, typename Alloc>
+template <typename... Args>
+typename PairingHeap<T, Compare, Alloc>::handle
+PairingHeap<T, Compare, Alloc>::emplace(Args &&...args) {
+  return insert(create_node(std::forward<Args>(args)...));
+}
+
+template <typename T, typename Compare, typename Alloc>
+typename PairingHeap<T, Compare, Alloc>::handle
+PairingHeap<T, Compare, Alloc>::insert(HeapNode *node) {
+  root_ = root_ ? meld(root_, node) : node;
+  ++size_;
+  return handle(node);
+}
+
+template <typename T, typename Compare, typename Alloc>
+void PairingHeap<T, Compare, Alloc>::pop() {
+  if (!root_) M3MPM_THROW(std::logic_error("PairingHeap is empty"));
+  HeapNode *old = root_;
+  root_ = merge_pairs(old->child_);
+  --size_;
+  destroy_node(old);
+}
+
+template <typename T, typename Compare, typename Alloc>
+void PairingHeap<T, Compare, Alloc>::decrease_key(handle h,
+                                                  const_reference value) {
+  if (comp_(value, h.node_->value_)) {
+    M3MPM_THROW(std::invalid_argument(
+        "error decrease_key(): the new value ranks below the old one"));
+  }
+  h.node_->value_ = value;
+  raise(h.node_);
+}
+
+template <typename T, typename Compare, typename Alloc>
+void PairingHeap<T, Compare, Alloc>::decrease_key(handle h,
+                                                  value_type &&value) {
+  if (comp_(value, h.node_->value_)) {
+    M3MPM_THROW(std::invalid_argument(
+        "error decrease_key(): the new value ranks below the old one"));
+  }
+  h.node_->value_ = std::move(value);
+  raise(h.node_);
+}
+
+// A node that moved up may now outrank its parent, so its subtree is cut
+// off and melded with the root; the subtree itself is still in order.
+template <typename T, typename Compare, typename Alloc>
+void PairingHeap<T, Compare, Alloc>::raise(HeapNode *node) {
+  if (node == root_) return;
+  detach(node);
+  root_ = meld(root_, node);
+}
+
+template <typename T, typename Compare, typename Alloc>
+void PairingHeap<T, Compare, Alloc>::erase(handle h) {
+  HeapNode *node = h.node_;
+  if (node == root_) {
+    pop();
+    return;
+  }
+  detach(node);
+  if (HeapNode *rest = merge_pairs(node->child_)) root_ = meld(root_, rest);
+  --size_;
+  destroy_node(node);
+}
+
+template <typename T, typename Compare, typename Alloc>
+typename PairingHeap<T, Compare, Alloc>::HeapNode *
+PairingHeap<T, Compare, Alloc>::meld(HeapNode *a, HeapNode *b) {
+  if (comp_(a->value_, b->value_)) std::swap(a, b);
+  b->prev_ = a;
+  b->next_ = a->child_;
+  if (a->child_) a->child_->prev_ = b;
+  a->child_ = b;
+  return a;
+}
+
+template <typename T, typename Compare, typename Alloc>
+typename PairingHeap<T, Compare, Alloc>::HeapNode *
+PairingHeap<T, Compare, Alloc>::merge_pairs(HeapNode *first) {
+  if (!first) return nullptr;
+  // First pass: meld the siblings two by two, stacking the results
+  // through next_ so that the last pair ends up on top.
+  HeapNode *pairs = nullptr;
+  while (first) {
+    HeapNode *a = first;
+    HeapNode *b = a->next_;
+    first = b ? b->next_ : nullptr;
+    a->next_ = a->prev_ = nullptr;
+    if (b) {
+      b->next_ = b->prev_ = nullptr;
+      a = meld(a, b);
+    }
+    a->next_ = pairs;
+    pairs = a;
+  }
+  // Second pass: fold the pairs into one tree from the right.
+  HeapNode *result = pairs;
+  pairs = pairs->next_;
+  result->next_ = nullptr;
+  while (pairs) {
+    HeapNode *next = pairs->next_;
+    pairs->next_ = nullptr;
+    result = meld(result, pairs);
+    pairs = next;
+  }
+  return result;
+}
+
+template <typename T, typename Compare, typename Alloc>
+void PairingHeap<T, Compare, Alloc>::detach(HeapNode *node) {
+  if (node->prev_->child_ == node) {
+    node->prev_->child_ = node->next_;
+  } else {
+    node->prev_->next_ = node->next_;
+  }
+  if (node->next_) node->next_->prev_ = node->prev_;
+  node->next_ = node->prev_ = nullptr;
+}
+
+template <typename T, typename Compare, typename Alloc>
+const typename PairingHeap<T, Compare, Alloc>::value_type *
+PairingHeap<T, Compare, Alloc>::try_top() const {
+  return root_ ? &root_->value_ : nullptr;
+}
+
+template <typename T, typename Compare, typename Alloc>
+template <typename Out>
+void PairingHeap<T, Compare, Alloc>::take_top(Out &out) {
+  out = std::move(root_->value_);
+  HeapNode *old = root_;
+  root_ = merge_pairs(old->child_);
+  --size_;
+  destroy_node(old);
+}
+
+template <typename T, typename Compare, typename Alloc>
+bool PairingHeap<T, Compare, Alloc>::try_pop(value_type &out) {
+  if (!root_) return false;
+  take_top(out);
+  return true;
+}
+
+template <typename T, typename Compare, typename Alloc>
+std::optional<typename PairingHeap<T, Compare, Alloc>::value_type>
+PairingHeap<T, Compare, Alloc>::try_pop() {
+  if (!root_) return std::nullopt;
+  std::optional<value_type> out;
+  take_top(out);
+  return out;
+}
+
+}  // namespace m3mpm
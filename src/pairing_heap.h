@@ -0,0 +1,132 @@
+#ifndef SRC_M3MPM_PAIRING_HEAP_H_
+#define SRC_M3MPM_PAIRING_HEAP_H_
+#include <stddef.h>
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+#include "config.h"
+
+namespace m3mpm {
+// Priority queue kept as a pairing heap: a tree of nodes in which every
+// parent ranks at least as high under Compare as its children, so top() is
+// the greatest element, as in PriorityQueue. push() returns a handle to
+// the new element that stays valid until the element is popped or erased;
+// through it the element can be read, moved towards the top with
+// decrease_key() or removed with erase(). push(), decrease_key() and
+// merge() take O(1) time and pop() and erase() O(log n) amortized.
+// Alloc follows the LSQContainer rules: it must be stateless.
+template <typename T, typename Compare = std::less<T>,
+          typename Alloc = std::allocator<T>>
+class PairingHeap {
+ private:
+  struct HeapNode;
+
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using value_compare = Compare;
+  using allocator_type = Alloc;
+
+  class handle {
+   public:
+    handle() : node_(nullptr) {}
+    bool operator==(const handle &other) const { return node_ == other.node_; }
+    bool operator!=(const handle &other) const { return node_ != other.node_; }
+
+   private:
+    friend class PairingHeap;
+    explicit handle(HeapNode *node) : node_(node) {}
+    HeapNode *node_;
+  };
+
+ public:
+  PairingHeap() : PairingHeap(Compare()) {}
+  explicit PairingHeap(const Compare &comp);
+  explicit PairingHeap(std::initializer_list<value_type> const &items,
+                       const Compare &comp = Compare());
+  PairingHeap(const PairingHeap &h);
+  PairingHeap(PairingHeap &&h) noexcept;
+  ~PairingHeap() { clear(); }
+  PairingHeap &operator=(const PairingHeap &h);
+  PairingHeap &operator=(PairingHeap &&h) noexcept;
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+
+  const_reference top() const;
+  handle push(const_reference value);
+  handle push(value_type &&value);
+  template <typename... Args>
+  handle emplace(Args &&...args);
+  void pop();
+  void clear();
+  void swap(PairingHeap &other) noexcept;
+  // Moves every element of other into this heap without copying them;
+  // handles into other stay valid and now refer to this heap.
+  void merge(PairingHeap &other);
+
+  // The element behind h, which must come from this heap.
+  const_reference get(handle h) const { return h.node_->value_; }
+  // Replaces the element behind h with value, which must not rank below
+  // it; throws std::invalid_argument otherwise. With std::greater, as in
+  // Dijkstra's algorithm, this lowers the key.
+  void decrease_key(handle h, const_reference value);
+  void decrease_key(handle h, value_type &&value);
+  void erase(handle h);
+
+  const value_type *try_top() const;
+  bool try_pop(value_type &out);
+  std::optional<value_type> try_pop();
+
+ private:
+  using node_allocator =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<HeapNode>;
+  using node_traits = std::allocator_traits<node_allocator>;
+  static_assert(node_traits::is_always_equal::value,
+                "PairingHeap: Alloc must be a stateless allocator");
+
+  struct HeapNode {
+    // child_ is the leftmost child and next_ the sibling to the right;
+    // prev_ is the sibling to the left, or the parent for a leftmost child.
+    HeapNode *child_;
+    HeapNode *next_;
+    HeapNode *prev_;
+    T value_;
+
+    template <typename... Args>
+    explicit HeapNode(Args &&...args)
+        : child_(nullptr),
+          next_(nullptr),
+          prev_(nullptr),
+          value_(std::forward<Args>(args)...) {}
+  };
+
+  HeapNode *root_;
+  size_type size_;
+  Compare comp_;
+
+  template <typename... Args>
+  static HeapNode *create_node(Args &&...args);
+  static void destroy_node(HeapNode *node);
+  handle insert(HeapNode *node);
+  // Links two detached trees, the lower-ranked root becoming the leftmost
+  // child of the other, and returns the new root.
+  HeapNode *meld(HeapNode *a, HeapNode *b);
+  // Melds a list of siblings into one tree: pairs from the left, then
+  // folds the pairs from the right.
+  HeapNode *merge_pairs(HeapNode *first);
+  // Unlinks a non-root node, with its subtree, from its parent.
+  static void detach(HeapNode *node);
+  void raise(HeapNode *node);
+  template <typename Out>
+  void take_top(Out &out);
+  void append_all(const PairingHeap &h);
+};
+}  // namespace m3mpm
+#include "pairing_heap.cpp"
+#endif  // SRC_M3MPM_PAIRING_HEAP_H_
@@ -0,0 +1,50 @@
+#include <thread>
+
+namespace m3mpm {
+namespace detail {
+
+inline size_t thread_count(size_t threads) {
+  if (threads != 0) return threads;
+  size_t hardware = std::thread::hardware_concurrency();
+  return hardware != 0 ? hardware : 1;
+}
+
+template <typename F>
+void run_tasks(size_t n, F task, std::vector<std::exception_ptr> &errors) {
+  auto guarded = [&task, &errors](size_t i) {
+    M3MPM_TRY {
+      task(i);
+    } M3MPM_CATCH_ALL {
+      errors[i] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  M3MPM_TRY {
+    threads.reserve(n);
+  } M3MPM_CATCH_ALL {
+  }
+  size_t started = 1;
+  for (; started < n && threads.size() < threads.capacity(); ++started) {
+    M3MPM_TRY {
+      threads.emplace_back(guarded, started);
+    } M3MPM_CATCH_ALL {
+      break;
+    }
+  }
+  guarded(0);
+  for (size_t i = started; i < n; ++i) guarded(i);
+  for (auto &thread : threads) thread.join();
+}
+
+inline void rethrow_first(const std::vector<std::exception_ptr> &errors) {
+#if M3MPM_HAS_EXCEPTIONS
+  for (auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+#else
+  (void)errors;
+#endif
+}
+
+}  // namespace detail
+}  // namespace m3mpm
@@ -0,0 +1,27 @@
+#ifndef SRC_M3MPM_PARALLEL_H_
+#define SRC_M3MPM_PARALLEL_H_
+#include <stddef.h>
+
+#include <exception>
+#include <vector>
+
+#include "config.h"
+
+namespace m3mpm {
+namespace detail {
+// threads, or every hardware thread for 0; never less than one.
+size_t thread_count(size_t threads);
+
+// Runs task(0) .. task(n - 1), task(0) on the calling thread and the others
+// on threads of their own, or inline when no thread can be started. The
+// threads are started and joined on every call; nothing is pooled. The
+// first exception a task throws is stored in errors[i].
+template <typename F>
+void run_tasks(size_t n, F task, std::vector<std::exception_ptr> &errors);
+
+// Rethrows the first stored exception, if any.
+void rethrow_first(const std::vector<std::exception_ptr> &errors);
+}  // namespace detail
+}  // namespace m3mpm
+#include "parallel.cpp"
+#endif  // SRC_M3MPM_PARALLEL_H_
@@ -0,0 +1,137 @@
+#include <utility>
+
+namespace m3mpm {
+
+template <typename T, typename Compare, size_t Arity>
+PriorityQueue<T, Compare, Arity>::PriorityQueue(
+    std::initializer_list<value_type> const &items, const Compare &comp)
+    : items_(items), comp_(comp) {
+  for (size_type pos = items_.size() / Arity + 1; pos-- > 0;) {
+    if (pos < items_.size()) sift_down(pos);
+  }
+}
+
+template <typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::swap(PriorityQueue &other) noexcept {
+  using std::swap;
+  items_.swap(other.items_);
+  swap(comp_, other.comp_);
+}
+
+template <typename T, typename Compare, size_t Arity>
+typename PriorityQueue<T, Compare, Arity>::const_reference
+PriorityQueue<T, Compare, Arity>::top() const {
+  if (items_.empty()) M3MPM_THROW(std::logic_error("PriorityQueue is empty"));
+  return items_.front();
+}
+
+template <typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::push(const_reference value) {
+  items_.push_back(value);
+  sift_up(items_.size() - 1);
+}
+
+template <typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::push(value_type &&value) {
+  items_.push_back(std::move(value));
+  sift_up(items_.size() - 1);
+}
+
+template <typename T, typename Compare, size_t Arity>
+template <typename... Args>
+void PriorityQueue<T, Compare, Arity>::emplace(Args &&...args) {
+  items_.emplace_back(std::forward<Args>(args)...);
+  sift_up(items_.size() - 1);
+}
+
+template <typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::pop() {
+  if (items_.empty()) M3MPM_THROW(std::logic_error("PriorityQueue is empty"));
+  drop_top();
+}
+
+// The element moved up from the back almost always belongs near the
+// leaves again, so the hole left by the root is first walked all the way
+// down along the best children, without comparing against it, and the
+// element then sifts up from there: about half the comparisons of a
+// plain sift-down.
+template <typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::drop_top() {
+  const size_type n = items_.size() - 1;
+  if (n == 0) {
+    items_.pop_back();
+    return;
+  }
+  size_type pos = 0;
+  for (;;) {
+    size_type first = pos * Arity + 1;
+    if (first >= n) break;
+    size_type last = first + Arity < n ? first + Arity : n;
+    size_type best = first;
+    for (size_type child = first + 1; child < last; ++child) {
+      if (comp_(items_[best], items_[child])) best = child;
+    }
+    items_[pos] = std::move(items_[best]);
+    pos = best;
+  }
+  items_[pos] = std::move(items_[n]);
+  items_.pop_back();
+  sift_up(pos);
+}
+
+template <typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::sift_up(size_type pos) {
+  if (pos == 0) return;
+  T value = std::move(items_[pos]);
+  while (pos > 0) {
+    size_type parent = (pos - 1) / Arity;
+    if (!comp_(items_[parent], value)) break;
+    items_[pos] = std::move(items_[parent]);
+    pos = parent;
+  }
+  items_[pos] = std::move(value);
+}
+
+template <typename T, typename Compare, size_t Arity>
+void PriorityQueue<T, Compare, Arity>::sift_down(size_type pos) {
+  const size_type n = items_.size();
+  T value = std::move(items_[pos]);
+  for (;;) {
+    size_type first = pos * Arity + 1;
+    if (first >= n) break;
+    size_type last = first + Arity < n ? first + Arity : n;
+    size_type best = first;
+    for (size_type child = first + 1; child < last; ++child) {
+      if (comp_(items_[best], items_[child])) best = child;
+    }
+    if (!comp_(value, items_[best])) break;
+    items_[pos] = std::move(items_[best]);
+    pos = best;
+  }
+  items_[pos] = std::move(value);
+}
+
+template <typename T, typename Compare, size_t Arity>
+const typename PriorityQueue<T, Compare, Arity>::value_type *
+PriorityQueue<T, Compare, Arity>::try_top() const {
+  return items_.empty() ? nullptr : items_.data();
+}
+
+template <typename T, typename Compare, size_t Arity>
+bool PriorityQueue<T, Compare, Arity>::try_pop(value_type &out) {
+  if (items_.empty()) return false;
+  out = std::move(items_.front());
+  drop_top();
+  return true;
+}
+
+template <typename T, typename Compare, size_t Arity>
+std::optional<typename PriorityQueue<T, Compare, Arity>::value_type>
+PriorityQueue<T, Compare, Arity>::try_pop() {
+  if (items_.empty()) return std::nullopt;
+  std::optional<value_type> out(std::move(items_.front()));
+  drop_top();
+  return out;
+}
+
+}  // namespace m3mpm
@@ -0,0 +1,67 @@
+#ifndef SRC_M3MPM_PRIORITY_QUEUE_H_
+#define SRC_M3MPM_PRIORITY_QUEUE_H_
+#include <stddef.h>
+
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "config.h"
+
+namespace m3mpm {
+// Priority queue with the Queue surface kept as an implicit Arity-ary heap
+// in one array. As with std::priority_queue, top() is the greatest element
+// under Compare, so std::greater<T> makes it a min-queue. push() and pop()
+// take O(log n) moves; a wider heap is shallower, which makes push
+// cheaper and the sift-down in pop() look at more children per level but
+// within one or two cache lines. Equal elements come out in no particular
+// order.
+template <typename T, typename Compare = std::less<T>, size_t Arity = 4>
+class PriorityQueue {
+  static_assert(Arity >= 2, "PriorityQueue: Arity must be at least 2");
+
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using value_compare = Compare;
+
+  PriorityQueue() : PriorityQueue(Compare()) {}
+  explicit PriorityQueue(const Compare &comp) : comp_(comp) {}
+  // Builds the heap from items in O(n).
+  explicit PriorityQueue(std::initializer_list<value_type> const &items,
+                         const Compare &comp = Compare());
+
+  bool empty() const { return items_.empty(); }
+  size_type size() const { return items_.size(); }
+  void reserve(size_type n) { items_.reserve(n); }
+
+  const_reference top() const;
+  void push(const_reference value);
+  void push(value_type &&value);
+  template <typename... Args>
+  void emplace(Args &&...args);
+  void pop();
+  void clear() { items_.clear(); }
+  void swap(PriorityQueue &other) noexcept;
+
+  const value_type *try_top() const;
+  bool try_pop(value_type &out);
+  std::optional<value_type> try_pop();
+
+ private:
+  std::vector<T> items_;
+  Compare comp_;
+
+  // Moves the element at pos towards the root or the leaves until the heap
+  // order holds again, shifting the others through a hole.
+  void sift_up(size_type pos);
+  void sift_down(size_type pos);
+  // Removes the root after its value has been moved out.
+  void drop_top();
+};
+}  // namespace m3mpm
+#include "priority_queue.cpp"
+#endif  // SRC_M3MPM_PRIORITY_QUEUE_H_
@@ -1,20 +1,63 @@
 namespace m3mpm {
-template <typename T>
-typename Queue<T>::const_reference Queue<T>::front() {
+template <typename T, typename Alloc, typename Stats>
+typename Queue<T, Alloc, Stats>::const_reference
+Queue<T, Alloc, Stats>::front() {
+  if (this->empty()) M3MPM_THROW(std::logic_error("Queue is empty"));
   return this->head_->data_;
 }
 
-template <typename T>
-void Queue<T>::pop() {
-  if (this->empty()) throw std::logic_error("Queue is empty");
+template <typename T, typename Alloc, typename Stats>
+typename Queue<T, Alloc, Stats>::const_reference
+Queue<T, Alloc, Stats>::back() {
+  if (this->empty()) M3MPM_THROW(std::logic_error("Queue is empty"));
+  return this->tail_->data_;
+}
+
+template <typename T, typename Alloc, typename Stats>
+void Queue<T, Alloc, Stats>::pop() {
+  auto scope = this->op_scope(Op::kPop);
+  if (this->empty()) M3MPM_THROW(std::logic_error("Queue is empty"));
 
   if (this->head_ != nullptr) {
     Node<T> *tmp = this->head_;
     this->head_ = this->head_->pNext_;
-    delete tmp;
-    if (this->head_ != nullptr) this->head_->pPrev_ = nullptr;
+    this->destroy_node(tmp);
+    if (this->head_ != nullptr) {
+      this->head_->pPrev_ = nullptr;
+    } else {
+      this->tail_ = nullptr;
+    }
     this->size_--;
   }
 }
 
+template <typename T, typename Alloc, typename Stats>
+const typename Queue<T, Alloc, Stats>::value_type *
+Queue<T, Alloc, Stats>::try_front() const {
+  return this->size_ ? &this->head_->data_ : nullptr;
+}
+
+template <typename T, typename Alloc, typename Stats>
+const typename Queue<T, Alloc, Stats>::value_type *
+Queue<T, Alloc, Stats>::try_back() const {
+  return this->size_ ? &this->tail_->data_ : nullptr;
+}
+
+template <typename T, typename Alloc, typename Stats>
+bool Queue<T, Alloc, Stats>::try_pop(value_type &out) {
+  if (!this->size_) return false;
+  out = std::move(this->head_->data_);
+  pop();
+  return true;
+}
+
+template <typename T, typename Alloc, typename Stats>
+std::optional<typename Queue<T, Alloc, Stats>::value_type>
+Queue<T, Alloc, Stats>::try_pop() {
+  if (!this->size_) return std::nullopt;
+  std::optional<value_type> out(std::move(this->head_->data_));
+  pop();
+  return out;
+}
+
 }  // namespace m3mpm
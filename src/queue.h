@@ -4,24 +4,33 @@
 
 #include <initializer_list>
 #include <iostream>
+#include <optional>
 
 #include "stack.h"
 
 namespace m3mpm {
-template <typename T>
-class Queue : public LSQContainer<T> {
+template <typename T, typename Alloc = std::allocator<T>,
+          typename Stats = NoStats>
+class Queue : public LSQContainer<T, Alloc, Stats> {
  public:
   using value_type = T;
   using const_reference = const T &;
 
  public:
-  Queue() : LSQContainer<value_type>::LSQContainer() {}
+  Queue() : LSQContainer<value_type, Alloc, Stats>::LSQContainer() {}
   explicit Queue(const std::initializer_list<value_type> &items)
-      : LSQContainer<value_type>::LSQContainer(items) {}
+      : LSQContainer<value_type, Alloc, Stats>::LSQContainer(items) {}
 
   void pop();
   const_reference front();
-  const_reference back() { return LSQContainer<T>::tail_->data_; }
+  const_reference back();
+
+  // As the Stack ones: an empty queue gives null, false or an empty
+  // optional.
+  const value_type *try_front() const;
+  const value_type *try_back() const;
+  bool try_pop(value_type &out);
+  std::optional<value_type> try_pop();
 };
 }  // namespace m3mpm
 #include "queue.cpp"
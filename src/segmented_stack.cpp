@@ -0,0 +1,210 @@
+namespace m3mpm {
+
+template <typename T, typename Alloc>
+typename SegmentedStack<T, Alloc>::Chunk *
+SegmentedStack<T, Alloc>::create_chunk(size_type capacity, Chunk *prev) {
+  chunk_allocator chunk_alloc;
+  value_allocator value_alloc;
+  Chunk *chunk = chunk_traits::allocate(chunk_alloc, 1);
+  M3MPM_TRY {
+    chunk->data_ = value_traits::allocate(value_alloc, capacity);
+  } M3MPM_CATCH_ALL {
+    chunk_traits::deallocate(chunk_alloc, chunk, 1);
+    M3MPM_RETHROW;
+  }
+  chunk->prev_ = prev;
+  chunk->next_ = nullptr;
+  chunk->capacity_ = capacity;
+  return chunk;
+}
+
+template <typename T, typename Alloc>
+void SegmentedStack<T, Alloc>::destroy_chunk(Chunk *chunk) {
+  chunk_allocator chunk_alloc;
+  value_allocator value_alloc;
+  value_traits::deallocate(value_alloc, chunk->data_, chunk->capacity_);
+  chunk_traits::deallocate(chunk_alloc, chunk, 1);
+}
+
+template <typename T, typename Alloc>
+SegmentedStack<T, Alloc>::SegmentedStack(
+    const std::initializer_list<value_type> &items)
+    : SegmentedStack() {
+  for (auto &value : items) push(value);
+}
+
+template <typename T, typename Alloc>
+SegmentedStack<T, Alloc>::SegmentedStack(const SegmentedStack &s)
+    : SegmentedStack() {
+  M3MPM_TRY {
+    for (Chunk *chunk = s.bottom_; chunk; chunk = chunk->next_) {
+      const T *last =
+          chunk == s.top_ ? s.cur_ : chunk->data_ + chunk->capacity_;
+      for (const T *item = chunk->data_; item != last; ++item) push(*item);
+      if (chunk == s.top_) break;
+    }
+  } M3MPM_CATCH_ALL {
+    clear();
+    M3MPM_RETHROW;
+  }
+}
+
+template <typename T, typename Alloc>
+SegmentedStack<T, Alloc>::SegmentedStack(SegmentedStack &&s) noexcept
+    : SegmentedStack() {
+  swap(s);
+}
+
+template <typename T, typename Alloc>
+SegmentedStack<T, Alloc>::~SegmentedStack() {
+  clear();
+}
+
+template <typename T, typename Alloc>
+SegmentedStack<T, Alloc> &SegmentedStack<T, Alloc>::operator=(
+    const SegmentedStack &s) {
+  if (this != &s) {
+    SegmentedStack copy(s);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename T, typename Alloc>
+SegmentedStack<T, Alloc> &SegmentedStack<T, Alloc>::operator=(
+    SegmentedStack &&s) noexcept {
+  if (this != &s) {
+    clear();
+    swap(s);
+  }
+  return *this;
+}
+
+template <typename T, typename Alloc>
+void SegmentedStack<T, Alloc>::swap(SegmentedStack &other) noexcept {
+  std::swap(bottom_, other.bottom_);
+  std::swap(top_, other.top_);
+  std::swap(begin_, other.begin_);
+  std::swap(cur_, other.cur_);
+  std::swap(end_, other.end_);
+  std::swap(below_, other.below_);
+}
+
+template <typename T, typename Alloc>
+typename SegmentedStack<T, Alloc>::reference SegmentedStack<T, Alloc>::top() {
+  if (empty()) M3MPM_THROW(std::logic_error("SegmentedStack is empty"));
+  return cur_[-1];
+}
+
+template <typename T, typename Alloc>
+typename SegmentedStack<T, Alloc>::const_reference
+SegmentedStack<T, Alloc>::top() const {
+  if (empty()) M3MPM_THROW(std::logic_error("SegmentedStack is empty"));
+  return cur_[-1];
+}
+
+template <typename T, typename Alloc>
+void SegmentedStack<T, Alloc>::open_chunk() {
+  if (!top_) {
+    size_type capacity = kFirstChunkBytes / sizeof(T);
+    bottom_ = top_ = create_chunk(capacity ? capacity : 1, nullptr);
+  } else {
+    if (!top_->next_) {
+      size_type capacity = top_->capacity_;
+      if (capacity * sizeof(T) < kMaxChunkBytes) capacity *= 2;
+      top_->next_ = create_chunk(capacity, top_);
+    }
+    below_ += top_->capacity_;
+    top_ = top_->next_;
+  }
+  begin_ = cur_ = top_->data_;
+  end_ = begin_ + top_->capacity_;
+}
+
+template <typename T, typename Alloc>
+void SegmentedStack<T, Alloc>::step_down() {
+  if (top_->next_) {
+    destroy_chunk(top_->next_);
+    top_->next_ = nullptr;
+  }
+  top_ = top_->prev_;
+  below_ -= top_->capacity_;
+  begin_ = top_->data_;
+  cur_ = end_ = begin_ + top_->capacity_;
+}
+
+template <typename T, typename Alloc>
+void SegmentedStack<T, Alloc>::push(const_reference value) {
+  emplace(value);
+}
+
+template <typename T, typename Alloc>
+void SegmentedStack<T, Alloc>::push(value_type &&value) {
+  emplace(std::move(value));
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename SegmentedStack<T, Alloc>::reference SegmentedStack<T, Alloc>::emplace(
+    Args &&...args) {
+  if (cur_ == end_) open_chunk();
+  value_allocator alloc;
+  M3MPM_TRY {
+    value_traits::construct(alloc, cur_, std::forward<Args>(args)...);
+  } M3MPM_CATCH_ALL {
+    // A chunk just opened for the slot stays on as the spare.
+    if (cur_ == begin_ && top_->prev_) {
+      top_ = top_->prev_;
+      below_ -= top_->capacity_;
+      begin_ = top_->data_;
+      cur_ = end_ = begin_ + top_->capacity_;
+    }
+    M3MPM_RETHROW;
+  }
+  return *cur_++;
+}
+
+template <typename T, typename Alloc>
+void SegmentedStack<T, Alloc>::pop() {
+  if (empty()) M3MPM_THROW(std::logic_error("SegmentedStack is empty"));
+  value_allocator alloc;
+  value_traits::destroy(alloc, --cur_);
+  if (cur_ == begin_ && top_->prev_) step_down();
+}
+
+template <typename T, typename Alloc>
+void SegmentedStack<T, Alloc>::clear() {
+  while (!empty()) pop();
+  for (Chunk *chunk = bottom_; chunk;) {
+    Chunk *next = chunk->next_;
+    destroy_chunk(chunk);
+    chunk = next;
+  }
+  bottom_ = top_ = nullptr;
+  begin_ = cur_ = end_ = nullptr;
+}
+
+template <typename T, typename Alloc>
+const typename SegmentedStack<T, Alloc>::value_type *
+SegmentedStack<T, Alloc>::try_top() const {
+  return empty() ? nullptr : cur_ - 1;
+}
+
+template <typename T, typename Alloc>
+bool SegmentedStack<T, Alloc>::try_pop(value_type &out) {
+  if (empty()) return false;
+  out = std::move(cur_[-1]);
+  pop();
+  return true;
+}
+
+template <typename T, typename Alloc>
+std::optional<typename SegmentedStack<T, Alloc>::value_type>
+SegmentedStack<T, Alloc>::try_pop() {
+  if (empty()) return std::nullopt;
+  std::optional<value_type> out(std::move(cur_[-1]));
+  pop();
+  return out;
+}
+
+}  // namespace m3mpm
@@ -0,0 +1,101 @@
+#ifndef SRC_M3MPM_SEGMENTED_STACK_H_
+#define SRC_M3MPM_SEGMENTED_STACK_H_
+#include <stddef.h>
+
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+#include "config.h"
+
+namespace m3mpm {
+// Stack kept in a chain of chunks whose capacity doubles from one chunk to
+// the next, up to kMaxChunkBytes. Elements never move, so pointers and
+// references to them stay valid until they are popped, and a push costs an
+// allocation only when it opens a new chunk. When pops empty the top chunk
+// it is kept as a spare above the new top (a previous spare is freed), so
+// pushing and popping back and forth across a chunk boundary does not
+// allocate. Alloc follows the LSQContainer rules: it must be stateless.
+template <typename T, typename Alloc = std::allocator<T>>
+class SegmentedStack {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using allocator_type = Alloc;
+
+  static constexpr size_type kFirstChunkBytes = 512;
+  static constexpr size_type kMaxChunkBytes = size_type(1) << 20;
+
+  SegmentedStack()
+      : bottom_(nullptr),
+        top_(nullptr),
+        begin_(nullptr),
+        cur_(nullptr),
+        end_(nullptr),
+        below_(0) {}
+  explicit SegmentedStack(const std::initializer_list<value_type> &items);
+  SegmentedStack(const SegmentedStack &s);
+  SegmentedStack(SegmentedStack &&s) noexcept;
+  ~SegmentedStack();
+  SegmentedStack &operator=(const SegmentedStack &s);
+  SegmentedStack &operator=(SegmentedStack &&s) noexcept;
+
+  bool empty() const { return cur_ == begin_; }
+  size_type size() const { return below_ + (cur_ - begin_); }
+
+  reference top();
+  const_reference top() const;
+  void push(const_reference value);
+  void push(value_type &&value);
+  template <typename... Args>
+  reference emplace(Args &&...args);
+  void pop();
+  // Destroys the elements and releases every chunk.
+  void clear();
+  void swap(SegmentedStack &other) noexcept;
+
+  const value_type *try_top() const;
+  bool try_pop(value_type &out);
+  std::optional<value_type> try_pop();
+
+ private:
+  struct Chunk {
+    Chunk *prev_;
+    Chunk *next_;
+    size_type capacity_;
+    T *data_;
+  };
+  using value_allocator =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+  using value_traits = std::allocator_traits<value_allocator>;
+  using chunk_allocator =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Chunk>;
+  using chunk_traits = std::allocator_traits<chunk_allocator>;
+  static_assert(value_traits::is_always_equal::value,
+                "SegmentedStack: Alloc must be a stateless allocator");
+
+  // bottom_ .. top_ hold the elements, each chunk below top_ full; top_->
+  // next_ is the spare chunk, if any. The only empty chunk in use is a
+  // bottom_ that is also top_, so the stack is empty exactly when cur_, the
+  // next free slot, is at begin_. begin_ and end_ bound the storage of top_
+  // and below_ counts the elements under it: push and pop only move cur_.
+  Chunk *bottom_;
+  Chunk *top_;
+  T *begin_;
+  T *cur_;
+  T *end_;
+  size_type below_;
+
+  static Chunk *create_chunk(size_type capacity, Chunk *prev);
+  static void destroy_chunk(Chunk *chunk);
+  // Moves top_ to an empty chunk above the full one (or to a first chunk).
+  void open_chunk();
+  // Moves top_ down once its last element is gone, keeping it as spare.
+  void step_down();
+};
+}  // namespace m3mpm
+#include "segmented_stack.cpp"
+#endif  // SRC_M3MPM_SEGMENTED_STACK_H_
@@ -0,0 +1,330 @@
+#include <stdint.h>
+#include <string.h>
+
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define M3MPM_SIMD_X86 1
+#else
+#define M3MPM_SIMD_X86 0
+#endif
+
+namespace m3mpm {
+namespace detail {
+
+inline SimdLevel detect_simd_level() {
+#if M3MPM_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return SimdLevel::kVector256;
+#endif
+  return SimdLevel::kVector128;
+}
+
+inline std::atomic<SimdLevel> simd_cap{SimdLevel::kVector256};
+
+template <typename T>
+struct ScalarKernels {
+  static size_t find(const T *data, size_t n, const T &value) {
+    for (size_t i = 0; i < n; ++i) {
+      if (data[i] == value) return i;
+    }
+    return n;
+  }
+
+  static size_t count(const T *data, size_t n, const T &value) {
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) total += data[i] == value;
+    return total;
+  }
+
+  template <bool kMax>
+  static size_t extreme(const T *data, size_t n) {
+    size_t best = 0;
+    if constexpr (std::is_floating_point_v<T>) {
+      while (best < n && data[best] != data[best]) ++best;
+    }
+    for (size_t i = best + 1; i < n; ++i) {
+      if (kMax ? data[best] < data[i] : data[i] < data[best]) best = i;
+    }
+    return best < n ? best : n;
+  }
+
+  static T sum(const T *data, size_t n) {
+    T total = T();
+    for (size_t i = 0; i < n; ++i) total = static_cast<T>(total + data[i]);
+    return total;
+  }
+};
+
+template <typename T, bool = std::is_integral_v<T>>
+struct SumLane {
+  using type = T;
+};
+template <typename T>
+struct SumLane<T, true> {
+  using type = std::make_unsigned_t<T>;
+};
+
+// The same loops on Bytes-wide vectors of the GCC/Clang vector extension,
+// four vectors a step to keep several loads in flight. Vectors are only
+// passed by reference, so the 256-bit kernels keep to the AVX calling
+// convention once inlined into the avx2 entry points below.
+template <typename T, size_t Bytes>
+struct VectorKernels {
+  typedef T Vec __attribute__((vector_size(Bytes)));
+  using Mask = decltype(Vec() == Vec());
+  // The signed integer of a mask lane.
+  using Lane = std::conditional_t<
+      sizeof(T) == 1, int8_t,
+      std::conditional_t<sizeof(T) == 2, int16_t,
+                         std::conditional_t<sizeof(T) == 4, int32_t,
+                                            int64_t>>>;
+  static constexpr size_t kLanes = Bytes / sizeof(T);
+  static constexpr size_t kStep = 4 * kLanes;
+
+  template <typename V>
+  __attribute__((always_inline)) static void load(V &v, const T *data) {
+    memcpy(&v, data, Bytes);
+  }
+
+  __attribute__((always_inline)) static bool any(const Mask &m) {
+    uint64_t words[Bytes / 8];
+    memcpy(words, &m, Bytes);
+    uint64_t all = 0;
+    for (uint64_t word : words) all |= word;
+    return all != 0;
+  }
+
+  __attribute__((always_inline)) static size_t find(const T *data, size_t n,
+                                                    T value) {
+    Vec key = Vec() + value;
+    Vec v0, v1, v2, v3;
+    size_t i = 0;
+    for (; i + kStep <= n; i += kStep) {
+      load(v0, data + i);
+      load(v1, data + i + kLanes);
+      load(v2, data + i + 2 * kLanes);
+      load(v3, data + i + 3 * kLanes);
+      Mask hit = (v0 == key) | (v1 == key) | (v2 == key) | (v3 == key);
+      if (any(hit)) break;
+    }
+    for (; i < n; ++i) {
+      if (data[i] == value) return i;
+    }
+    return n;
+  }
+
+  __attribute__((always_inline)) static size_t count(const T *data, size_t n,
+                                                     T value) {
+    // A match subtracts -1 from its lane, so narrow lanes are emptied into
+    // the total before they can overflow.
+    constexpr size_t kMaxSteps = std::numeric_limits<Lane>::max() / 4;
+    Vec key = Vec() + value;
+    Vec v0, v1, v2, v3;
+    size_t total = 0;
+    size_t i = 0;
+    while (i + kStep <= n) {
+      Mask hits = Mask();
+      for (size_t step = 0; step < kMaxSteps && i + kStep <= n;
+           ++step, i += kStep) {
+        load(v0, data + i);
+        load(v1, data + i + kLanes);
+        load(v2, data + i + 2 * kLanes);
+        load(v3, data + i + 3 * kLanes);
+        hits -= v0 == key;
+        hits -= v1 == key;
+        hits -= v2 == key;
+        hits -= v3 == key;
+      }
+      for (size_t lane = 0; lane < kLanes; ++lane) {
+        total += static_cast<size_t>(hits[lane]);
+      }
+    }
+    for (; i < n; ++i) total += data[i] == value;
+    return total;
+  }
+
+  // Finds the extreme value with vector min or max, which a NaN never
+  // wins, then looks for its first occurrence.
+  template <bool kMax>
+  __attribute__((always_inline)) static size_t extreme(const T *data,
+                                                       size_t n) {
+    size_t first = 0;
+    if constexpr (std::is_floating_point_v<T>) {
+      while (first < n && data[first] != data[first]) ++first;
+    }
+    if (first == n) return n;
+    Vec best0 = Vec() + data[first];
+    Vec best1 = best0, best2 = best0, best3 = best0;
+    Vec v0, v1, v2, v3;
+    size_t i = first;
+    for (; i + kStep <= n; i += kStep) {
+      load(v0, data + i);
+      load(v1, data + i + kLanes);
+      load(v2, data + i + 2 * kLanes);
+      load(v3, data + i + 3 * kLanes);
+      if constexpr (kMax) {
+        best0 = best0 < v0 ? v0 : best0;
+        best1 = best1 < v1 ? v1 : best1;
+        best2 = best2 < v2 ? v2 : best2;
+        best3 = best3 < v3 ? v3 : best3;
+      } else {
+        best0 = v0 < best0 ? v0 : best0;
+        best1 = v1 < best1 ? v1 : best1;
+        best2 = v2 < best2 ? v2 : best2;
+        best3 = v3 < best3 ? v3 : best3;
+      }
+    }
+    T best = data[first];
+    auto consider = [&best](T value) {
+      if (kMax ? best < value : value < best) best = value;
+    };
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      consider(best0[lane]);
+      consider(best1[lane]);
+      consider(best2[lane]);
+      consider(best3[lane]);
+    }
+    for (; i < n; ++i) consider(data[i]);
+    return first + find(data + first, n - first, best);
+  }
+
+  // Integer lanes add as unsigned, which wraps where signed lanes would
+  // overflow.
+  typedef typename SumLane<T>::type SumVec __attribute__((vector_size(Bytes)));
+
+  __attribute__((always_inline)) static T sum(const T *data, size_t n) {
+    SumVec sum0 = SumVec(), sum1 = SumVec(), sum2 = SumVec(),
+           sum3 = SumVec();
+    SumVec v0, v1, v2, v3;
+    size_t i = 0;
+    for (; i + kStep <= n; i += kStep) {
+      load(v0, data + i);
+      load(v1, data + i + kLanes);
+      load(v2, data + i + 2 * kLanes);
+      load(v3, data + i + 3 * kLanes);
+      sum0 += v0;
+      sum1 += v1;
+      sum2 += v2;
+      sum3 += v3;
+    }
+    sum0 += sum1 + sum2 + sum3;
+    T total = T();
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      total = static_cast<T>(total + static_cast<T>(sum0[lane]));
+    }
+    for (; i < n; ++i) total = static_cast<T>(total + data[i]);
+    return total;
+  }
+};
+
+#if M3MPM_SIMD_X86
+// Entry points compiled for AVX2, reached only when the CPU has it.
+template <typename T>
+__attribute__((target("avx2"))) size_t find_avx2(const T *data, size_t n,
+                                                 T value) {
+  return VectorKernels<T, 32>::find(data, n, value);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) size_t count_avx2(const T *data, size_t n,
+                                                  T value) {
+  return VectorKernels<T, 32>::count(data, n, value);
+}
+
+template <typename T, bool kMax>
+__attribute__((target("avx2"))) size_t extreme_avx2(const T *data,
+                                                    size_t n) {
+  return VectorKernels<T, 32>::template extreme<kMax>(data, n);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) T sum_avx2(const T *data, size_t n) {
+  return VectorKernels<T, 32>::sum(data, n);
+}
+#endif
+
+template <typename T>
+size_t simd_find(const T *data, size_t n, const T &value) {
+  if constexpr (kSimdElement<T>) {
+    SimdLevel level = simd_level();
+#if M3MPM_SIMD_X86
+    if (level == SimdLevel::kVector256) return find_avx2(data, n, value);
+#endif
+    if (level != SimdLevel::kScalar) {
+      return VectorKernels<T, 16>::find(data, n, value);
+    }
+  }
+  return ScalarKernels<T>::find(data, n, value);
+}
+
+template <typename T>
+size_t simd_count(const T *data, size_t n, const T &value) {
+  if constexpr (kSimdElement<T>) {
+    SimdLevel level = simd_level();
+#if M3MPM_SIMD_X86
+    if (level == SimdLevel::kVector256) return count_avx2(data, n, value);
+#endif
+    if (level != SimdLevel::kScalar) {
+      return VectorKernels<T, 16>::count(data, n, value);
+    }
+  }
+  return ScalarKernels<T>::count(data, n, value);
+}
+
+template <typename T, bool kMax>
+size_t simd_extreme(const T *data, size_t n) {
+  if constexpr (kSimdElement<T>) {
+    SimdLevel level = simd_level();
+#if M3MPM_SIMD_X86
+    if (level == SimdLevel::kVector256) return extreme_avx2<T, kMax>(data, n);
+#endif
+    if (level != SimdLevel::kScalar) {
+      return VectorKernels<T, 16>::template extreme<kMax>(data, n);
+    }
+  }
+  return ScalarKernels<T>::template extreme<kMax>(data, n);
+}
+
+template <typename T>
+size_t simd_min(const T *data, size_t n) {
+  return simd_extreme<T, false>(data, n);
+}
+
+template <typename T>
+size_t simd_max(const T *data, size_t n) {
+  return simd_extreme<T, true>(data, n);
+}
+
+template <typename T>
+T simd_sum(const T *data, size_t n) {
+  if constexpr (kSimdElement<T>) {
+    SimdLevel level = simd_level();
+#if M3MPM_SIMD_X86
+    if (level == SimdLevel::kVector256) return sum_avx2(data, n);
+#endif
+    if (level != SimdLevel::kScalar) {
+      return VectorKernels<T, 16>::sum(data, n);
+    }
+  }
+  return ScalarKernels<T>::sum(data, n);
+}
+
+}  // namespace detail
+
+inline SimdLevel supported_simd_level() {
+  static const SimdLevel level = detail::detect_simd_level();
+  return level;
+}
+
+inline SimdLevel simd_level() {
+  SimdLevel cap = detail::simd_cap.load(std::memory_order_relaxed);
+  SimdLevel supported = supported_simd_level();
+  return cap < supported ? cap : supported;
+}
+
+inline void set_simd_level(SimdLevel level) {
+  detail::simd_cap.store(level, std::memory_order_relaxed);
+}
+
+}  // namespace m3mpm
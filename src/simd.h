@@ -0,0 +1,60 @@
+#ifndef SRC_M3MPM_SIMD_H_
+#define SRC_M3MPM_SIMD_H_
+#include <stddef.h>
+
+#include <atomic>
+#include <type_traits>
+
+namespace m3mpm {
+// Vector widths the search and reduction kernels can run at. On x86 the
+// 128-bit kernels are SSE2, part of every x86-64 CPU, and the 256-bit ones
+// AVX2, used when the CPU reports it; elsewhere the 128-bit kernels use
+// whatever vector unit the compiler targets.
+enum class SimdLevel { kScalar, kVector128, kVector256 };
+
+// The widest level this CPU supports, probed once.
+SimdLevel supported_simd_level();
+// The level the kernels run at, supported_simd_level() unless capped.
+SimdLevel simd_level();
+// Caps the kernels at level, or at what the CPU supports if that is lower,
+// for every thread; benchmarks and tests use it to compare the paths.
+void set_simd_level(SimdLevel level);
+
+namespace detail {
+// Element types the vector kernels handle: the arithmetic types up to
+// eight bytes. bool has no sum worth vectorizing and long double no vector
+// form, so both stay on the generic code.
+template <typename T>
+inline constexpr bool kSimdElement =
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+    !std::is_same_v<T, long double> && sizeof(T) <= 8;
+
+// Kernels over n contiguous values, dispatched on simd_level(). They match
+// the scalar loops they replace, with one exception noted at simd_sum(),
+// and any T other than a kSimdElement runs those loops.
+
+// Index of the first element equal to value, or n.
+template <typename T>
+size_t simd_find(const T *data, size_t n, const T &value);
+
+// Number of elements equal to value.
+template <typename T>
+size_t simd_count(const T *data, size_t n, const T &value);
+
+// Index of the first smallest (largest) element, or n when there is none.
+// NaNs are skipped; std::min_element also skips them, except that it
+// returns a NaN it starts from, which the callers check for.
+template <typename T>
+size_t simd_min(const T *data, size_t n);
+template <typename T>
+size_t simd_max(const T *data, size_t n);
+
+// Sum of the elements, wrapping around for integers like the scalar loop.
+// Floating-point values are added in one running sum per vector lane, so
+// the rounding differs from a left-to-right sum.
+template <typename T>
+T simd_sum(const T *data, size_t n);
+}  // namespace detail
+}  // namespace m3mpm
+#include "simd.cpp"
+#endif  // SRC_M3MPM_SIMD_H_
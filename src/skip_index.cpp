@@ -0,0 +1,248 @@
+#include <new>
+
+namespace m3mpm {
+
+template <typename T>
+SkipIndex<T>::SkipIndex(Node<T> *sentinel, size_t size)
+    : sentinel_(sentinel),
+      head_(make_tower(nullptr, kMaxLevel)),
+      levels_(0),
+      seed_(reinterpret_cast<uintptr_t>(this) | 1) {
+  // Build all levels in one pass, remembering the last tower seen on each
+  // level and the position it stands at (the head stands before position 0).
+  Tower *last[kMaxLevel + 1];
+  size_t last_pos[kMaxLevel + 1];
+  for (size_t level = 1; level <= kMaxLevel; ++level) {
+    last[level] = head_;
+    last_pos[level] = 0;
+  }
+  M3MPM_TRY {
+    towers_.reserve(size / 3);
+    Node<T> *node = sentinel_->pNext_;
+    for (size_t pos = 1; pos <= size; ++pos, node = node->pNext_) {
+      size_t height = random_height();
+      if (height == 0) continue;
+      Tower *tower = make_tower(node, height);
+      towers_.emplace(node, tower);
+      for (size_t level = 1; level <= height; ++level) {
+        Link &link = last[level]->link(level);
+        link.next_ = tower;
+        link.width_ = pos - last_pos[level];
+        tower->link(level).prev_ = last[level];
+        last[level] = tower;
+        last_pos[level] = pos;
+      }
+      if (height > levels_) levels_ = height;
+    }
+  } M3MPM_CATCH_ALL {
+    for (auto &entry : towers_) free_tower(entry.second);
+    free_tower(head_);
+    M3MPM_RETHROW;
+  }
+}
+
+template <typename T>
+SkipIndex<T>::~SkipIndex() {
+  for (auto &entry : towers_) free_tower(entry.second);
+  free_tower(head_);
+}
+
+template <typename T>
+Node<T> *SkipIndex<T>::at(size_t pos) const {
+  // Widths count hops from the tower's node, the head standing one hop
+  // before the first node of the chain.
+  size_t target = pos + 1;
+  size_t reached = 0;
+  Tower *tower = head_;
+  for (size_t level = levels_; level > 0; --level) {
+    for (Link *link = &tower->link(level);
+         link->next_ != nullptr && reached + link->width_ <= target;
+         link = &tower->link(level)) {
+      reached += link->width_;
+      tower = link->next_;
+    }
+  }
+  Node<T> *node = tower->node_;
+  if (tower == head_) {
+    node = sentinel_->pNext_;
+    reached = 1;
+  }
+  for (; reached < target; ++reached) node = node->pNext_;
+  return node;
+}
+
+template <typename T>
+size_t SkipIndex<T>::rank(const Node<T> *node) const {
+  size_t dist = 0;
+  Tower *tower = nullptr;
+  while (node != sentinel_ && (tower = tower_of(node)) == nullptr) {
+    node = node->pPrev_;
+    ++dist;
+  }
+  // Walked back past the first node: dist is the position plus one.
+  if (node == sentinel_) return dist - 1;
+  // Climb: each step leaves the tower along its top level, which lands on
+  // the previous tower at least as tall.
+  while (tower != head_) {
+    Link &link = tower->link(tower->height_);
+    Tower *prev = link.prev_;
+    dist += prev->link(tower->height_).width_;
+    tower = prev;
+  }
+  return dist - 1;
+}
+
+template <typename T>
+Node<T> *SkipIndex<T>::lower_bound(const T &value) const {
+  Tower *tower = head_;
+  for (size_t level = levels_; level > 0; --level) {
+    for (Tower *next = tower->link(level).next_;
+         next != nullptr && next->node_->data_ < value;
+         next = tower->link(level).next_) {
+      tower = next;
+    }
+  }
+  Node<T> *node =
+      tower == head_ ? sentinel_->pNext_ : tower->node_->pNext_;
+  while (node != sentinel_ && node->data_ < value) node = node->pNext_;
+  return node;
+}
+
+template <typename T>
+void SkipIndex<T>::on_insert(Node<T> *node) {
+  collect(node);
+  size_t height = random_height();
+  Tower *tower = height == 0 ? nullptr : make_tower(node, height);
+  if (tower != nullptr) {
+    M3MPM_TRY {
+      towers_.emplace(node, tower);
+    } M3MPM_CATCH_ALL {
+      free_tower(tower);
+      M3MPM_RETHROW;
+    }
+  }
+  if (height > levels_) levels_ = height;
+
+  for (size_t level = 1; level <= levels_; ++level) {
+    Tower *prev = update_[level];
+    Link &link = prev->link(level);
+    if (level <= height) {
+      // Split the link spanning the new node; it has grown by one hop.
+      Link &split = tower->link(level);
+      split.next_ = link.next_;
+      split.prev_ = prev;
+      split.width_ = link.next_ != nullptr ? link.width_ + 1 - dist_[level] : 0;
+      if (link.next_ != nullptr) link.next_->link(level).prev_ = tower;
+      link.next_ = tower;
+      link.width_ = dist_[level];
+    } else if (link.next_ != nullptr) {
+      ++link.width_;
+    }
+  }
+}
+
+template <typename T>
+void SkipIndex<T>::on_erase(Node<T> *node) {
+  collect(node);
+  Tower *tower = tower_of(node);
+  size_t height = tower == nullptr ? 0 : tower->height_;
+
+  for (size_t level = 1; level <= levels_; ++level) {
+    Tower *prev = update_[level];
+    Link &link = prev->link(level);
+    if (level <= height) {
+      // Merge the links on both sides of the erased tower.
+      Link &gone = tower->link(level);
+      link.next_ = gone.next_;
+      if (gone.next_ != nullptr) {
+        gone.next_->link(level).prev_ = prev;
+        link.width_ += gone.width_ - 1;
+      }
+    } else if (link.next_ != nullptr) {
+      --link.width_;
+    }
+  }
+  if (tower != nullptr) {
+    towers_.erase(node);
+    free_tower(tower);
+  }
+}
+
+template <typename T>
+size_t SkipIndex<T>::memory_usage() const {
+  auto tower_bytes = [](const Tower *tower) {
+    return detail::heap_allocation_size(sizeof(Tower) +
+                                        tower->height_ * sizeof(Link));
+  };
+  size_t bytes = tower_bytes(head_);
+  for (auto &entry : towers_) bytes += tower_bytes(entry.second);
+  using entry_type = typename decltype(towers_)::value_type;
+  bytes += towers_.size() *
+           detail::heap_allocation_size(sizeof(void *) + sizeof(entry_type));
+  if (towers_.bucket_count() > 1) {
+    bytes += detail::heap_allocation_size(towers_.bucket_count() *
+                                          sizeof(void *));
+  }
+  return bytes;
+}
+
+template <typename T>
+typename SkipIndex<T>::Tower *SkipIndex<T>::make_tower(Node<T> *node,
+                                                       size_t height) {
+  void *memory = ::operator new(sizeof(Tower) + height * sizeof(Link));
+  Link *links = reinterpret_cast<Link *>(static_cast<char *>(memory) +
+                                         sizeof(Tower));
+  for (size_t i = 0; i < height; ++i) new (links + i) Link{nullptr, nullptr, 0};
+  return new (memory) Tower{node, height, links};
+}
+
+template <typename T>
+void SkipIndex<T>::free_tower(Tower *tower) {
+  ::operator delete(tower);
+}
+
+template <typename T>
+size_t SkipIndex<T>::random_height() {
+  // xorshift64; every pair of trailing zero bits adds a level, so a node
+  // reaches level k with probability 4^-k.
+  seed_ ^= seed_ << 13;
+  seed_ ^= seed_ >> 7;
+  seed_ ^= seed_ << 17;
+  size_t zeros = static_cast<size_t>(__builtin_ctzll(seed_ | (1ULL << 63)));
+  size_t height = zeros / 2;
+  return height < kMaxLevel ? height : kMaxLevel;
+}
+
+template <typename T>
+typename SkipIndex<T>::Tower *SkipIndex<T>::tower_of(
+    const Node<T> *node) const {
+  auto found = towers_.find(node);
+  return found == towers_.end() ? nullptr : found->second;
+}
+
+template <typename T>
+void SkipIndex<T>::collect(const Node<T> *node) {
+  // Back along level 0 to the nearest tower, then up: a tower shorter than
+  // the level being filled is left along its top level until a tall enough
+  // one turns up. Levels above every tower resolve to the head.
+  size_t dist = 1;
+  Tower *tower = nullptr;
+  const Node<T> *prev = node->pPrev_;
+  while (prev != sentinel_ && (tower = tower_of(prev)) == nullptr) {
+    prev = prev->pPrev_;
+    ++dist;
+  }
+  if (prev == sentinel_) tower = head_;
+  for (size_t level = 1; level <= kMaxLevel; ++level) {
+    while (tower->height_ < level) {
+      size_t top = tower->height_;
+      Tower *back = tower->link(top).prev_;
+      dist += back->link(top).width_;
+      tower = back;
+    }
+    update_[level] = tower;
+    dist_[level] = dist;
+  }
+}
+
+}  // namespace m3mpm
@@ -0,0 +1,79 @@
+#ifndef SRC_M3MPM_SKIP_INDEX_H_
+#define SRC_M3MPM_SKIP_INDEX_H_
+#include <stddef.h>
+#include <stdint.h>
+
+#include <unordered_map>
+
+#include "config.h"
+#include "memory_usage.h"
+#include "node.h"
+
+namespace m3mpm {
+// Indexable skip list laid over an existing chain of Node<T>, the chain
+// itself being level 0. About a quarter of the nodes carry a tower of
+// express links, each link recording how many level-0 hops it spans, so a
+// position or a value is found in O(log n) expected steps. The owner keeps
+// the index current by reporting every node right after linking it
+// (on_insert) and right before unlinking it (on_erase); both cost O(log n)
+// expected time. Positions are 0-based; the sentinel closing the chain
+// stands for end().
+template <typename T>
+class SkipIndex {
+ public:
+  static constexpr size_t kMaxLevel = 16;
+
+  SkipIndex(Node<T> *sentinel, size_t size);
+  SkipIndex(const SkipIndex &) = delete;
+  SkipIndex &operator=(const SkipIndex &) = delete;
+  ~SkipIndex();
+
+  // Requires pos < the length of the chain.
+  Node<T> *at(size_t pos) const;
+  // Position of a node of the chain other than the sentinel.
+  size_t rank(const Node<T> *node) const;
+  // First node whose value is not less than value, or the sentinel. The
+  // chain must be sorted.
+  Node<T> *lower_bound(const T &value) const;
+
+  void on_insert(Node<T> *node);
+  void on_erase(Node<T> *node);
+
+  // Heap bytes taken by the towers and the node-to-tower map, the index
+  // object itself aside. The map is costed as libstdc++ lays it out: one
+  // bucket pointer per bucket and a next pointer plus the entry per node.
+  size_t memory_usage() const;
+
+ private:
+  struct Tower;
+  struct Link {
+    Tower *next_;
+    Tower *prev_;
+    size_t width_;
+  };
+  struct Tower {
+    Node<T> *node_;
+    size_t height_;
+    Link *links_;
+    Link &link(size_t level) { return links_[level - 1]; }
+  };
+
+  Node<T> *sentinel_;
+  Tower *head_;
+  size_t levels_;
+  uint64_t seed_;
+  std::unordered_map<const Node<T> *, Tower *> towers_;
+  // Scratch filled by collect(): the last tower before a node on every
+  // level and the number of level-0 hops from that tower to the node.
+  Tower *update_[kMaxLevel + 1];
+  size_t dist_[kMaxLevel + 1];
+
+  static Tower *make_tower(Node<T> *node, size_t height);
+  static void free_tower(Tower *tower);
+  size_t random_height();
+  Tower *tower_of(const Node<T> *node) const;
+  void collect(const Node<T> *node);
+};
+}  // namespace m3mpm
+#include "skip_index.cpp"
+#endif  // SRC_M3MPM_SKIP_INDEX_H_
@@ -0,0 +1,162 @@
+namespace m3mpm {
+
+template <typename T, size_t N, typename Alloc>
+SmallQueue<T, N, Alloc>::SmallQueue(
+    const std::initializer_list<value_type> &items)
+    : SmallQueue() {
+  for (auto &value : items) push(value);
+}
+
+template <typename T, size_t N, typename Alloc>
+SmallQueue<T, N, Alloc>::SmallQueue(const SmallQueue &q)
+    : head_(0), size_(0), spill_(q.spill_) {
+  M3MPM_TRY {
+    for (; size_ < q.size_ && size_ < N; ++size_) {
+      ::new (static_cast<void *>(slot(size_))) T(*q.slot(size_));
+    }
+  } M3MPM_CATCH_ALL {
+    clear();
+    M3MPM_RETHROW;
+  }
+  size_ = q.size_;
+}
+
+template <typename T, size_t N, typename Alloc>
+SmallQueue<T, N, Alloc>::SmallQueue(SmallQueue &&q) : SmallQueue() {
+  take_inline(q);
+}
+
+template <typename T, size_t N, typename Alloc>
+SmallQueue<T, N, Alloc> &SmallQueue<T, N, Alloc>::operator=(
+    const SmallQueue &q) {
+  if (this != &q) {
+    SmallQueue copy(q);
+    clear();
+    take_inline(copy);
+  }
+  return *this;
+}
+
+template <typename T, size_t N, typename Alloc>
+SmallQueue<T, N, Alloc> &SmallQueue<T, N, Alloc>::operator=(SmallQueue &&q) {
+  if (this != &q) {
+    clear();
+    take_inline(q);
+  }
+  return *this;
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::take_inline(SmallQueue &q) {
+  size_type n = q.size_ < N ? q.size_ : N;
+  for (; size_ < n; ++size_) {
+    ::new (static_cast<void *>(slot(size_))) T(std::move(*q.slot(size_)));
+  }
+  spill_.swap(q.spill_);
+  size_ = q.size_;
+  q.size_ = n;
+  q.clear();
+}
+
+template <typename T, size_t N, typename Alloc>
+typename SmallQueue<T, N, Alloc>::const_reference
+SmallQueue<T, N, Alloc>::front() {
+  if (!size_) M3MPM_THROW(std::logic_error("SmallQueue is empty"));
+  return *slot(0);
+}
+
+template <typename T, size_t N, typename Alloc>
+typename SmallQueue<T, N, Alloc>::const_reference
+SmallQueue<T, N, Alloc>::back() {
+  if (!size_) M3MPM_THROW(std::logic_error("SmallQueue is empty"));
+  return size_ > N ? spill_.back() : *slot(size_ - 1);
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::push(const_reference value) {
+  if (size_ < N) {
+    ::new (static_cast<void *>(slot(size_))) T(value);
+  } else {
+    spill_.push(value);
+  }
+  ++size_;
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::push(value_type &&value) {
+  if (size_ < N) {
+    ::new (static_cast<void *>(slot(size_))) T(std::move(value));
+  } else {
+    spill_.push(std::move(value));
+  }
+  ++size_;
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::drop_front() {
+  if (size_ > N) {
+    // Taken off the spill first, so nothing is destroyed if that fails; the
+    // freed slot becomes the back of the ring once head_ moves on.
+    std::optional<T> next = spill_.try_pop();
+    slot(0)->~T();
+    ::new (static_cast<void *>(slot(0))) T(std::move(*next));
+  } else {
+    slot(0)->~T();
+  }
+  head_ = (head_ + 1) % N;
+  --size_;
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::pop() {
+  if (!size_) M3MPM_THROW(std::logic_error("SmallQueue is empty"));
+  drop_front();
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::clear() {
+  for (; size_ > N; --size_) spill_.pop();
+  for (size_type i = 0; i < size_; ++i) slot(i)->~T();
+  head_ = 0;
+  size_ = 0;
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallQueue<T, N, Alloc>::swap(SmallQueue &other) {
+  if (this == &other) return;
+  SmallQueue tmp(std::move(other));
+  other = std::move(*this);
+  *this = std::move(tmp);
+}
+
+template <typename T, size_t N, typename Alloc>
+const typename SmallQueue<T, N, Alloc>::value_type *
+SmallQueue<T, N, Alloc>::try_front() const {
+  return size_ ? slot(0) : nullptr;
+}
+
+template <typename T, size_t N, typename Alloc>
+const typename SmallQueue<T, N, Alloc>::value_type *
+SmallQueue<T, N, Alloc>::try_back() const {
+  if (!size_) return nullptr;
+  return size_ > N ? spill_.try_back() : slot(size_ - 1);
+}
+
+template <typename T, size_t N, typename Alloc>
+bool SmallQueue<T, N, Alloc>::try_pop(value_type &out) {
+  if (!size_) return false;
+  out = std::move(*slot(0));
+  drop_front();
+  return true;
+}
+
+template <typename T, size_t N, typename Alloc>
+std::optional<typename SmallQueue<T, N, Alloc>::value_type>
+SmallQueue<T, N, Alloc>::try_pop() {
+  if (!size_) return std::nullopt;
+  std::optional<value_type> out(std::move(*slot(0)));
+  drop_front();
+  return out;
+}
+
+}  // namespace m3mpm
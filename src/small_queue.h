@@ -0,0 +1,81 @@
+#ifndef SRC_M3MPM_SMALL_QUEUE_H_
+#define SRC_M3MPM_SMALL_QUEUE_H_
+#include <stddef.h>
+
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+#include "config.h"
+#include "queue.h"
+
+namespace m3mpm {
+// Queue that keeps its first N elements in an inline ring buffer and only
+// the ones behind them in a Queue of heap nodes made through Alloc, so a
+// queue that never holds more than N elements never allocates. While
+// elements are spilled the ring stays full: every pop refills it with the
+// oldest spilled element, so the queue falls back to the ring alone as
+// soon as it drains to N. That refill moves an element into the slot just
+// vacated, where a throwing move could not be undone, so T must be nothrow
+// move constructible.
+template <typename T, size_t N, typename Alloc = std::allocator<T>>
+class SmallQueue {
+  static_assert(N > 0, "SmallQueue: N must be positive");
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "SmallQueue: T must be nothrow move constructible");
+
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using size_type = size_t;
+  static constexpr size_type kInlineCapacity = N;
+
+  SmallQueue() : head_(0), size_(0) {}
+  explicit SmallQueue(const std::initializer_list<value_type> &items);
+  SmallQueue(const SmallQueue &q);
+  SmallQueue(SmallQueue &&q);
+  ~SmallQueue() { clear(); }
+  SmallQueue &operator=(const SmallQueue &q);
+  SmallQueue &operator=(SmallQueue &&q);
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  bool spilled() const { return size_ > N; }
+
+  const_reference front();
+  const_reference back();
+  void push(const_reference value);
+  void push(value_type &&value);
+  void pop();
+  void clear();
+  void swap(SmallQueue &other);
+
+  const value_type *try_front() const;
+  const value_type *try_back() const;
+  bool try_pop(value_type &out);
+  std::optional<value_type> try_pop();
+
+ private:
+  alignas(T) unsigned char buffer_[N * sizeof(T)];
+  size_type head_;
+  size_type size_;
+  Queue<T, Alloc> spill_;
+
+  // i-th element of the ring counting from the front.
+  T *slot(size_type i) {
+    return std::launder(reinterpret_cast<T *>(buffer_) + (head_ + i) % N);
+  }
+  const T *slot(size_type i) const {
+    return std::launder(reinterpret_cast<const T *>(buffer_) +
+                        (head_ + i) % N);
+  }
+  // Removes the front element of the ring, which must hold one, and
+  // refills the ring from spill_.
+  void drop_front();
+  void take_inline(SmallQueue &q);
+};
+}  // namespace m3mpm
+#include "small_queue.cpp"
+#endif  // SRC_M3MPM_SMALL_QUEUE_H_
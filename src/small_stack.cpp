@@ -0,0 +1,152 @@
+namespace m3mpm {
+
+template <typename T, size_t N, typename Alloc>
+SmallStack<T, N, Alloc>::SmallStack(
+    const std::initializer_list<value_type> &items)
+    : SmallStack() {
+  for (auto &value : items) push(value);
+}
+
+template <typename T, size_t N, typename Alloc>
+SmallStack<T, N, Alloc>::SmallStack(const SmallStack &s)
+    : size_(0), spill_(s.spill_) {
+  M3MPM_TRY {
+    for (; size_ < s.size_ && size_ < N; ++size_) {
+      ::new (static_cast<void *>(slot(size_))) T(*s.slot(size_));
+    }
+  } M3MPM_CATCH_ALL {
+    clear();
+    M3MPM_RETHROW;
+  }
+  size_ = s.size_;
+}
+
+template <typename T, size_t N, typename Alloc>
+SmallStack<T, N, Alloc>::SmallStack(SmallStack &&s) : SmallStack() {
+  take_inline(s);
+}
+
+template <typename T, size_t N, typename Alloc>
+SmallStack<T, N, Alloc> &SmallStack<T, N, Alloc>::operator=(
+    const SmallStack &s) {
+  if (this != &s) {
+    SmallStack copy(s);
+    clear();
+    take_inline(copy);
+  }
+  return *this;
+}
+
+template <typename T, size_t N, typename Alloc>
+SmallStack<T, N, Alloc> &SmallStack<T, N, Alloc>::operator=(SmallStack &&s) {
+  if (this != &s) {
+    clear();
+    take_inline(s);
+  }
+  return *this;
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallStack<T, N, Alloc>::take_inline(SmallStack &s) {
+  size_type n = s.size_ < N ? s.size_ : N;
+  for (; size_ < n; ++size_) {
+    ::new (static_cast<void *>(slot(size_))) T(std::move(*s.slot(size_)));
+  }
+  spill_.swap(s.spill_);
+  size_ = s.size_;
+  s.size_ = n;
+  s.clear();
+}
+
+template <typename T, size_t N, typename Alloc>
+typename SmallStack<T, N, Alloc>::const_reference
+SmallStack<T, N, Alloc>::top() {
+  if (!size_) M3MPM_THROW(std::logic_error("SmallStack is empty"));
+  return size_ > N ? spill_.top() : *slot(size_ - 1);
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallStack<T, N, Alloc>::push(const_reference value) {
+  if (size_ < N) {
+    ::new (static_cast<void *>(slot(size_))) T(value);
+  } else {
+    spill_.push(value);
+  }
+  ++size_;
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallStack<T, N, Alloc>::push(value_type &&value) {
+  if (size_ < N) {
+    ::new (static_cast<void *>(slot(size_))) T(std::move(value));
+  } else {
+    spill_.push(std::move(value));
+  }
+  ++size_;
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallStack<T, N, Alloc>::pop() {
+  if (!size_) M3MPM_THROW(std::logic_error("SmallStack is empty"));
+  if (size_ > N) {
+    spill_.pop();
+  } else {
+    slot(size_ - 1)->~T();
+  }
+  --size_;
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallStack<T, N, Alloc>::clear() {
+  while (size_ > N) {
+    spill_.pop();
+    --size_;
+  }
+  for (; size_; --size_) slot(size_ - 1)->~T();
+}
+
+template <typename T, size_t N, typename Alloc>
+void SmallStack<T, N, Alloc>::swap(SmallStack &other) {
+  if (this == &other) return;
+  SmallStack tmp(std::move(other));
+  other = std::move(*this);
+  *this = std::move(tmp);
+}
+
+template <typename T, size_t N, typename Alloc>
+const typename SmallStack<T, N, Alloc>::value_type *
+SmallStack<T, N, Alloc>::try_top() const {
+  if (!size_) return nullptr;
+  return size_ > N ? spill_.try_top() : slot(size_ - 1);
+}
+
+template <typename T, size_t N, typename Alloc>
+bool SmallStack<T, N, Alloc>::try_pop(value_type &out) {
+  if (size_ > N) {
+    if (!spill_.try_pop(out)) return false;
+  } else if (size_) {
+    out = std::move(*slot(size_ - 1));
+    slot(size_ - 1)->~T();
+  } else {
+    return false;
+  }
+  --size_;
+  return true;
+}
+
+template <typename T, size_t N, typename Alloc>
+std::optional<typename SmallStack<T, N, Alloc>::value_type>
+SmallStack<T, N, Alloc>::try_pop() {
+  if (size_ > N) {
+    std::optional<value_type> out = spill_.try_pop();
+    --size_;
+    return out;
+  }
+  if (!size_) return std::nullopt;
+  std::optional<value_type> out(std::move(*slot(size_ - 1)));
+  slot(size_ - 1)->~T();
+  --size_;
+  return out;
+}
+
+}  // namespace m3mpm
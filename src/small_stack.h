@@ -0,0 +1,68 @@
+#ifndef SRC_M3MPM_SMALL_STACK_H_
+#define SRC_M3MPM_SMALL_STACK_H_
+#include <stddef.h>
+
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <optional>
+
+#include "config.h"
+#include "stack.h"
+
+namespace m3mpm {
+// Stack that keeps its bottom N elements inline in the object and only
+// pushes the ones above them to a Stack of heap nodes made through Alloc,
+// so a stack that never grows past N never allocates. Moving or swapping
+// moves the inline elements one by one.
+template <typename T, size_t N, typename Alloc = std::allocator<T>>
+class SmallStack {
+  static_assert(N > 0, "SmallStack: N must be positive");
+
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using size_type = size_t;
+  static constexpr size_type kInlineCapacity = N;
+
+  SmallStack() : size_(0) {}
+  explicit SmallStack(const std::initializer_list<value_type> &items);
+  SmallStack(const SmallStack &s);
+  SmallStack(SmallStack &&s);
+  ~SmallStack() { clear(); }
+  SmallStack &operator=(const SmallStack &s);
+  SmallStack &operator=(SmallStack &&s);
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  // Whether elements have gone past the inline storage into heap nodes.
+  bool spilled() const { return size_ > N; }
+
+  const_reference top();
+  void push(const_reference value);
+  void push(value_type &&value);
+  void pop();
+  void clear();
+  void swap(SmallStack &other);
+
+  const value_type *try_top() const;
+  bool try_pop(value_type &out);
+  std::optional<value_type> try_pop();
+
+ private:
+  alignas(T) unsigned char buffer_[N * sizeof(T)];
+  size_type size_;
+  Stack<T, Alloc> spill_;
+
+  T *slot(size_type i) {
+    return std::launder(reinterpret_cast<T *>(buffer_) + i);
+  }
+  const T *slot(size_type i) const {
+    return std::launder(reinterpret_cast<const T *>(buffer_) + i);
+  }
+  // Moves the inline elements of s behind those of an empty *this.
+  void take_inline(SmallStack &s);
+};
+}  // namespace m3mpm
+#include "small_stack.cpp"
+#endif  // SRC_M3MPM_SMALL_STACK_H_
@@ -0,0 +1,500 @@
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace m3mpm {
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::sortedIterator::reference
+SortedList<T, Compare>::sortedIterator::operator*() const {
+  if (kCheckedIterators) {
+    if (pNode_ == nullptr)
+      M3MPM_THROW(std::logic_error("error operator*(): iterator is empty"));
+    if (pNode_->height_ == 0)
+      M3MPM_THROW(std::logic_error("error operator*(): dereferencing end()"));
+  }
+
+  return static_cast<const SkipNode *>(pNode_)->data_;
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::sortedIterator::pointer
+SortedList<T, Compare>::sortedIterator::operator->() const {
+  return std::addressof(**this);
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::sortedIterator &
+SortedList<T, Compare>::sortedIterator::operator++() {
+  if (kCheckedIterators && pNode_ == nullptr)
+    M3MPM_THROW(std::logic_error("error operator++(): iterator is empty"));
+
+  pNode_ = pNode_->pNext_[0];
+  return *this;
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::sortedIterator
+SortedList<T, Compare>::sortedIterator::operator++(int) {
+  sortedIterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::sortedIterator &
+SortedList<T, Compare>::sortedIterator::operator--() {
+  if (kCheckedIterators && pNode_ == nullptr)
+    M3MPM_THROW(std::logic_error("error operator--(): iterator is empty"));
+
+  pNode_ = pNode_->pPrev_;
+  return *this;
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::sortedIterator
+SortedList<T, Compare>::sortedIterator::operator--(int) {
+  sortedIterator tmp(*this);
+  --*this;
+  return tmp;
+}
+
+template <typename T, typename Compare>
+bool SortedList<T, Compare>::sortedIterator::operator==(
+    const sortedIterator &other) const {
+  return pNode_ == other.pNode_;
+}
+
+template <typename T, typename Compare>
+bool SortedList<T, Compare>::sortedIterator::operator!=(
+    const sortedIterator &other) const {
+  return pNode_ != other.pNode_;
+}
+
+template <typename T, typename Compare>
+SortedList<T, Compare>::SortedList(const Compare &comp)
+    : head_(nullptr),
+      size_(0),
+      levels_(1),
+      seed_(reinterpret_cast<uintptr_t>(this) | 1),
+      comp_(comp) {}
+
+template <typename T, typename Compare>
+SortedList<T, Compare>::SortedList(std::initializer_list<T> const &items)
+    : SortedList() {
+  for (const auto &item : items) insert(item);
+}
+
+template <typename T, typename Compare>
+SortedList<T, Compare>::SortedList(const SortedList &l)
+    : SortedList(l.comp_) {
+  append_all(l);
+}
+
+template <typename T, typename Compare>
+SortedList<T, Compare>::SortedList(SortedList &&l) noexcept
+    : head_(l.head_),
+      size_(l.size_),
+      levels_(l.levels_),
+      seed_(l.seed_),
+      comp_(std::move(l.comp_)) {
+  l.head_ = nullptr;
+  l.size_ = 0;
+  l.levels_ = 1;
+}
+
+template <typename T, typename Compare>
+SortedList<T, Compare>::~SortedList() {
+  clear();
+  ::operator delete(head_);
+}
+
+template <typename T, typename Compare>
+SortedList<T, Compare> &SortedList<T, Compare>::operator=(
+    const SortedList &l) {
+  if (this != &l) {
+    SortedList tmp(l);
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare>
+SortedList<T, Compare> &SortedList<T, Compare>::operator=(
+    SortedList &&l) noexcept {
+  if (this != &l) {
+    SortedList tmp(std::move(l));
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::const_reference
+SortedList<T, Compare>::front() const {
+  if (empty()) {
+    M3MPM_THROW(std::range_error("error front(): the SortedList is empty"));
+  }
+  return data(head_->pNext_[0]);
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::const_reference
+SortedList<T, Compare>::back() const {
+  if (empty()) {
+    M3MPM_THROW(std::range_error("error back(): the SortedList is empty"));
+  }
+  return data(head_->pPrev_);
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::size_type SortedList<T, Compare>::max_size()
+    const {
+  return std::numeric_limits<size_t>::max() /
+         (sizeof(SkipNode) + 2 * sizeof(SkipLinks *));
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::iterator SortedList<T, Compare>::begin()
+    const {
+  return head_ ? iterator(head_->pNext_[0]) : iterator();
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::iterator SortedList<T, Compare>::end() const {
+  return iterator(head_);
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::iterator SortedList<T, Compare>::insert(
+    const_reference value) {
+  return emplace(value);
+}
+
+template <typename T, typename Compare>
+template <typename... Args>
+typename SortedList<T, Compare>::iterator SortedList<T, Compare>::emplace(
+    Args &&...args) {
+  if (!head_) make_head();
+  SkipNode *node = create_node(random_height(), std::forward<Args>(args)...);
+  SkipLinks *update[kMaxLevel];
+  M3MPM_TRY {
+    find_update(node->data_, true, update);
+  } M3MPM_CATCH_ALL {
+    destroy_node(node);
+    M3MPM_RETHROW;
+  }
+  return link(node, update);
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::erase(iterator pos) {
+  if (pos.pNode_ == nullptr || pos.pNode_ == head_) {
+    M3MPM_THROW(std::range_error(
+        "error erase(): the iterator is empty or points to end()"));
+  }
+  SkipLinks *update[kMaxLevel];
+  find_links_to(pos.pNode_, update);
+  remove(pos.pNode_, update);
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::size_type SortedList<T, Compare>::erase(
+    const_reference value) {
+  // Bound the range first: value may refer to one of the erased elements.
+  size_type erased = 0;
+  iterator it = lower_bound(value);
+  iterator last = upper_bound(value);
+  while (it != last) {
+    iterator next = it;
+    ++next;
+    erase(it);
+    it = next;
+    ++erased;
+  }
+  return erased;
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::pop_front() {
+  if (empty()) {
+    M3MPM_THROW(std::range_error("error pop_front(): the SortedList is empty"));
+  }
+  erase(begin());
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::pop_back() {
+  if (empty()) {
+    M3MPM_THROW(std::range_error("error pop_back(): the SortedList is empty"));
+  }
+  erase(iterator(head_->pPrev_));
+}
+
+template <typename T, typename Compare>
+const typename SortedList<T, Compare>::value_type *
+SortedList<T, Compare>::try_front() const {
+  return empty() ? nullptr : &data(head_->pNext_[0]);
+}
+
+template <typename T, typename Compare>
+const typename SortedList<T, Compare>::value_type *
+SortedList<T, Compare>::try_back() const {
+  return empty() ? nullptr : &data(head_->pPrev_);
+}
+
+template <typename T, typename Compare>
+bool SortedList<T, Compare>::try_pop_front(value_type &out) {
+  return !empty() && take(head_->pNext_[0], out);
+}
+
+template <typename T, typename Compare>
+std::optional<typename SortedList<T, Compare>::value_type>
+SortedList<T, Compare>::try_pop_front() {
+  std::optional<value_type> out;
+  if (!empty()) take(head_->pNext_[0], out);
+  return out;
+}
+
+template <typename T, typename Compare>
+bool SortedList<T, Compare>::try_pop_back(value_type &out) {
+  return !empty() && take(head_->pPrev_, out);
+}
+
+template <typename T, typename Compare>
+std::optional<typename SortedList<T, Compare>::value_type>
+SortedList<T, Compare>::try_pop_back() {
+  std::optional<value_type> out;
+  if (!empty()) take(head_->pPrev_, out);
+  return out;
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::clear() {
+  if (!head_) return;
+  SkipLinks *node = head_->pNext_[0];
+  while (node != head_) {
+    SkipLinks *next = node->pNext_[0];
+    destroy_node(node);
+    node = next;
+  }
+  head_->pPrev_ = head_;
+  for (size_type level = 0; level < kMaxLevel; ++level) {
+    head_->pNext_[level] = head_;
+  }
+  size_ = 0;
+  levels_ = 1;
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::swap(SortedList &other) noexcept {
+  using std::swap;
+  swap(head_, other.head_);
+  swap(size_, other.size_);
+  swap(levels_, other.levels_);
+  swap(seed_, other.seed_);
+  swap(comp_, other.comp_);
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::iterator SortedList<T, Compare>::find(
+    const_reference value) const {
+  iterator it = lower_bound(value);
+  if (it != end() && !comp_(value, *it)) return it;
+  return end();
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::iterator SortedList<T, Compare>::lower_bound(
+    const_reference value) const {
+  if (empty()) return end();
+  SkipLinks *update[kMaxLevel];
+  find_update(value, false, update);
+  return iterator(update[0]->pNext_[0]);
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::iterator SortedList<T, Compare>::upper_bound(
+    const_reference value) const {
+  if (empty()) return end();
+  SkipLinks *update[kMaxLevel];
+  find_update(value, true, update);
+  return iterator(update[0]->pNext_[0]);
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::size_type SortedList<T, Compare>::count(
+    const_reference value) const {
+  size_type n = 0;
+  for (iterator it = lower_bound(value); it != end() && !comp_(value, *it);
+       ++it) {
+    ++n;
+  }
+  return n;
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::print() const {
+  for (auto it = cbegin(); it != cend(); ++it) std::cout << *it << " ";
+  std::cout << std::endl;
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::SkipLinks **SortedList<T, Compare>::links_of(
+    void *memory, size_t offset) {
+  return reinterpret_cast<SkipLinks **>(static_cast<char *>(memory) + offset);
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::make_head() {
+  void *memory =
+      ::operator new(sizeof(SkipLinks) + kMaxLevel * sizeof(SkipLinks *));
+  head_ = new (memory) SkipLinks{nullptr, links_of(memory, sizeof(SkipLinks)),
+                                 0};
+  head_->pPrev_ = head_;
+  for (size_type level = 0; level < kMaxLevel; ++level) {
+    head_->pNext_[level] = head_;
+  }
+}
+
+template <typename T, typename Compare>
+template <typename... Args>
+typename SortedList<T, Compare>::SkipNode *SortedList<T, Compare>::create_node(
+    size_t height, Args &&...args) {
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "SortedList: over-aligned types are not supported");
+  // The tower follows the node in the same block; sizeof(SkipNode) is a
+  // multiple of its alignment, which is at least that of a pointer.
+  void *memory =
+      ::operator new(sizeof(SkipNode) + height * sizeof(SkipLinks *));
+  M3MPM_TRY {
+    return new (memory) SkipNode(links_of(memory, sizeof(SkipNode)), height,
+                                 std::forward<Args>(args)...);
+  } M3MPM_CATCH_ALL {
+    ::operator delete(memory);
+    M3MPM_RETHROW;
+  }
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::destroy_node(SkipLinks *node) {
+  SkipNode *element = static_cast<SkipNode *>(node);
+  element->~SkipNode();
+  ::operator delete(element);
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::size_type
+SortedList<T, Compare>::random_height() {
+  // xorshift64; every trailing zero bit adds a level, so a node reaches
+  // level k with probability 2^-k.
+  seed_ ^= seed_ << 13;
+  seed_ ^= seed_ >> 7;
+  seed_ ^= seed_ << 17;
+  size_type zeros =
+      static_cast<size_type>(__builtin_ctzll(seed_ | (1ULL << 63)));
+  size_type height = 1 + zeros;
+  return height < kMaxLevel ? height : kMaxLevel;
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::find_update(const_reference value,
+                                         bool after_equal,
+                                         SkipLinks **update) const {
+  SkipLinks *x = head_;
+  for (size_type level = levels_; level-- > 0;) {
+    for (SkipLinks *next = x->pNext_[level];
+         next != head_ && (after_equal ? !comp_(value, data(next))
+                                       : comp_(data(next), value));
+         next = x->pNext_[level]) {
+      x = next;
+    }
+    update[level] = x;
+  }
+}
+
+template <typename T, typename Compare>
+typename SortedList<T, Compare>::iterator SortedList<T, Compare>::link(
+    SkipNode *node, SkipLinks **update) {
+  size_type height = node->height_;
+  for (size_type level = levels_; level < height; ++level) {
+    update[level] = head_;
+  }
+  if (height > levels_) levels_ = height;
+  for (size_type level = 0; level < height; ++level) {
+    node->pNext_[level] = update[level]->pNext_[level];
+    update[level]->pNext_[level] = node;
+  }
+  node->pPrev_ = update[0];
+  node->pNext_[0]->pPrev_ = node;
+  ++size_;
+  return iterator(node);
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::find_links_to(const SkipLinks *target,
+                                           SkipLinks **update) const {
+  const T &value = data(target);
+  // Above the target's tower only strictly smaller elements may be passed:
+  // an equal one there could lie beyond the target. Within the tower the
+  // walk goes on through equal elements until it reaches the target.
+  SkipLinks *x = head_;
+  for (size_type level = levels_; level-- > 0;) {
+    for (SkipLinks *next = x->pNext_[level];
+         next != head_ && next != target &&
+         (comp_(data(next), value) ||
+          (level < target->height_ && !comp_(value, data(next))));
+         next = x->pNext_[level]) {
+      x = next;
+    }
+    update[level] = x;
+  }
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::remove(SkipLinks *target, SkipLinks **update) {
+  for (size_type level = 0; level < target->height_; ++level) {
+    update[level]->pNext_[level] = target->pNext_[level];
+  }
+  target->pNext_[0]->pPrev_ = target->pPrev_;
+  destroy_node(target);
+  --size_;
+  while (levels_ > 1 && head_->pNext_[levels_ - 1] == head_) --levels_;
+}
+
+template <typename T, typename Compare>
+template <typename Out>
+bool SortedList<T, Compare>::take(SkipLinks *target, Out &out) {
+  // Search while the value is intact, move it out, then unlink.
+  SkipLinks *update[kMaxLevel];
+  find_links_to(target, update);
+  out = std::move(static_cast<SkipNode *>(target)->data_);
+  remove(target, update);
+  return true;
+}
+
+template <typename T, typename Compare>
+void SortedList<T, Compare>::append_all(const SortedList &l) {
+  if (l.empty()) return;
+  if (!head_) make_head();
+  // Copies keep the tower heights of the originals, so the copy has the
+  // same shape and needs no searching.
+  SkipLinks *tails[kMaxLevel];
+  for (size_type level = 0; level < kMaxLevel; ++level) tails[level] = head_;
+  for (SkipLinks *from = l.head_->pNext_[0]; from != l.head_;
+       from = from->pNext_[0]) {
+    SkipNode *node = create_node(from->height_, data(from));
+    for (size_type level = 0; level < node->height_; ++level) {
+      node->pNext_[level] = head_;
+      tails[level]->pNext_[level] = node;
+      tails[level] = node;
+    }
+    node->pPrev_ = head_->pPrev_;
+    head_->pPrev_ = node;
+    if (node->height_ > levels_) levels_ = node->height_;
+    ++size_;
+  }
+}
+
+}  // namespace m3mpm
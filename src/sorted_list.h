@@ -0,0 +1,162 @@
+#ifndef SRC_M3MPM_SORTED_LIST_H_
+#define SRC_M3MPM_SORTED_LIST_H_
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+
+#include "config.h"
+
+namespace m3mpm {
+// Ordered multiset kept as a probabilistic skip list. Every node carries a
+// tower of forward links, one per level, with half of the nodes of a level
+// promoted to the next one, plus a backward link on level 0, so
+// insert, erase and the searches take O(log n) expected time and iteration
+// runs both ways in order. Equal elements keep their insertion order.
+// Elements are immutable through iterators, as reordering them in place
+// would break the ordering.
+template <typename T, typename Compare = std::less<T>>
+class SortedList {
+ private:
+  struct SkipLinks {
+    SkipLinks *pPrev_;
+    // pNext_[0] .. pNext_[height_ - 1]; the head has kMaxLevel links and
+    // height_ 0, which tells it apart from the element nodes.
+    SkipLinks **pNext_;
+    size_t height_;
+  };
+  struct SkipNode;
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  // Bidirectional iterators, checked as configured in config.h.
+  class sortedIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    SkipLinks *pNode_;
+
+    sortedIterator() : pNode_(nullptr) {}
+    explicit sortedIterator(SkipLinks *node) : pNode_(node) {}
+
+    reference operator*() const;
+    pointer operator->() const;
+    sortedIterator &operator++();
+    sortedIterator operator++(int);
+    sortedIterator &operator--();
+    sortedIterator operator--(int);
+    bool operator==(const sortedIterator &other) const;
+    bool operator!=(const sortedIterator &other) const;
+  };
+  using iterator = sortedIterator;
+  using const_iterator = sortedIterator;
+
+  static constexpr size_type kMaxLevel = 32;
+
+ public:
+  SortedList() : SortedList(Compare()) {}
+  explicit SortedList(const Compare &comp);
+  explicit SortedList(std::initializer_list<T> const &items);
+  SortedList(const SortedList &l);
+  SortedList(SortedList &&l) noexcept;
+  ~SortedList();
+  SortedList &operator=(const SortedList &l);
+  SortedList &operator=(SortedList &&l) noexcept;
+
+  const_reference front() const;
+  const_reference back() const;
+
+  size_type size() const { return size_; }
+  size_type max_size() const;
+  bool empty() const { return size_ == 0; }
+  key_compare key_comp() const { return comp_; }
+
+  iterator begin() const;
+  iterator end() const;
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  // Inserts after the elements equal to value and returns the new element.
+  iterator insert(const_reference value);
+  template <typename... Args>
+  iterator emplace(Args &&...args);
+  void erase(iterator pos);
+  // Erases every element equal to value and returns how many there were.
+  size_type erase(const_reference value);
+  void pop_front();
+  void pop_back();
+  void clear();
+  void swap(SortedList &other) noexcept;
+
+  // Empty-safe forms of front(), back() and the pops: null, false or an
+  // empty optional instead of an exception.
+  const value_type *try_front() const;
+  const value_type *try_back() const;
+  bool try_pop_front(value_type &out);
+  std::optional<value_type> try_pop_front();
+  bool try_pop_back(value_type &out);
+  std::optional<value_type> try_pop_back();
+
+  iterator find(const_reference value) const;
+  iterator lower_bound(const_reference value) const;
+  iterator upper_bound(const_reference value) const;
+  size_type count(const_reference value) const;
+
+  void print() const;
+
+ private:
+  struct SkipNode : SkipLinks {
+    T data_;
+
+    template <typename... Args>
+    SkipNode(SkipLinks **next, size_t height, Args &&...args)
+        : SkipLinks{nullptr, next, height},
+          data_(std::forward<Args>(args)...) {}
+  };
+
+  SkipLinks *head_;
+  size_type size_;
+  size_type levels_;
+  uint64_t seed_;
+  Compare comp_;
+
+  static const T &data(const SkipLinks *node) {
+    return static_cast<const SkipNode *>(node)->data_;
+  }
+  static SkipLinks **links_of(void *memory, size_t offset);
+  void make_head();
+  template <typename... Args>
+  SkipNode *create_node(size_t height, Args &&...args);
+  static void destroy_node(SkipLinks *node);
+  size_type random_height();
+  // Fills update with the last node before value on every level in use;
+  // with after_equal the search also steps over elements equal to value.
+  void find_update(const_reference value, bool after_equal,
+                   SkipLinks **update) const;
+  iterator link(SkipNode *node, SkipLinks **update);
+  // Fills update with the last node before target on each level of its
+  // tower; target's value is compared, so it must not be moved from yet.
+  void find_links_to(const SkipLinks *target, SkipLinks **update) const;
+  void remove(SkipLinks *target, SkipLinks **update);
+  template <typename Out>
+  bool take(SkipLinks *target, Out &out);
+  // Fills an empty list with copies of the elements of l in O(n).
+  void append_all(const SortedList &l);
+};
+}  // namespace m3mpm
+#include "sorted_list.cpp"
+#endif  // SRC_M3MPM_SORTED_LIST_H_
@@ -1,9 +1,32 @@
 namespace m3mpm {
 
-template <typename T>
-typename Stack<T>::const_reference Stack<T>::top() {
-  return this->size_ ? this->tail_->data_
-                     : throw std::logic_error("Stack is empty");
+template <typename T, typename Alloc, typename Stats>
+typename Stack<T, Alloc, Stats>::const_reference Stack<T, Alloc, Stats>::top() {
+  if (!this->size_) M3MPM_THROW(std::logic_error("Stack is empty"));
+  return this->tail_->data_;
+}
+
+template <typename T, typename Alloc, typename Stats>
+const typename Stack<T, Alloc, Stats>::value_type *
+Stack<T, Alloc, Stats>::try_top() const {
+  return this->size_ ? &this->tail_->data_ : nullptr;
+}
+
+template <typename T, typename Alloc, typename Stats>
+bool Stack<T, Alloc, Stats>::try_pop(value_type &out) {
+  if (!this->size_) return false;
+  out = std::move(this->tail_->data_);
+  this->pop();
+  return true;
+}
+
+template <typename T, typename Alloc, typename Stats>
+std::optional<typename Stack<T, Alloc, Stats>::value_type>
+Stack<T, Alloc, Stats>::try_pop() {
+  if (!this->size_) return std::nullopt;
+  std::optional<value_type> out(std::move(this->tail_->data_));
+  this->pop();
+  return out;
 }
 
 }  // namespace m3mpm
@@ -4,22 +4,30 @@
 
 #include <initializer_list>
 #include <iostream>
+#include <optional>
 
 #include "LSQContainer.h"
 
 namespace m3mpm {
-template <typename T>
-class Stack : public LSQContainer<T> {
+template <typename T, typename Alloc = std::allocator<T>,
+          typename Stats = NoStats>
+class Stack : public LSQContainer<T, Alloc, Stats> {
  public:
   using value_type = T;
   using const_reference = const T &;
 
  public:
-  Stack() : LSQContainer<value_type>::LSQContainer() {}
+  Stack() : LSQContainer<value_type, Alloc, Stats>::LSQContainer() {}
   explicit Stack(const std::initializer_list<value_type> &items)
-      : LSQContainer<value_type>::LSQContainer(items) {}
+      : LSQContainer<value_type, Alloc, Stats>::LSQContainer(items) {}
 
   const_reference top();
+
+  // Non-throwing access for consumers that poll: try_top() returns null and
+  // try_pop() false or an empty optional when the stack is empty.
+  const value_type *try_top() const;
+  bool try_pop(value_type &out);
+  std::optional<value_type> try_pop();
 };
 }  // namespace m3mpm
 #include "stack.cpp"
@@ -0,0 +1,87 @@
+namespace m3mpm {
+
+template <typename T, size_t N>
+constexpr StaticQueue<T, N>::StaticQueue(
+    std::initializer_list<value_type> items) {
+  for (auto &value : items) push(value);
+}
+
+template <typename T, size_t N>
+constexpr typename StaticQueue<T, N>::const_reference
+StaticQueue<T, N>::front() const {
+  if (!size_) M3MPM_THROW(std::logic_error("StaticQueue is empty"));
+  return data_[head_];
+}
+
+template <typename T, size_t N>
+constexpr typename StaticQueue<T, N>::const_reference
+StaticQueue<T, N>::back() const {
+  if (!size_) M3MPM_THROW(std::logic_error("StaticQueue is empty"));
+  return data_[wrap(head_ + size_ - 1)];
+}
+
+template <typename T, size_t N>
+constexpr void StaticQueue<T, N>::push(const_reference value) {
+  if (size_ == N) M3MPM_THROW(std::out_of_range("StaticQueue is full"));
+  data_[wrap(head_ + size_)] = value;
+  ++size_;
+}
+
+template <typename T, size_t N>
+constexpr void StaticQueue<T, N>::push(value_type &&value) {
+  if (size_ == N) M3MPM_THROW(std::out_of_range("StaticQueue is full"));
+  data_[wrap(head_ + size_)] = std::move(value);
+  ++size_;
+}
+
+template <typename T, size_t N>
+constexpr void StaticQueue<T, N>::pop() {
+  if (!size_) M3MPM_THROW(std::logic_error("StaticQueue is empty"));
+  if constexpr (!std::is_trivially_destructible_v<T>) data_[head_] = T();
+  head_ = wrap(head_ + 1);
+  --size_;
+}
+
+template <typename T, size_t N>
+constexpr void StaticQueue<T, N>::clear() {
+  while (size_) pop();
+  head_ = 0;
+}
+
+template <typename T, size_t N>
+constexpr bool StaticQueue<T, N>::try_push(const_reference value) {
+  if (size_ == N) return false;
+  push(value);
+  return true;
+}
+
+template <typename T, size_t N>
+constexpr const typename StaticQueue<T, N>::value_type *
+StaticQueue<T, N>::try_front() const {
+  return size_ ? &data_[head_] : nullptr;
+}
+
+template <typename T, size_t N>
+constexpr const typename StaticQueue<T, N>::value_type *
+StaticQueue<T, N>::try_back() const {
+  return size_ ? &data_[wrap(head_ + size_ - 1)] : nullptr;
+}
+
+template <typename T, size_t N>
+constexpr bool StaticQueue<T, N>::try_pop(value_type &out) {
+  if (!size_) return false;
+  out = std::move(data_[head_]);
+  pop();
+  return true;
+}
+
+template <typename T, size_t N>
+constexpr std::optional<typename StaticQueue<T, N>::value_type>
+StaticQueue<T, N>::try_pop() {
+  if (!size_) return std::nullopt;
+  std::optional<value_type> out(std::move(data_[head_]));
+  pop();
+  return out;
+}
+
+}  // namespace m3mpm
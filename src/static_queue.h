@@ -0,0 +1,54 @@
+#ifndef SRC_M3MPM_STATIC_QUEUE_H_
+#define SRC_M3MPM_STATIC_QUEUE_H_
+#include <stddef.h>
+
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "config.h"
+
+namespace m3mpm {
+// Fixed-capacity FIFO counterpart of StaticStack: a ring buffer of N
+// elements inside the object, with the same guarantees and requirements.
+template <typename T, size_t N>
+class StaticQueue {
+  static_assert(N > 0, "StaticQueue: N must be positive");
+
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+  constexpr StaticQueue() = default;
+  constexpr explicit StaticQueue(std::initializer_list<value_type> items);
+
+  constexpr bool empty() const { return size_ == 0; }
+  constexpr bool full() const { return size_ == N; }
+  constexpr size_type size() const { return size_; }
+  static constexpr size_type capacity() { return N; }
+
+  constexpr const_reference front() const;
+  constexpr const_reference back() const;
+  constexpr void push(const_reference value);
+  constexpr void push(value_type &&value);
+  constexpr void pop();
+  constexpr void clear();
+
+  constexpr bool try_push(const_reference value);
+  constexpr const value_type *try_front() const;
+  constexpr const value_type *try_back() const;
+  constexpr bool try_pop(value_type &out);
+  constexpr std::optional<value_type> try_pop();
+
+ private:
+  T data_[N] = {};
+  size_type head_ = 0;
+  size_type size_ = 0;
+
+  static constexpr size_type wrap(size_type i) { return i < N ? i : i - N; }
+};
+}  // namespace m3mpm
+#include "static_queue.cpp"
+#endif  // SRC_M3MPM_STATIC_QUEUE_H_
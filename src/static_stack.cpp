@@ -0,0 +1,70 @@
+namespace m3mpm {
+
+template <typename T, size_t N>
+constexpr StaticStack<T, N>::StaticStack(
+    std::initializer_list<value_type> items) {
+  for (auto &value : items) push(value);
+}
+
+template <typename T, size_t N>
+constexpr typename StaticStack<T, N>::const_reference
+StaticStack<T, N>::top() const {
+  if (!size_) M3MPM_THROW(std::logic_error("StaticStack is empty"));
+  return data_[size_ - 1];
+}
+
+template <typename T, size_t N>
+constexpr void StaticStack<T, N>::push(const_reference value) {
+  if (size_ == N) M3MPM_THROW(std::out_of_range("StaticStack is full"));
+  data_[size_++] = value;
+}
+
+template <typename T, size_t N>
+constexpr void StaticStack<T, N>::push(value_type &&value) {
+  if (size_ == N) M3MPM_THROW(std::out_of_range("StaticStack is full"));
+  data_[size_++] = std::move(value);
+}
+
+template <typename T, size_t N>
+constexpr void StaticStack<T, N>::pop() {
+  if (!size_) M3MPM_THROW(std::logic_error("StaticStack is empty"));
+  --size_;
+  if constexpr (!std::is_trivially_destructible_v<T>) data_[size_] = T();
+}
+
+template <typename T, size_t N>
+constexpr void StaticStack<T, N>::clear() {
+  while (size_) pop();
+}
+
+template <typename T, size_t N>
+constexpr bool StaticStack<T, N>::try_push(const_reference value) {
+  if (size_ == N) return false;
+  data_[size_++] = value;
+  return true;
+}
+
+template <typename T, size_t N>
+constexpr const typename StaticStack<T, N>::value_type *
+StaticStack<T, N>::try_top() const {
+  return size_ ? &data_[size_ - 1] : nullptr;
+}
+
+template <typename T, size_t N>
+constexpr bool StaticStack<T, N>::try_pop(value_type &out) {
+  if (!size_) return false;
+  out = std::move(data_[size_ - 1]);
+  pop();
+  return true;
+}
+
+template <typename T, size_t N>
+constexpr std::optional<typename StaticStack<T, N>::value_type>
+StaticStack<T, N>::try_pop() {
+  if (!size_) return std::nullopt;
+  std::optional<value_type> out(std::move(data_[size_ - 1]));
+  pop();
+  return out;
+}
+
+}  // namespace m3mpm
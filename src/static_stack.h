@@ -0,0 +1,54 @@
+#ifndef SRC_M3MPM_STATIC_STACK_H_
+#define SRC_M3MPM_STATIC_STACK_H_
+#include <stddef.h>
+
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "config.h"
+
+namespace m3mpm {
+// Stack of at most N elements stored in a plain array inside the object:
+// no heap, trivially copyable whenever T is, and usable in constant
+// expressions (with a non-literal T such as std::string only from C++20
+// on, and only within one evaluation). T must be default-constructible;
+// the array holds N values at all times and a popped slot is reset to T()
+// so that it lets go of what it owned. Pushing onto a full stack throws
+// std::out_of_range; try_push() reports it with false instead.
+template <typename T, size_t N>
+class StaticStack {
+  static_assert(N > 0, "StaticStack: N must be positive");
+
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+  constexpr StaticStack() = default;
+  constexpr explicit StaticStack(std::initializer_list<value_type> items);
+
+  constexpr bool empty() const { return size_ == 0; }
+  constexpr bool full() const { return size_ == N; }
+  constexpr size_type size() const { return size_; }
+  static constexpr size_type capacity() { return N; }
+
+  constexpr const_reference top() const;
+  constexpr void push(const_reference value);
+  constexpr void push(value_type &&value);
+  constexpr void pop();
+  constexpr void clear();
+
+  constexpr bool try_push(const_reference value);
+  constexpr const value_type *try_top() const;
+  constexpr bool try_pop(value_type &out);
+  constexpr std::optional<value_type> try_pop();
+
+ private:
+  T data_[N] = {};
+  size_type size_ = 0;
+};
+}  // namespace m3mpm
+#include "static_stack.cpp"
+#endif  // SRC_M3MPM_STATIC_STACK_H_
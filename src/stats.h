@@ -0,0 +1,206 @@
+#ifndef SRC_M3MPM_STATS_H_
+#define SRC_M3MPM_STATS_H_
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <utility>
+
+namespace m3mpm {
+// Operations counted per container. A call is counted however it is made,
+// so the calls a container makes to itself show up too: List::merge()
+// counts one merge and an insert per element taken, List::clear() a pop
+// per element.
+enum class Op : size_t {
+  kPush,
+  kPop,
+  kInsert,
+  kErase,
+  kCopy,
+  kClear,
+  kSort,
+  kMerge,
+  kSplice,
+  kUnique,
+  kReverse,
+  kCount
+};
+
+struct ContainerStats {
+  // Node allocations and frees; the slab of List::compact() is one of each.
+  uint64_t allocations = 0;
+  uint64_t frees = 0;
+  // Nodes constructed and not yet destroyed, the sentinel of a List
+  // included, and the bytes allocated for nodes and not yet freed.
+  uint64_t live_nodes = 0;
+  uint64_t peak_nodes = 0;
+  uint64_t live_bytes = 0;
+  uint64_t peak_bytes = 0;
+  // Links followed by walks the container makes itself (sort, merge,
+  // unique, reverse, copies, for_each); walks with iterators are not seen.
+  uint64_t hops = 0;
+  uint64_t ops[static_cast<size_t>(Op::kCount)] = {};
+
+  uint64_t count(Op op) const { return ops[static_cast<size_t>(op)]; }
+};
+
+inline const char *op_name(Op op) {
+  static const char *const kNames[] = {"push",   "pop",   "insert", "erase",
+                                       "copy",   "clear", "sort",   "merge",
+                                       "splice", "unique", "reverse"};
+  return op < Op::kCount ? kNames[static_cast<size_t>(op)] : "?";
+}
+
+namespace detail {
+// What op_scope() returns when nothing happens at the end of the call. The
+// destructor is user-provided only so that an unused scope variable does
+// not draw a warning.
+struct NoScope {
+  ~NoScope() {}
+};
+}  // namespace detail
+
+// Instrumentation policies, the last template parameter of List, Stack and
+// Queue. The containers derive from their policy and call its hooks at
+// every node allocation, and open an op_scope() for the length of every
+// counted operation. NoStats has no state and empty inline hooks, so with
+// it (the default) the base takes no space and the calls compile to
+// nothing.
+class NoStats {
+ public:
+  static constexpr bool kEnabled = false;
+
+ protected:
+  void on_allocate(size_t) const {}
+  void on_deallocate(size_t) const {}
+  void on_construct(size_t = 1) const {}
+  void on_destroy(size_t = 1) const {}
+  detail::NoScope op_scope(Op) const { return {}; }
+  void on_hops(size_t) const {}
+  // Called when the nodes of two containers change hands.
+  void on_swap(const NoStats &) const {}
+};
+
+namespace detail {
+struct GlobalCounters {
+  std::atomic<uint64_t> allocations{0};
+  std::atomic<uint64_t> frees{0};
+  std::atomic<uint64_t> live_nodes{0};
+  std::atomic<uint64_t> peak_nodes{0};
+  std::atomic<uint64_t> live_bytes{0};
+  std::atomic<uint64_t> peak_bytes{0};
+  std::atomic<uint64_t> hops{0};
+  std::atomic<uint64_t> ops[static_cast<size_t>(Op::kCount)] = {};
+};
+
+inline GlobalCounters global_counters;
+
+inline void raise_peak(std::atomic<uint64_t> &peak, uint64_t value) {
+  uint64_t seen = peak.load(std::memory_order_relaxed);
+  while (seen < value &&
+         !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+  }
+}
+}  // namespace detail
+
+// Counts into the container's own ContainerStats, read through stats(),
+// and into the totals of global_stats(), kept with relaxed atomics so that
+// containers on different threads can share them.
+class CountingStats {
+ public:
+  static constexpr bool kEnabled = true;
+
+  const ContainerStats &stats() const { return stats_; }
+
+ protected:
+  void on_allocate(size_t bytes) const {
+    ++stats_.allocations;
+    stats_.live_bytes += bytes;
+    if (stats_.live_bytes > stats_.peak_bytes) {
+      stats_.peak_bytes = stats_.live_bytes;
+    }
+    auto &global = detail::global_counters;
+    global.allocations.fetch_add(1, std::memory_order_relaxed);
+    detail::raise_peak(global.peak_bytes,
+                       global.live_bytes.fetch_add(
+                           bytes, std::memory_order_relaxed) +
+                           bytes);
+  }
+  void on_deallocate(size_t bytes) const {
+    ++stats_.frees;
+    stats_.live_bytes -= bytes;
+    auto &global = detail::global_counters;
+    global.frees.fetch_add(1, std::memory_order_relaxed);
+    global.live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+  void on_construct(size_t nodes = 1) const {
+    stats_.live_nodes += nodes;
+    if (stats_.live_nodes > stats_.peak_nodes) {
+      stats_.peak_nodes = stats_.live_nodes;
+    }
+    auto &global = detail::global_counters;
+    detail::raise_peak(global.peak_nodes,
+                       global.live_nodes.fetch_add(
+                           nodes, std::memory_order_relaxed) +
+                           nodes);
+  }
+  void on_destroy(size_t nodes = 1) const {
+    stats_.live_nodes -= nodes;
+    detail::global_counters.live_nodes.fetch_sub(nodes,
+                                                 std::memory_order_relaxed);
+  }
+  detail::NoScope op_scope(Op op) const {
+    ++stats_.ops[static_cast<size_t>(op)];
+    detail::global_counters.ops[static_cast<size_t>(op)].fetch_add(
+        1, std::memory_order_relaxed);
+    return {};
+  }
+  void on_hops(size_t hops) const {
+    stats_.hops += hops;
+    detail::global_counters.hops.fetch_add(hops, std::memory_order_relaxed);
+  }
+  // The live counts follow the nodes; everything else stays with the
+  // container that did the work.
+  void on_swap(const CountingStats &other) const {
+    std::swap(stats_.live_nodes, other.stats_.live_nodes);
+    std::swap(stats_.live_bytes, other.stats_.live_bytes);
+  }
+
+ private:
+  // Mutable so that the walks of const members can be counted.
+  mutable ContainerStats stats_;
+};
+
+// Totals over every container instrumented with CountingStats.
+inline ContainerStats global_stats() {
+  auto &global = detail::global_counters;
+  ContainerStats totals;
+  totals.allocations = global.allocations.load(std::memory_order_relaxed);
+  totals.frees = global.frees.load(std::memory_order_relaxed);
+  totals.live_nodes = global.live_nodes.load(std::memory_order_relaxed);
+  totals.peak_nodes = global.peak_nodes.load(std::memory_order_relaxed);
+  totals.live_bytes = global.live_bytes.load(std::memory_order_relaxed);
+  totals.peak_bytes = global.peak_bytes.load(std::memory_order_relaxed);
+  totals.hops = global.hops.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < static_cast<size_t>(Op::kCount); ++i) {
+    totals.ops[i] = global.ops[i].load(std::memory_order_relaxed);
+  }
+  return totals;
+}
+
+// Zeroes the totals, except for what is still live, which also becomes the
+// new peak.
+inline void reset_global_stats() {
+  auto &global = detail::global_counters;
+  global.allocations.store(0, std::memory_order_relaxed);
+  global.frees.store(0, std::memory_order_relaxed);
+  global.peak_nodes.store(global.live_nodes.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+  global.peak_bytes.store(global.live_bytes.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+  global.hops.store(0, std::memory_order_relaxed);
+  for (auto &count : global.ops) count.store(0, std::memory_order_relaxed);
+}
+}  // namespace m3mpm
+
+#endif  // SRC_M3MPM_STATS_H_
@@ -1,11 +1,35 @@
 #include <gtest/gtest.h>
 #include "containers.h"
 
+#include <algorithm>
+#include <atomic>
 #include <string>
 #include <list>
 #include <queue>
 #include <stack>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <version>
+#include <vector>
+
+// Without exceptions the library reports the same errors by printing them
+// and aborting, which the death tests observe instead.
+#if M3MPM_HAS_EXCEPTIONS
+#define EXPECT_FAILS(statement, exception) EXPECT_THROW(statement, exception)
+#define ASSERT_FAILS(statement, exception) ASSERT_THROW(statement, exception)
+#else
+#define EXPECT_FAILS(statement, exception) EXPECT_DEATH(statement, "m3mpm: ")
+#define ASSERT_FAILS(statement, exception) ASSERT_DEATH(statement, "m3mpm: ")
+#endif
 
 bool isEqual(double src1, double src2) {
     if (fabs(src1 - src2) < 1e-6) {
@@ -14,8 +38,8 @@ bool isEqual(double src1, double src2) {
     return false;
 }
 
-template <typename T>
-bool lists_eq(const m3mpm::List<T> &my_l, const std::list<T> &std_l) {
+template <typename T, typename Alloc>
+bool lists_eq(const m3mpm::List<T, Alloc> &my_l, const std::list<T> &std_l) {
   bool res = true;
   if (my_l.empty() != std_l.empty() && my_l.size() != std_l.size()) {
     res = false;
@@ -25,7 +49,7 @@ bool lists_eq(const m3mpm::List<T> &my_l, const std::list<T> &std_l) {
       res = false;
     }
 
-    typename m3mpm::List<T>::iterator my_it = my_l.cbegin();
+    typename m3mpm::List<T, Alloc>::iterator my_it = my_l.cbegin();
     typename std::list<T>::const_iterator std_it = std_l.cbegin();
 
     while (res && my_it != my_l.cend()) {
@@ -1736,6 +1760,2290 @@ TEST(stack_func, swap) {
     ASSERT_TRUE(eq_stack(q3, q2));
 }
 
+// thread cache allocator test
+
+TEST(thread_cache_allocator, list) {
+  m3mpm::List<int, m3mpm::ThreadCachingAllocator<int>> my_l{1, 2, 3};
+  std::list<int> std_l{1, 2, 3};
+  my_l.push_front(0);
+  std_l.push_front(0);
+  my_l.insert(++my_l.begin(), 7);
+  std_l.insert(++std_l.begin(), 7);
+  my_l.pop_back();
+  std_l.pop_back();
+  m3mpm::List<int, m3mpm::ThreadCachingAllocator<int>> my_copy(my_l);
+  ASSERT_EQ(my_copy.size(), std_l.size());
+  auto my_it = my_copy.begin();
+  for (int value : std_l) {
+    ASSERT_EQ(*my_it, value);
+    ++my_it;
+  }
+}
+
+TEST(thread_cache_allocator, stack_queue) {
+  m3mpm::Stack<std::string, m3mpm::ThreadCachingAllocator<std::string>> s1;
+  m3mpm::Queue<std::string, m3mpm::ThreadCachingAllocator<std::string>> q1;
+  std::stack<std::string> s2;
+  std::queue<std::string> q2;
+  for (int i = 0; i < 1000; ++i) {
+    s1.push(std::to_string(i));
+    s2.push(std::to_string(i));
+    q1.push(std::to_string(i));
+    q2.push(std::to_string(i));
+  }
+  ASSERT_TRUE(eq_stack(s1, s2));
+  ASSERT_TRUE(eq_queue(q1, q2));
+}
+
+TEST(thread_cache_allocator, reuses_freed_block) {
+  m3mpm::ThreadCachingAllocator<double> alloc;
+  double *first = alloc.allocate(1);
+  alloc.deallocate(first, 1);
+  double *second = alloc.allocate(1);
+  ASSERT_EQ(first, second);
+  alloc.deallocate(second, 1);
+}
+
+TEST(thread_cache_allocator, stack_pop_to_empty_then_push) {
+  m3mpm::Stack<int, m3mpm::ThreadCachingAllocator<int>> s1;
+  s1.push(1);
+  s1.pop();
+  s1.push(2);
+  ASSERT_EQ(s1.size(), 1);
+  ASSERT_EQ(s1.top(), 2);
+}
+
+TEST(thread_cache_allocator, cross_thread_queue) {
+  const int count = 100000;
+  m3mpm::Queue<long, m3mpm::ThreadCachingAllocator<long>> q1;
+  std::mutex mutex;
+  long sum = 0;
+  std::thread producer([&] {
+    for (int i = 1; i <= count; ++i) {
+      std::lock_guard<std::mutex> lock(mutex);
+      q1.push(i);
+    }
+  });
+  std::thread consumer([&] {
+    int popped = 0;
+    while (popped < count) {
+      std::lock_guard<std::mutex> lock(mutex);
+      while (!q1.empty()) {
+        sum += q1.front();
+        q1.pop();
+        ++popped;
+      }
+    }
+  });
+  producer.join();
+  consumer.join();
+  ASSERT_TRUE(q1.empty());
+  ASSERT_EQ(sum, static_cast<long>(count) * (count + 1) / 2);
+}
+
+TEST(thread_cache_allocator, nodes_outlive_thread) {
+  m3mpm::List<int, m3mpm::ThreadCachingAllocator<int>> my_l;
+  for (int round = 0; round < 4; ++round) {
+    std::thread producer([&] {
+      for (int i = 0; i < 5000; ++i) my_l.push_back(i);
+    });
+    producer.join();
+  }
+  ASSERT_EQ(my_l.size(), 20000);
+  long sum = 0;
+  while (!my_l.empty()) {
+    sum += my_l.front();
+    my_l.pop_front();
+  }
+  ASSERT_EQ(sum, 4L * 4999 * 5000 / 2);
+  for (int i = 0; i < 100; ++i) my_l.push_back(i);
+  ASSERT_EQ(my_l.back(), 99);
+}
+
+// Allocates and frees a node when its thread's thread_locals are destroyed.
+template <typename Alloc>
+struct LateAllocation {
+  ~LateAllocation() {
+    Alloc alloc;
+    auto *p = alloc.allocate(1);
+    *p = 1;
+    alloc.deallocate(p, 1);
+  }
+};
+
+TEST(thread_cache_allocator, allocation_after_thread_teardown) {
+  using alloc = m3mpm::ThreadCachingAllocator<long>;
+  for (int round = 0; round < 4; ++round) {
+    std::thread worker([] {
+      // Built before the pool's own thread_local, so destroyed after it.
+      static thread_local LateAllocation<alloc> late;
+      (void)late;
+      alloc a;
+      long *p = a.allocate(1);
+      a.deallocate(p, 1);
+    });
+    worker.join();
+  }
+  alloc a;
+  long *p = a.allocate(1);
+  a.deallocate(p, 1);
+}
+
+// huge page arena allocator test
+
+TEST(huge_page_allocator, containers) {
+  m3mpm::List<int, m3mpm::HugePageArenaAllocator<int>> my_l;
+  m3mpm::Queue<std::string, m3mpm::HugePageArenaAllocator<std::string>> q1;
+  m3mpm::Stack<double, m3mpm::HugePageArenaAllocator<double>> s1;
+  std::list<int> std_l;
+  std::queue<std::string> q2;
+  std::stack<double> s2;
+  for (int i = 0; i < 10000; ++i) {
+    my_l.push_front(i);
+    std_l.push_front(i);
+    q1.push(std::to_string(i));
+    q2.push(std::to_string(i));
+    s1.push(i * 0.5);
+    s2.push(i * 0.5);
+  }
+  my_l.sort();
+  std_l.sort();
+  ASSERT_TRUE(lists_eq(my_l, std_l));
+  ASSERT_TRUE(eq_queue(q1, q2));
+  ASSERT_TRUE(eq_stack(s1, s2));
+}
+
+TEST(huge_page_allocator, chunks_are_huge_page_aligned) {
+  void *chunk = m3mpm::HugePageArena::allocate_chunk();
+  uintptr_t address = reinterpret_cast<uintptr_t>(chunk);
+  ASSERT_EQ(address % m3mpm::HugePageArena::kChunkSize, 0);
+}
+
+TEST(huge_page_allocator, array_requests) {
+  m3mpm::HugePageArenaAllocator<long> alloc;
+  const size_t big = m3mpm::HugePageArena::kChunkSize / sizeof(long) + 1;
+  long *small = alloc.allocate(16);
+  long *large = alloc.allocate(big);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(large) %
+                m3mpm::HugePageArena::kChunkSize,
+            0);
+  small[15] = 1;
+  large[big - 1] = 2;
+  ASSERT_EQ(small[15] + large[big - 1], 3);
+  alloc.deallocate(small, 16);
+  alloc.deallocate(large, big);
+}
+
+TEST(huge_page_allocator, cross_thread_free) {
+  m3mpm::Queue<long, m3mpm::HugePageArenaAllocator<long>> q1;
+  std::thread producer([&] {
+    for (long i = 0; i < 50000; ++i) q1.push(i);
+  });
+  producer.join();
+  long sum = 0;
+  while (!q1.empty()) {
+    sum += q1.front();
+    q1.pop();
+  }
+  ASSERT_EQ(sum, 49999L * 50000 / 2);
+}
+
+TEST(huge_page_allocator, pipeline_memory_stays_bounded) {
+  // Some 80 000 nodes fit a chunk. Blocks the consumer frees must find
+  // their way back to the producer, or each million pushes takes a dozen.
+  const long count = 2000000;
+  m3mpm::Queue<long, m3mpm::HugePageArenaAllocator<long>> q1;
+  std::mutex mutex;
+  std::condition_variable changed;
+  const size_t chunks_before = m3mpm::HugePageArena::chunk_count();
+  std::thread producer([&] {
+    for (long i = 0; i < count; ++i) {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&q1] { return q1.size() < 1000; });
+      q1.push(i);
+      changed.notify_all();
+    }
+  });
+  long sum = 0;
+  for (long popped = 0; popped < count; ++popped) {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [&q1] { return !q1.empty(); });
+    sum += q1.front();
+    q1.pop();
+    changed.notify_all();
+  }
+  producer.join();
+  ASSERT_EQ(sum, (count - 1) * count / 2);
+  ASSERT_LE(m3mpm::HugePageArena::chunk_count() - chunks_before, 4);
+}
+
+TEST(huge_page_allocator, exiting_threads_hand_over_their_chunk) {
+  m3mpm::Stack<long, m3mpm::HugePageArenaAllocator<long>> s1;
+  const size_t chunks_before = m3mpm::HugePageArena::chunk_count();
+  for (int round = 0; round < 32; ++round) {
+    std::thread worker([&s1, round] { s1.push(round); });
+    worker.join();
+  }
+  ASSERT_EQ(s1.size(), 32);
+  ASSERT_EQ(s1.top(), 31);
+  ASSERT_LE(m3mpm::HugePageArena::chunk_count() - chunks_before, 1);
+}
+
+// list compact test
+
+template <typename List>
+void churn(List *my_l, std::list<int> *std_l, int rounds) {
+  std::mt19937 gen(42);
+  for (int i = 0; i < rounds; ++i) {
+    size_t pos = my_l->empty() ? 0 : gen() % my_l->size();
+    auto my_it = my_l->begin();
+    auto std_it = std_l->begin();
+    for (size_t k = 0; k < pos; ++k) {
+      ++my_it;
+      ++std_it;
+    }
+    if (gen() % 3 == 0 && !my_l->empty()) {
+      my_l->erase(my_it);
+      std_l->erase(std_it);
+    } else {
+      my_l->insert(my_it, i);
+      std_l->insert(std_it, i);
+    }
+  }
+}
+
+TEST(list_CompactTests, compact) {
+  m3mpm::List<int> my_l;
+  std::list<int> std_l;
+  churn(&my_l, &std_l, 3000);
+  ASSERT_GT(my_l.fragmentation(), 0.5);
+  my_l.compact();
+  ASSERT_EQ(my_l.fragmentation(), 0.0);
+  ASSERT_EQ(my_l.size(), std_l.size());
+  ASSERT_TRUE(lists_eq(my_l, std_l));
+  ASSERT_EQ((++my_l.begin()).pNode_, my_l.begin().pNode_ + 1);
+}
+
+TEST(list_CompactTests, churn_after_compact) {
+  m3mpm::List<std::string> my_l{"a", "b", "c", "d"};
+  std::list<std::string> std_l{"a", "b", "c", "d"};
+  my_l.compact();
+  my_l.erase(++my_l.begin());
+  std_l.erase(++std_l.begin());
+  my_l.push_front("e");
+  std_l.push_front("e");
+  my_l.compact();
+  my_l.pop_back();
+  std_l.pop_back();
+  ASSERT_TRUE(lists_eq(my_l, std_l));
+  while (!my_l.empty()) my_l.pop_front();
+  my_l.push_back("f");
+  ASSERT_EQ(my_l.front(), "f");
+}
+
+TEST(list_CompactTests, move_and_swap) {
+  m3mpm::List<int> my_l1;
+  std::list<int> std_l;
+  churn(&my_l1, &std_l, 500);
+  my_l1.compact();
+  m3mpm::List<int> my_l2(std::move(my_l1));
+  ASSERT_TRUE(lists_eq(my_l2, std_l));
+  m3mpm::List<int> my_l3{1, 2, 3};
+  my_l3.swap(my_l2);
+  ASSERT_TRUE(lists_eq(my_l3, std_l));
+  my_l3.clear();
+  ASSERT_TRUE(my_l3.empty());
+}
+
+TEST(list_CompactTests, compact_empty_and_arena) {
+  m3mpm::List<int> my_l1;
+  my_l1.compact();
+  ASSERT_TRUE(my_l1.empty());
+  ASSERT_EQ(my_l1.fragmentation(), 0.0);
+
+  m3mpm::List<int, m3mpm::HugePageArenaAllocator<int>> my_l2;
+  std::list<int> std_l;
+  churn(&my_l2, &std_l, 1000);
+  my_l2.compact();
+  ASSERT_EQ(my_l2.fragmentation(), 0.0);
+  ASSERT_TRUE(lists_eq(my_l2, std_l));
+}
+
+// list bulk visitation test
+
+TEST(list_VisitTests, for_each) {
+  m3mpm::List<int> my_l{1, 2, 3, 4, 5};
+  my_l.for_each([](int &value) { value *= 10; });
+  std::list<int> std_l{10, 20, 30, 40, 50};
+  ASSERT_TRUE(lists_eq(my_l, std_l));
+
+  const m3mpm::List<int> &const_l = my_l;
+  int sum = 0;
+  const_l.for_each([&sum](const int &value) { sum += value; });
+  ASSERT_EQ(sum, 150);
+
+  m3mpm::List<int> empty_l;
+  empty_l.for_each([](int &) { FAIL(); });
+}
+
+TEST(list_VisitTests, for_each_chunk) {
+  m3mpm::List<long> my_l;
+  for (long i = 1; i <= 1000; ++i) my_l.push_back(i);
+  std::vector<size_t> counts;
+  long sum = 0;
+  my_l.for_each_chunk<64>([&](long *const *items, size_t count) {
+    counts.push_back(count);
+    for (size_t i = 0; i < count; ++i) sum += *items[i];
+  });
+  ASSERT_EQ(sum, 500500);
+  ASSERT_EQ(counts.size(), 16);
+  ASSERT_EQ(counts.back(), 1000 - 15 * 64);
+
+  const m3mpm::List<long> &const_l = my_l;
+  long last = 0;
+  bool ordered = true;
+  const_l.for_each_chunk<7>([&](const long *const *items, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      ordered = ordered && *items[i] == last + 1;
+      last = *items[i];
+    }
+  });
+  ASSERT_TRUE(ordered);
+  ASSERT_EQ(last, 1000);
+}
+
+TEST(list_IndexTests, at_follows_churn) {
+  m3mpm::List<int> my_l;
+  std::vector<int> std_v;
+  for (int i = 0; i < 500; ++i) {
+    my_l.push_back(i);
+    std_v.push_back(i);
+  }
+  ASSERT_FALSE(my_l.indexed());
+  ASSERT_EQ(my_l.at(250), 250);
+  ASSERT_TRUE(my_l.indexed());
+
+  std::mt19937 gen(31);
+  for (int round = 0; round < 5000; ++round) {
+    size_t pos = gen() % (std_v.size() + 1);
+    switch (gen() % 6) {
+      case 0:
+        my_l.push_front(round);
+        std_v.insert(std_v.begin(), round);
+        break;
+      case 1:
+        my_l.push_back(round);
+        std_v.push_back(round);
+        break;
+      case 2:
+        my_l.insert(my_l.advance(my_l.begin(), pos), round);
+        std_v.insert(std_v.begin() + pos, round);
+        break;
+      default:
+        if (std_v.empty()) break;
+        pos %= std_v.size();
+        my_l.erase(my_l.advance(my_l.begin(), pos));
+        std_v.erase(std_v.begin() + pos);
+    }
+    if (!std_v.empty()) {
+      size_t probe = gen() % std_v.size();
+      ASSERT_EQ(my_l.at(probe), std_v[probe]);
+    }
+  }
+  ASSERT_TRUE(my_l.indexed());
+  for (size_t i = 0; i < std_v.size(); ++i) ASSERT_EQ(my_l.at(i), std_v[i]);
+  ASSERT_FAILS(my_l.at(std_v.size()), std::out_of_range);
+}
+
+TEST(list_IndexTests, advance) {
+  m3mpm::List<int> my_l;
+  for (int i = 0; i < 100; ++i) my_l.push_back(i);
+  auto it = my_l.advance(my_l.begin(), 40);
+  ASSERT_EQ(*it, 40);
+  ASSERT_EQ(*my_l.advance(it, -15), 25);
+  ASSERT_EQ(*my_l.advance(it, 59), 99);
+  ASSERT_TRUE(my_l.advance(it, 60) == my_l.end());
+  ASSERT_EQ(*my_l.advance(my_l.end(), -1), 99);
+  ASSERT_TRUE(my_l.advance(my_l.end(), -100) == my_l.begin());
+  ASSERT_FAILS(my_l.advance(it, 61), std::out_of_range);
+  ASSERT_FAILS(my_l.advance(it, -41), std::out_of_range);
+
+  const m3mpm::List<int> &const_l = my_l;
+  ASSERT_EQ(const_l.at(7), 7);
+}
+
+TEST(list_IndexTests, lower_bound) {
+  m3mpm::List<int> book;
+  ASSERT_TRUE(book.lower_bound(5) == book.end());
+  std::multiset<int> std_s;
+  std::mt19937 gen(42);
+  for (int i = 0; i < 3000; ++i) {
+    int price = static_cast<int>(gen() % 1000);
+    book.insert(book.lower_bound(price), price);
+    std_s.insert(price);
+    if (i % 3 == 0) {
+      int gone = static_cast<int>(gen() % 1000);
+      auto found = book.lower_bound(gone);
+      if (found != book.end() && *found == gone) {
+        book.erase(found);
+        std_s.erase(std_s.find(gone));
+      }
+    }
+  }
+  ASSERT_EQ(book.size(), std_s.size());
+  ASSERT_TRUE(std::equal(std_s.begin(), std_s.end(), book.begin()));
+  for (int price = -1; price <= 1001; ++price) {
+    auto expected = std_s.lower_bound(price);
+    auto found = book.lower_bound(price);
+    if (expected == std_s.end()) {
+      ASSERT_TRUE(found == book.end());
+    } else {
+      ASSERT_EQ(*found, *expected);
+    }
+  }
+}
+
+TEST(list_IndexTests, survives_whole_list_operations) {
+  m3mpm::List<int> my_l{5, 3, 9, 1, 7};
+  ASSERT_EQ(my_l.at(2), 9);
+  my_l.sort();
+  ASSERT_EQ(my_l.at(2), 5);
+  my_l.reverse();
+  ASSERT_EQ(my_l.at(0), 9);
+  my_l.compact();
+  ASSERT_FALSE(my_l.indexed());
+  ASSERT_EQ(my_l.at(4), 1);
+
+  m3mpm::List<int> other{1, 2};
+  ASSERT_EQ(other.at(1), 2);
+  my_l.swap(other);
+  ASSERT_EQ(my_l.at(1), 2);
+  ASSERT_EQ(other.at(3), 3);
+  other.push_front(10);
+  ASSERT_EQ(other.at(0), 10);
+
+  m3mpm::List<int> moved(std::move(other));
+  ASSERT_TRUE(moved.indexed());
+  ASSERT_EQ(moved.at(5), 1);
+  ASSERT_EQ(*--moved.end(), 1);
+  ASSERT_EQ(*++moved.end(), 10);
+  moved.clear();
+  ASSERT_FALSE(moved.indexed());
+  moved.push_back(4);
+  ASSERT_EQ(moved.at(0), 4);
+  ASSERT_FAILS(moved.at(1), std::out_of_range);
+}
+
+TEST(list_IndexTests, concurrent_const_lookups) {
+  // Readers of a shared const list race to build the index; run under
+  // ThreadSanitizer (make test_tsan) to check the build is published safely.
+  for (int round = 0; round < 20; ++round) {
+    m3mpm::List<int> my_l;
+    for (int i = 0; i < 5000; ++i) my_l.push_back(i);
+    const m3mpm::List<int> &shared = my_l;
+    std::vector<std::thread> readers;
+    std::atomic<long> sum{0};
+    for (int t = 0; t < 4; ++t) {
+      readers.emplace_back([&shared, &sum, t] {
+        long local = 0;
+        for (size_t pos = t; pos < shared.size(); pos += 97) {
+          local += shared.at(pos);
+        }
+        sum += local;
+      });
+    }
+    for (auto &reader : readers) reader.join();
+    long expected = 0;
+    for (int t = 0; t < 4; ++t) {
+      for (long pos = t; pos < 5000; pos += 97) expected += pos;
+    }
+    ASSERT_EQ(sum.load(), expected);
+    ASSERT_TRUE(my_l.indexed());
+  }
+}
+
+// compact list test
+
+template <typename T>
+bool compact_eq(const m3mpm::CompactList<T> &my_l, const std::list<T> &std_l) {
+  if (my_l.size() != std_l.size()) return false;
+  auto std_it = std_l.begin();
+  for (auto my_it = my_l.cbegin(); my_it != my_l.cend(); ++my_it, ++std_it) {
+    if (*my_it != *std_it) return false;
+  }
+  return true;
+}
+
+TEST(compact_list, push_pop) {
+  m3mpm::CompactList<int> my_l;
+  std::list<int> std_l;
+  ASSERT_TRUE(my_l.empty());
+  ASSERT_TRUE(my_l.begin() == my_l.end());
+  for (int i = 0; i < 100; ++i) {
+    my_l.push_back(i);
+    my_l.push_front(-i);
+    std_l.push_back(i);
+    std_l.push_front(-i);
+  }
+  ASSERT_TRUE(compact_eq(my_l, std_l));
+  for (int i = 0; i < 30; ++i) {
+    my_l.pop_back();
+    my_l.pop_front();
+    std_l.pop_back();
+    std_l.pop_front();
+  }
+  ASSERT_TRUE(compact_eq(my_l, std_l));
+  ASSERT_EQ(my_l.front(), std_l.front());
+  ASSERT_EQ(my_l.back(), std_l.back());
+  my_l.clear();
+  ASSERT_TRUE(my_l.empty());
+  EXPECT_FAILS(my_l.pop_front(), std::range_error);
+  EXPECT_FAILS(my_l.front(), std::range_error);
+}
+
+TEST(compact_list, insert_erase_reuses_slots) {
+  m3mpm::CompactList<std::string> my_l{"a", "b", "c"};
+  std::list<std::string> std_l{"a", "b", "c"};
+  size_t capacity = my_l.capacity();
+  auto my_it = my_l.insert(++my_l.begin(), "x");
+  std_l.insert(++std_l.begin(), "x");
+  ASSERT_EQ(*my_it, "x");
+  my_l.erase(my_l.begin());
+  std_l.erase(std_l.begin());
+  my_l.push_back(my_l.front());
+  std_l.push_back(std_l.front());
+  ASSERT_TRUE(compact_eq(my_l, std_l));
+  ASSERT_GE(my_l.capacity(), capacity);
+  EXPECT_FAILS(my_l.erase(my_l.end()), std::range_error);
+}
+
+TEST(compact_list, handles_are_stable) {
+  m3mpm::CompactList<int> my_l;
+  my_l.push_back(0);
+  auto h = my_l.handle(my_l.cbegin());
+  for (int i = 0; i < 1000; ++i) my_l.push_front(1000 - i);
+  ASSERT_EQ(my_l.get(h), 0);
+  my_l.sort();
+  ASSERT_EQ(my_l.get(h), 0);
+  ASSERT_TRUE(my_l.find(h) == my_l.begin());
+  ASSERT_EQ(*++my_l.find(h), 1);
+  my_l.reverse();
+  ASSERT_EQ(*--my_l.find(h), 1);
+  ASSERT_TRUE(++my_l.find(h) == my_l.end());
+}
+
+TEST(compact_list, sort_unique_reverse) {
+  std::mt19937 gen(5);
+  m3mpm::CompactList<int> my_l;
+  std::list<int> std_l;
+  for (int i = 0; i < 5000; ++i) {
+    int value = static_cast<int>(gen() % 100);
+    my_l.push_back(value);
+    std_l.push_back(value);
+  }
+  my_l.sort();
+  std_l.sort();
+  ASSERT_TRUE(compact_eq(my_l, std_l));
+  my_l.unique();
+  std_l.unique();
+  ASSERT_TRUE(compact_eq(my_l, std_l));
+  my_l.reverse();
+  std_l.reverse();
+  ASSERT_TRUE(compact_eq(my_l, std_l));
+}
+
+TEST(compact_list, merge_splice) {
+  m3mpm::CompactList<int> my_l1{1, 3, 5, 7};
+  m3mpm::CompactList<int> my_l2{2, 3, 6, 8, 9};
+  std::list<int> std_l1{1, 3, 5, 7};
+  std::list<int> std_l2{2, 3, 6, 8, 9};
+  my_l1.merge(my_l2);
+  std_l1.merge(std_l2);
+  ASSERT_TRUE(compact_eq(my_l1, std_l1));
+  ASSERT_TRUE(my_l2.empty());
+
+  m3mpm::CompactList<int> my_l3{10, 20};
+  std::list<int> std_l3{10, 20};
+  my_l1.splice(++my_l1.cbegin(), my_l3);
+  std_l1.splice(++std_l1.cbegin(), std_l3);
+  ASSERT_TRUE(compact_eq(my_l1, std_l1));
+  ASSERT_TRUE(my_l3.empty());
+}
+
+TEST(compact_list, copy_move_emplace) {
+  m3mpm::CompactList<std::string> my_l1{"one", "two"};
+  m3mpm::CompactList<std::string> my_l2(my_l1);
+  m3mpm::CompactList<std::string> my_l3(std::move(my_l1));
+  ASSERT_TRUE(my_l1.empty());
+  my_l1.push_back("again");
+  ASSERT_EQ(my_l1.front(), "again");
+  my_l2.emplace_back("three", "four");
+  my_l2.emplace_front("zero");
+  auto it = my_l2.emplace(++my_l2.cbegin(), "half");
+  ASSERT_EQ(*it, "half");
+  std::list<std::string> std_l{"zero", "half", "one", "two", "three", "four"};
+  ASSERT_TRUE(compact_eq(my_l2, std_l));
+  my_l3 = my_l2;
+  ASSERT_TRUE(compact_eq(my_l3, std_l));
+}
+
+#if M3MPM_HAS_EXCEPTIONS
+// Copies until its budget runs out; having no move constructor, it is
+// copied whenever the list grows.
+struct CopyBudget {
+  static int budget;
+  static int live;
+  int value;
+  explicit CopyBudget(int v) : value(v) { ++live; }
+  CopyBudget(const CopyBudget &other) : value(other.value) {
+    if (budget-- == 0) throw std::runtime_error("copy budget");
+    ++live;
+  }
+  ~CopyBudget() {
+    value = -1;
+    --live;
+  }
+};
+int CopyBudget::budget = -1;
+int CopyBudget::live = 0;
+
+TEST(compact_list, failed_growth_leaves_list_unchanged) {
+  {
+    m3mpm::CompactList<CopyBudget> my_l;
+    while (my_l.size() < 4 || my_l.size() < my_l.capacity()) {
+      my_l.emplace_back(static_cast<int>(my_l.size()));
+    }
+    int size = static_cast<int>(my_l.size());
+    // The copy of the new value succeeds, then growth fails midway.
+    CopyBudget::budget = 3;
+    ASSERT_THROW(my_l.emplace_back(size), std::runtime_error);
+    CopyBudget::budget = -1;
+    ASSERT_EQ(CopyBudget::live, size);
+    ASSERT_EQ(static_cast<int>(my_l.size()), size);
+    int expected = 0;
+    for (const CopyBudget &item : my_l) ASSERT_EQ(item.value, expected++);
+    my_l.emplace_back(size);
+    ASSERT_EQ(my_l.back().value, size);
+  }
+  ASSERT_EQ(CopyBudget::live, 0);
+}
+#endif
+
+// sorted list test
+
+template <typename T, typename Compare, typename StdCompare>
+bool sorted_eq(const m3mpm::SortedList<T, Compare> &my_l,
+               const std::multiset<T, StdCompare> &std_s) {
+  if (my_l.size() != std_s.size()) return false;
+  if (!std::equal(std_s.begin(), std_s.end(), my_l.begin())) return false;
+  auto it = my_l.end();
+  for (auto rit = std_s.rbegin(); rit != std_s.rend(); ++rit) {
+    if (*--it != *rit) return false;
+  }
+  return it == my_l.begin();
+}
+
+TEST(sorted_list, insert_erase_against_multiset) {
+  m3mpm::SortedList<int> my_l;
+  std::multiset<int> std_s;
+  ASSERT_TRUE(my_l.begin() == my_l.end());
+  ASSERT_TRUE(my_l.find(3) == my_l.end());
+  std::mt19937 gen(32);
+  for (int round = 0; round < 20000; ++round) {
+    int value = static_cast<int>(gen() % 500);
+    if (gen() % 3 != 0) {
+      ASSERT_EQ(*my_l.insert(value), value);
+      std_s.insert(value);
+    } else {
+      auto found = my_l.find(value);
+      auto std_found = std_s.find(value);
+      ASSERT_EQ(found == my_l.end(), std_found == std_s.end());
+      if (std_found != std_s.end()) {
+        my_l.erase(found);
+        std_s.erase(std_found);
+      }
+    }
+  }
+  ASSERT_TRUE(sorted_eq(my_l, std_s));
+  ASSERT_EQ(my_l.front(), *std_s.begin());
+  ASSERT_EQ(my_l.back(), *std_s.rbegin());
+  for (int value = -1; value <= 501; ++value) {
+    auto lower = my_l.lower_bound(value);
+    auto upper = my_l.upper_bound(value);
+    auto std_lower = std_s.lower_bound(value);
+    auto std_upper = std_s.upper_bound(value);
+    ASSERT_EQ(lower == my_l.end(), std_lower == std_s.end());
+    if (std_lower != std_s.end()) {
+      ASSERT_EQ(*lower, *std_lower);
+    }
+    ASSERT_EQ(upper == my_l.end(), std_upper == std_s.end());
+    if (std_upper != std_s.end()) {
+      ASSERT_EQ(*upper, *std_upper);
+    }
+    ASSERT_EQ(my_l.count(value), std_s.count(value));
+  }
+  size_t erased = my_l.erase(*my_l.begin());
+  ASSERT_EQ(erased, std_s.erase(*std_s.begin()));
+  ASSERT_TRUE(sorted_eq(my_l, std_s));
+}
+
+TEST(sorted_list, equal_elements_keep_insertion_order) {
+  using Item = std::pair<int, int>;
+  auto by_key = [](const Item &a, const Item &b) { return a.first < b.first; };
+  m3mpm::SortedList<Item, decltype(by_key)> my_l(by_key);
+  for (int i = 0; i < 300; ++i) my_l.insert({i % 3, i});
+  int last_key = 0;
+  int last_seq = -1;
+  for (auto it = my_l.begin(); it != my_l.end(); ++it) {
+    if ((*it).first != last_key) {
+      ASSERT_EQ((*it).first, last_key + 1);
+      last_key = (*it).first;
+      last_seq = -1;
+    }
+    ASSERT_GT((*it).second, last_seq);
+    last_seq = (*it).second;
+  }
+  // Erasing from the middle of a run of equal keys hits exactly that one.
+  auto it = my_l.lower_bound({1, 0});
+  for (int i = 0; i < 50; ++i) ++it;
+  int seq = (*it).second;
+  my_l.erase(it);
+  ASSERT_EQ(my_l.count({1, 0}), 99);
+  for (it = my_l.begin(); it != my_l.end(); ++it) ASSERT_NE((*it).second, seq);
+}
+
+TEST(sorted_list, pop_and_throw) {
+  m3mpm::SortedList<int> my_l{5, 1, 4, 2, 3};
+  my_l.pop_front();
+  my_l.pop_back();
+  std::multiset<int> std_s{2, 3, 4};
+  ASSERT_TRUE(sorted_eq(my_l, std_s));
+  if (m3mpm::kCheckedIterators) {
+    ASSERT_FAILS(*my_l.end(), std::logic_error);
+  }
+  ASSERT_FAILS(my_l.erase(my_l.end()), std::range_error);
+  my_l.clear();
+  ASSERT_TRUE(my_l.empty());
+  ASSERT_FAILS(my_l.front(), std::range_error);
+  ASSERT_FAILS(my_l.pop_back(), std::range_error);
+  my_l.insert(7);
+  ASSERT_EQ(my_l.front(), 7);
+}
+
+#if M3MPM_HAS_EXCEPTIONS
+// Throws from the comparison that exhausts its budget.
+struct BudgetLess {
+  static inline long budget = -1;
+  bool operator()(const std::string &a, const std::string &b) const {
+    if (budget-- == 0) throw std::runtime_error("comparison");
+    return a < b;
+  }
+};
+
+TEST(sorted_list, throwing_comparison_leaves_list_unchanged) {
+  m3mpm::SortedList<std::string, BudgetLess> my_l{"b", "d", "a", "c"};
+  std::multiset<std::string> std_s{"a", "b", "c", "d"};
+  // Before the front, in the middle and past the back.
+  for (const char *value : {"0", "bb", "x"}) {
+    BudgetLess::budget = 0;
+    ASSERT_THROW(my_l.emplace(value), std::runtime_error);
+    BudgetLess::budget = -1;
+    ASSERT_TRUE(sorted_eq(my_l, std_s));
+  }
+  my_l.emplace("e");
+  ASSERT_EQ(my_l.back(), "e");
+}
+#endif
+
+TEST(sorted_list, copy_move_swap) {
+  m3mpm::SortedList<std::string, std::greater<std::string>> my_l{
+      "b", "d", "a", "c"};
+  std::multiset<std::string, std::greater<std::string>> std_s{"b", "d", "a",
+                                                               "c"};
+  auto copy = my_l;
+  ASSERT_TRUE(sorted_eq(copy, std_s));
+  copy.insert("e");
+  ASSERT_EQ(copy.front(), "e");
+  ASSERT_EQ(copy.find("b") != copy.end(), true);
+  ASSERT_TRUE(sorted_eq(my_l, std_s));
+
+  auto moved = std::move(copy);
+  ASSERT_EQ(moved.size(), 5);
+  ASSERT_TRUE(copy.empty());
+  copy.emplace("z");
+  ASSERT_EQ(copy.front(), "z");
+
+  moved.swap(my_l);
+  ASSERT_EQ(my_l.size(), 5);
+  ASSERT_TRUE(sorted_eq(moved, std_s));
+  moved = my_l;
+  ASSERT_EQ(moved.size(), 5);
+  ASSERT_EQ(moved.back(), "a");
+}
+
+// iterator conformance test
+
+template <typename It>
+constexpr bool is_bidirectional() {
+  using traits = std::iterator_traits<It>;
+  return std::is_same_v<typename traits::iterator_category,
+                        std::bidirectional_iterator_tag> &&
+         std::is_signed_v<typename traits::difference_type>;
+}
+
+static_assert(is_bidirectional<m3mpm::List<int>::iterator>());
+static_assert(is_bidirectional<m3mpm::List<int>::const_iterator>());
+static_assert(is_bidirectional<m3mpm::CompactList<int>::iterator>());
+static_assert(is_bidirectional<m3mpm::CompactList<int>::const_iterator>());
+static_assert(is_bidirectional<m3mpm::SortedList<int>::iterator>());
+static_assert(std::is_same_v<
+              decltype(*std::declval<m3mpm::List<int>::const_iterator>()),
+              const int &>);
+#if defined(__cpp_lib_concepts)
+static_assert(std::bidirectional_iterator<m3mpm::List<int>::iterator>);
+static_assert(std::bidirectional_iterator<m3mpm::List<int>::const_iterator>);
+static_assert(std::bidirectional_iterator<m3mpm::CompactList<int>::iterator>);
+static_assert(
+    std::bidirectional_iterator<m3mpm::CompactList<int>::const_iterator>);
+static_assert(std::bidirectional_iterator<m3mpm::SortedList<int>::iterator>);
+#endif
+
+TEST(iterators, list_std_algorithms) {
+  m3mpm::List<int> my_l{4, 8, 15, 16, 23, 42};
+  ASSERT_EQ(std::distance(my_l.begin(), my_l.end()), 6);
+  ASSERT_EQ(*std::find(my_l.begin(), my_l.end(), 16), 16);
+  ASSERT_EQ(std::count_if(my_l.begin(), my_l.end(),
+                          [](int v) { return v % 2 == 0; }),
+            4);
+  ASSERT_EQ(std::accumulate(my_l.cbegin(), my_l.cend(), 0), 108);
+  ASSERT_EQ(*std::max_element(my_l.begin(), my_l.end()), 42);
+  ASSERT_EQ(*std::prev(my_l.end()), 42);
+  ASSERT_EQ(*std::next(my_l.begin(), 2), 15);
+
+  std::reverse(my_l.begin(), my_l.end());
+  std::vector<int> reversed(my_l.begin(), my_l.end());
+  ASSERT_EQ(reversed, (std::vector<int>{42, 23, 16, 15, 8, 4}));
+  std::vector<int> backwards(
+      std::make_reverse_iterator(my_l.cend()),
+      std::make_reverse_iterator(my_l.cbegin()));
+  ASSERT_EQ(backwards, (std::vector<int>{4, 8, 15, 16, 23, 42}));
+  std::fill(my_l.begin(), my_l.end(), 7);
+  ASSERT_TRUE(std::all_of(my_l.cbegin(), my_l.cend(),
+                          [](int v) { return v == 7; }));
+}
+
+TEST(iterators, postfix_and_arrow) {
+  m3mpm::List<std::string> my_l{"a", "bb", "ccc"};
+  auto it = my_l.begin();
+  ASSERT_EQ(it->size(), 1);
+  auto old = it++;
+  ASSERT_EQ(*old, "a");
+  ASSERT_EQ(it->size(), 2);
+  it->append("b");
+  ASSERT_EQ(*it--, "bbb");
+  ASSERT_EQ(*it, "a");
+
+  m3mpm::List<std::string>::const_iterator cit = my_l.begin();
+  ASSERT_TRUE(cit == my_l.begin());
+  ASSERT_EQ((++cit)->size(), 3);
+  ASSERT_EQ((cit--)->size(), 3);
+  ASSERT_EQ(*cit, "a");
+}
+
+TEST(iterators, other_lists) {
+  m3mpm::CompactList<int> compact_l{3, 1, 2};
+  ASSERT_EQ(std::distance(compact_l.begin(), compact_l.end()), 3);
+  std::replace(compact_l.begin(), compact_l.end(), 1, 10);
+  ASSERT_EQ(std::accumulate(compact_l.cbegin(), compact_l.cend(), 0), 15);
+  auto compact_it = compact_l.end();
+  compact_it--;
+  ASSERT_EQ(*compact_it--, 2);
+  ASSERT_EQ(*compact_it, 10);
+
+  m3mpm::SortedList<std::string> sorted_l{"pear", "fig", "apple"};
+  ASSERT_TRUE(std::is_sorted(sorted_l.begin(), sorted_l.end()));
+  auto sorted_it = sorted_l.begin();
+  ASSERT_EQ((sorted_it++)->size(), 5);
+  ASSERT_EQ(sorted_it->size(), 3);
+  std::vector<std::string> backwards(
+      std::make_reverse_iterator(sorted_l.end()),
+      std::make_reverse_iterator(sorted_l.begin()));
+  ASSERT_EQ(backwards.front(), "pear");
+}
+
+TEST(iterators, checked_mode) {
+  if (!m3mpm::kCheckedIterators) GTEST_SKIP();
+  m3mpm::List<int>::iterator empty_it;
+  ASSERT_FAILS(*empty_it, std::logic_error);
+  ASSERT_FAILS(++empty_it, std::logic_error);
+  ASSERT_FAILS(empty_it--, std::logic_error);
+  m3mpm::CompactList<int>::iterator compact_it;
+  ASSERT_FAILS(++compact_it, std::logic_error);
+  m3mpm::CompactList<int> compact_l{1, 2};
+  ASSERT_FAILS(*compact_l.end(), std::logic_error);
+  ASSERT_FAILS(*compact_l.cend(), std::logic_error);
+  m3mpm::SortedList<int> sorted_l;
+  ASSERT_FAILS(*sorted_l.begin(), std::logic_error);
+}
+
+TEST(iterators, list_end_is_the_sentinel_element) {
+  // Checked or not, List's end() dereferences to the sentinel's
+  // value-initialized element, which front() returns for an empty list.
+  m3mpm::List<std::string> my_l;
+  ASSERT_EQ(*my_l.end(), std::string());
+  ASSERT_EQ(&*my_l.end(), &my_l.front());
+  my_l.push_back("one");
+  ASSERT_EQ(*my_l.cend(), std::string());
+  ASSERT_EQ(*--my_l.end(), "one");
+}
+
+TEST(try_api, stack_and_queue) {
+  m3mpm::Stack<std::string> my_s;
+  std::string out = "untouched";
+  ASSERT_EQ(my_s.try_top(), nullptr);
+  ASSERT_FALSE(my_s.try_pop(out));
+  ASSERT_FALSE(my_s.try_pop().has_value());
+  ASSERT_EQ(out, "untouched");
+  my_s.push("a");
+  my_s.push("b");
+  ASSERT_EQ(*my_s.try_top(), "b");
+  ASSERT_TRUE(my_s.try_pop(out));
+  ASSERT_EQ(out, "b");
+  ASSERT_EQ(my_s.try_pop(), std::optional<std::string>("a"));
+  ASSERT_TRUE(my_s.empty());
+
+  m3mpm::Queue<std::string> my_q;
+  ASSERT_EQ(my_q.try_front(), nullptr);
+  ASSERT_EQ(my_q.try_back(), nullptr);
+  ASSERT_FALSE(my_q.try_pop(out));
+  ASSERT_FALSE(my_q.try_pop().has_value());
+  ASSERT_FAILS(my_q.front(), std::logic_error);
+  ASSERT_FAILS(my_q.back(), std::logic_error);
+  my_q.push("a");
+  my_q.push("b");
+  ASSERT_EQ(*my_q.try_front(), "a");
+  ASSERT_EQ(*my_q.try_back(), "b");
+  ASSERT_TRUE(my_q.try_pop(out));
+  ASSERT_EQ(out, "a");
+  ASSERT_EQ(*my_q.try_pop(), "b");
+  ASSERT_TRUE(my_q.empty());
+  ASSERT_EQ(my_q.try_front(), nullptr);
+}
+
+template <typename L>
+void check_try_list(L &my_l) {
+  int out = -1;
+  ASSERT_EQ(my_l.try_front(), nullptr);
+  ASSERT_EQ(my_l.try_back(), nullptr);
+  ASSERT_FALSE(my_l.try_pop_front(out));
+  ASSERT_FALSE(my_l.try_pop_back(out));
+  ASSERT_FALSE(my_l.try_pop_front().has_value());
+  ASSERT_FALSE(my_l.try_pop_back().has_value());
+  ASSERT_EQ(out, -1);
+  for (int i = 1; i <= 4; ++i) my_l.push_back(i);
+  ASSERT_EQ(*my_l.try_front(), 1);
+  ASSERT_EQ(*my_l.try_back(), 4);
+  ASSERT_TRUE(my_l.try_pop_front(out));
+  ASSERT_EQ(out, 1);
+  ASSERT_TRUE(my_l.try_pop_back(out));
+  ASSERT_EQ(out, 4);
+  ASSERT_EQ(my_l.try_pop_front(), std::optional<int>(2));
+  ASSERT_EQ(my_l.try_pop_back(), std::optional<int>(3));
+  ASSERT_TRUE(my_l.empty());
+  ASSERT_EQ(my_l.try_back(), nullptr);
+}
+
+TEST(try_api, lists) {
+  m3mpm::List<int> my_l;
+  check_try_list(my_l);
+  m3mpm::CompactList<int> compact_l;
+  check_try_list(compact_l);
+}
+
+TEST(try_api, sorted_list) {
+  m3mpm::SortedList<int> sorted_l;
+  int out = -1;
+  ASSERT_EQ(sorted_l.try_front(), nullptr);
+  ASSERT_FALSE(sorted_l.try_pop_front(out));
+  ASSERT_FALSE(sorted_l.try_pop_back().has_value());
+  std::mt19937 gen(5);
+  std::multiset<int> std_s;
+  for (int i = 0; i < 500; ++i) {
+    int value = static_cast<int>(gen() % 50);
+    sorted_l.insert(value);
+    std_s.insert(value);
+  }
+  while (!std_s.empty()) {
+    ASSERT_EQ(*sorted_l.try_front(), *std_s.begin());
+    ASSERT_EQ(*sorted_l.try_back(), *std_s.rbegin());
+    if (std_s.size() % 2) {
+      ASSERT_TRUE(sorted_l.try_pop_front(out));
+      ASSERT_EQ(out, *std_s.begin());
+      std_s.erase(std_s.begin());
+    } else {
+      ASSERT_EQ(sorted_l.try_pop_back(), *std_s.rbegin());
+      std_s.erase(std::prev(std_s.end()));
+    }
+    ASSERT_EQ(sorted_l.size(), std_s.size());
+    ASSERT_TRUE(std::equal(sorted_l.begin(), sorted_l.end(), std_s.begin()));
+  }
+  ASSERT_EQ(sorted_l.try_back(), nullptr);
+}
+
+// Larger than a node's links and without a default constructor.
+struct Payload {
+  explicit Payload(int v) : value(v) {}
+  int value;
+  char pad[256];
+};
+
+TEST(container_layout, three_words) {
+  static_assert(sizeof(m3mpm::Stack<Payload>) == 3 * sizeof(void *));
+  static_assert(sizeof(m3mpm::Queue<Payload>) == 3 * sizeof(void *));
+  static_assert(sizeof(m3mpm::Stack<char>) == 3 * sizeof(void *));
+  m3mpm::Stack<Payload> my_s;
+  my_s.push(Payload(1));
+  my_s.push(Payload(2));
+  ASSERT_EQ(my_s.top().value, 2);
+  my_s.pop();
+  ASSERT_EQ(my_s.try_top()->value, 1);
+  m3mpm::Queue<Payload> my_q;
+  my_q.push(Payload(3));
+  my_q.push(Payload(4));
+  ASSERT_EQ(my_q.front().value, 3);
+  ASSERT_EQ(my_q.back().value, 4);
+  my_q.pop();
+  ASSERT_EQ(my_q.size(), 1);
+}
+
+// Stateless allocator that counts every allocation made through it.
+size_t counted_allocations = 0;
+
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  CountingAllocator() = default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &) {}
+
+  T *allocate(size_t n) {
+    ++counted_allocations;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, size_t n) { std::allocator<T>().deallocate(p, n); }
+  bool operator==(const CountingAllocator &) const { return true; }
+  bool operator!=(const CountingAllocator &) const { return false; }
+};
+
+TEST(small_containers, no_allocations_below_n) {
+  counted_allocations = 0;
+  {
+    m3mpm::SmallStack<std::string, 8, CountingAllocator<std::string>> my_s;
+    m3mpm::SmallQueue<int, 8, CountingAllocator<int>> my_q;
+    for (int round = 0; round < 100; ++round) {
+      for (int i = 0; i < 8; ++i) {
+        my_s.push(std::to_string(i));
+        my_q.push(i);
+      }
+      ASSERT_FALSE(my_s.spilled());
+      ASSERT_FALSE(my_q.spilled());
+      ASSERT_EQ(my_s.top(), "7");
+      ASSERT_EQ(my_q.back(), 7);
+      for (int i = 0; i < 8; ++i) {
+        ASSERT_EQ(my_q.front(), i);
+        my_s.pop();
+        my_q.pop();
+      }
+      ASSERT_TRUE(my_s.empty() && my_q.empty());
+    }
+    m3mpm::SmallQueue<int, 8, CountingAllocator<int>> copy(my_q);
+    my_q = copy;
+  }
+  ASSERT_EQ(counted_allocations, 0);
+
+  m3mpm::Stack<int, CountingAllocator<int>> plain_s;
+  for (int i = 0; i < 8; ++i) plain_s.push(i);
+  ASSERT_EQ(counted_allocations, 8);
+}
+
+TEST(small_containers, spill_keeps_order) {
+  counted_allocations = 0;
+  m3mpm::SmallStack<int, 4, CountingAllocator<int>> my_s;
+  m3mpm::SmallQueue<int, 4, CountingAllocator<int>> my_q;
+  std::stack<int> std_s;
+  std::queue<int> std_q;
+  std::mt19937 gen(11);
+  for (int step = 0; step < 2000; ++step) {
+    int value = static_cast<int>(gen() % 1000);
+    if (gen() % 5 < 3) {
+      my_s.push(value);
+      my_q.push(value);
+      std_s.push(value);
+      std_q.push(value);
+    } else if (!std_s.empty()) {
+      ASSERT_EQ(my_s.top(), std_s.top());
+      ASSERT_EQ(my_q.front(), std_q.front());
+      ASSERT_EQ(my_q.back(), std_q.back());
+      my_s.pop();
+      my_q.pop();
+      std_s.pop();
+      std_q.pop();
+    }
+    ASSERT_EQ(my_s.size(), std_s.size());
+    ASSERT_EQ(my_q.size(), std_q.size());
+    ASSERT_EQ(my_q.spilled(), std_q.size() > 4);
+  }
+  ASSERT_GT(counted_allocations, 0);
+  while (!std_q.empty()) {
+    ASSERT_EQ(*my_q.try_pop(), std_q.front());
+    std_q.pop();
+  }
+  ASSERT_FALSE(my_q.try_pop().has_value());
+}
+
+TEST(small_containers, move_only_elements_spill) {
+  m3mpm::SmallStack<std::unique_ptr<int>, 2> my_s;
+  m3mpm::SmallQueue<std::unique_ptr<int>, 2> my_q;
+  for (int i = 0; i < 5; ++i) {
+    my_s.push(std::make_unique<int>(i));
+    my_q.push(std::make_unique<int>(i));
+  }
+  ASSERT_TRUE(my_s.spilled());
+  ASSERT_TRUE(my_q.spilled());
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(*my_s.top(), 4 - i);
+    ASSERT_EQ(*my_q.front(), i);
+    my_s.pop();
+    my_q.pop();
+  }
+  ASSERT_TRUE(my_s.empty() && my_q.empty());
+}
+
+TEST(small_containers, copy_move_swap) {
+  m3mpm::SmallStack<std::string, 2> s1{"a", "b", "c", "d"};
+  m3mpm::SmallStack<std::string, 2> s2(s1);
+  m3mpm::SmallStack<std::string, 2> s3(std::move(s1));
+  ASSERT_TRUE(s1.empty());
+  ASSERT_EQ(s2.size(), 4);
+  ASSERT_EQ(s3.top(), "d");
+  s1 = s3;
+  s1.pop();
+  s1.swap(s3);
+  ASSERT_EQ(s1.top(), "d");
+  ASSERT_EQ(s3.top(), "c");
+  std::string out;
+  ASSERT_TRUE(s3.try_pop(out));
+  ASSERT_EQ(out, "c");
+  ASSERT_EQ(*s3.try_top(), "b");
+  m3mpm::SmallStack<int, 1> empty_s;
+  ASSERT_FAILS(empty_s.top(), std::logic_error);
+
+  m3mpm::SmallQueue<std::string, 2> q1{"a", "b", "c"};
+  q1.pop();
+  q1.push("d");
+  m3mpm::SmallQueue<std::string, 2> q2(q1);
+  m3mpm::SmallQueue<std::string, 2> q3;
+  q3 = std::move(q1);
+  ASSERT_TRUE(q1.empty());
+  ASSERT_EQ(q1.try_front(), nullptr);
+  q3.swap(q2);
+  q2.pop();
+  for (auto *q : {&q2, &q3}) {
+    ASSERT_EQ(*q->try_back(), "d");
+  }
+  ASSERT_EQ(q2.front(), "c");
+  ASSERT_EQ(q3.front(), "b");
+  ASSERT_FAILS(q1.pop(), std::logic_error);
+}
+
+// Built entirely during constant evaluation.
+constexpr m3mpm::StaticQueue<int, 8> squares_table() {
+  m3mpm::StaticQueue<int, 8> table;
+  for (int i = 0; i < 12; ++i) {
+    if (table.full()) table.pop();
+    table.push(i * i);
+  }
+  return table;
+}
+
+constexpr int static_stack_sum() {
+  m3mpm::StaticStack<int, 4> my_s{1, 2, 3};
+  my_s.push(4);
+  int sum = my_s.try_push(5) ? 100 : 0;
+  int out = 0;
+  while (my_s.try_pop(out)) sum += out;
+  return my_s.try_top() == nullptr ? sum : -1;
+}
+
+static_assert(static_stack_sum() == 10);
+static_assert(squares_table().size() == 8);
+static_assert(squares_table().front() == 16);
+static_assert(squares_table().back() == 121);
+static_assert(std::is_trivially_copyable_v<m3mpm::StaticStack<int, 16>>);
+static_assert(std::is_trivially_copyable_v<m3mpm::StaticQueue<double, 16>>);
+static_assert(!std::is_trivially_copyable_v<
+              m3mpm::StaticStack<std::string, 16>>);
+
+#if __cpp_lib_constexpr_string >= 201907L
+// C++20: a non-literal element type inside one constant evaluation.
+constexpr bool static_string_queue() {
+  m3mpm::StaticQueue<std::string, 2> my_q;
+  my_q.push("constexpr");
+  my_q.push("queue");
+  my_q.pop();
+  my_q.push(std::string(30, 'r'));
+  return my_q.back().size() == 30 && *my_q.try_pop() == "queue" &&
+         my_q.size() == 1;
+}
+static_assert(static_string_queue());
+#endif
+
+TEST(static_containers, runtime_paths) {
+  constexpr auto table = squares_table();
+  auto copy = table;
+  std::vector<int> drained;
+  while (auto value = copy.try_pop()) drained.push_back(*value);
+  ASSERT_EQ(drained, (std::vector<int>{16, 25, 36, 49, 64, 81, 100, 121}));
+  ASSERT_EQ(table.size(), 8);
+
+  m3mpm::StaticStack<std::string, 2> my_s;
+  my_s.push("a");
+  my_s.push(std::string(40, 'b'));
+  ASSERT_TRUE(my_s.full());
+  ASSERT_FALSE(my_s.try_push("c"));
+  ASSERT_FAILS(my_s.push("c"), std::out_of_range);
+  ASSERT_EQ(my_s.top().size(), 40);
+  my_s.pop();
+  ASSERT_EQ(*my_s.try_top(), "a");
+  my_s.clear();
+  ASSERT_FAILS(my_s.top(), std::logic_error);
+  ASSERT_FAILS(my_s.pop(), std::logic_error);
+
+  m3mpm::StaticQueue<std::string, 3> my_q{"x", "y"};
+  std::queue<std::string> std_q;
+  std_q.push("x");
+  std_q.push("y");
+  for (int i = 0; i < 20; ++i) {
+    std::string value = std::to_string(i);
+    if (my_q.try_push(value)) std_q.push(value);
+    ASSERT_EQ(my_q.size(), std_q.size());
+    ASSERT_EQ(my_q.back(), std_q.back());
+    if (i % 3 == 0) {
+      std::string out;
+      ASSERT_TRUE(my_q.try_pop(out));
+      ASSERT_EQ(out, std_q.front());
+      std_q.pop();
+    }
+    ASSERT_EQ(*my_q.try_front(), std_q.front());
+  }
+  my_q.clear();
+  ASSERT_EQ(my_q.try_back(), nullptr);
+  ASSERT_FAILS(my_q.front(), std::logic_error);
+}
+
+TEST(segmented_stack, stable_addresses) {
+  m3mpm::SegmentedStack<std::string> my_s;
+  std::vector<const std::string *> addresses;
+  for (int i = 0; i < 20000; ++i) {
+    addresses.push_back(&my_s.emplace(std::to_string(i)));
+  }
+  for (int i = 0; i < 20000; ++i) {
+    ASSERT_EQ(*addresses[i], std::to_string(i));
+  }
+  for (int i = 19999; i >= 10000; --i) {
+    ASSERT_EQ(&my_s.top(), addresses[i]);
+    my_s.pop();
+  }
+  my_s.push("again");
+  ASSERT_EQ(*addresses[9999], "9999");
+  ASSERT_EQ(my_s.size(), 10001);
+}
+
+TEST(segmented_stack, spare_chunk_at_boundary) {
+  using Stack = m3mpm::SegmentedStack<long, CountingAllocator<long>>;
+  const size_t first = Stack::kFirstChunkBytes / sizeof(long);
+  counted_allocations = 0;
+  Stack my_s;
+  for (size_t i = 0; i < first; ++i) my_s.push(i);
+  // One chunk: its header and its elements.
+  ASSERT_EQ(counted_allocations, 2);
+  for (int i = 0; i < 1000; ++i) {
+    my_s.push(-1);
+    my_s.pop();
+  }
+  ASSERT_EQ(counted_allocations, 4);
+  for (size_t i = 0; i < 3 * first; ++i) my_s.push(i);
+  ASSERT_EQ(counted_allocations, 6);
+  my_s.clear();
+  ASSERT_TRUE(my_s.empty());
+  ASSERT_EQ(my_s.try_top(), nullptr);
+}
+
+TEST(segmented_stack, against_std_stack) {
+  m3mpm::SegmentedStack<int> my_s{1, 2, 3};
+  std::stack<int> std_s({1, 2, 3});
+  std::mt19937 gen(38);
+  for (int step = 0; step < 50000; ++step) {
+    if (gen() % 3 && step < 40000) {
+      int value = static_cast<int>(gen());
+      my_s.push(value);
+      std_s.push(value);
+    } else if (!std_s.empty()) {
+      ASSERT_EQ(my_s.top(), std_s.top());
+      int out = 0;
+      ASSERT_TRUE(my_s.try_pop(out));
+      ASSERT_EQ(out, std_s.top());
+      std_s.pop();
+    }
+    ASSERT_EQ(my_s.size(), std_s.size());
+  }
+  m3mpm::SegmentedStack<int> copy(my_s);
+  m3mpm::SegmentedStack<int> moved(std::move(my_s));
+  ASSERT_TRUE(my_s.empty());
+  my_s = copy;
+  ASSERT_EQ(my_s.size(), moved.size());
+  while (!copy.empty()) {
+    ASSERT_EQ(*copy.try_pop(), moved.top());
+    ASSERT_EQ(my_s.top(), moved.top());
+    moved.pop();
+    my_s.pop();
+  }
+  ASSERT_FALSE(copy.try_pop().has_value());
+  ASSERT_FAILS(copy.pop(), std::logic_error);
+}
+
+TEST(deque, against_std_deque) {
+  m3mpm::Deque<std::string> my_d{"a", "b"};
+  std::deque<std::string> std_d{"a", "b"};
+  std::mt19937 gen(39);
+  for (int step = 0; step < 20000; ++step) {
+    std::string value = std::to_string(gen() % 1000);
+    // Drifts towards growth at the front first, then at the back, then
+    // drains, so the map is recentred and grown from both sides.
+    int grow = step < 6000 ? 0 : step < 14000 ? 1 : 2;
+    switch (gen() % 4) {
+      case 0:
+        if (grow == 0 || (grow == 1 && gen() % 3 == 0)) {
+          my_d.push_front(value);
+          std_d.push_front(value);
+        } else if (!std_d.empty()) {
+          my_d.pop_front();
+          std_d.pop_front();
+        }
+        break;
+      case 1:
+        if (grow == 1 || (grow == 0 && gen() % 3 == 0)) {
+          my_d.emplace_back(value);
+          std_d.emplace_back(value);
+        } else if (!std_d.empty()) {
+          ASSERT_EQ(*my_d.try_pop_back(), std_d.back());
+          std_d.pop_back();
+        }
+        break;
+      default:
+        if (!std_d.empty()) {
+          size_t pos = gen() % std_d.size();
+          ASSERT_EQ(my_d[pos], std_d[pos]);
+          ASSERT_EQ(my_d.front(), std_d.front());
+          ASSERT_EQ(my_d.back(), std_d.back());
+        }
+    }
+    ASSERT_EQ(my_d.size(), std_d.size());
+  }
+  my_d.push_back("x");
+  std_d.push_back("x");
+  ASSERT_TRUE(std::equal(my_d.begin(), my_d.end(), std_d.begin(),
+                         std_d.end()));
+  m3mpm::Deque<std::string> copy(my_d);
+  m3mpm::Deque<std::string> moved(std::move(my_d));
+  ASSERT_TRUE(my_d.empty());
+  my_d = copy;
+  ASSERT_TRUE(std::equal(my_d.cbegin(), my_d.cend(), std_d.begin(),
+                         std_d.end()));
+  ASSERT_TRUE(std::equal(std::make_reverse_iterator(moved.end()),
+                         std::make_reverse_iterator(moved.begin()),
+                         std_d.rbegin(), std_d.rend()));
+  my_d.clear();
+  ASSERT_EQ(my_d.try_front(), nullptr);
+  ASSERT_EQ(copy.at(copy.size() - 1), "x");
+  ASSERT_FAILS(copy.at(copy.size()), std::out_of_range);
+  ASSERT_FAILS(my_d.pop_front(), std::range_error);
+  ASSERT_FAILS(my_d.back(), std::range_error);
+}
+
+TEST(deque, fifo_stops_allocating) {
+  using Deque = m3mpm::Deque<int, CountingAllocator<int>>;
+  Deque my_d;
+  for (int i = 0; i < 1000; ++i) my_d.push_back(i);
+  for (int i = 1000; i < 100000; ++i) {
+    // Past the warm-up, where the map settles to its size, the window of
+    // blocks slides through it and is recentred in place.
+    if (i == 10000) counted_allocations = 0;
+    ASSERT_EQ(my_d.front(), i - 1000);
+    my_d.pop_front();
+    my_d.push_back(i);
+  }
+  ASSERT_EQ(counted_allocations, 0);
+  ASSERT_EQ(my_d.size(), 1000);
+  ASSERT_EQ(my_d[999], 99999);
+}
+
+TEST(deque, iterators_and_throwing_elements) {
+  m3mpm::Deque<int> my_d{3, 1, 2};
+  std::reverse(my_d.begin(), my_d.end());
+  ASSERT_EQ(my_d[0], 2);
+  auto it = my_d.end();
+  ASSERT_EQ(*--it, 3);
+  ASSERT_EQ(*it--, 3);
+  *it = 20;
+  ASSERT_EQ(*std::next(my_d.cbegin()), 20);
+  if (m3mpm::kCheckedIterators) {
+    ASSERT_FAILS(*my_d.end(), std::logic_error);
+  }
+
+#if M3MPM_HAS_EXCEPTIONS
+  // An element whose constructor throws leaves the deque as it was.
+  struct Fragile {
+    explicit Fragile(bool fail) {
+      if (fail) throw std::runtime_error("fragile");
+    }
+  };
+  m3mpm::Deque<Fragile> fragile;
+  for (int i = 0; i < 300; ++i) {
+    ASSERT_ANY_THROW(fragile.emplace_front(true));
+    fragile.emplace_front(false);
+    ASSERT_ANY_THROW(fragile.emplace_back(true));
+    fragile.emplace_back(false);
+  }
+  ASSERT_EQ(fragile.size(), 600);
+  for (int i = 0; i < 300; ++i) {
+    fragile.pop_front();
+    fragile.pop_back();
+  }
+  ASSERT_TRUE(fragile.empty());
+#endif
+}
+
+TEST(priority_queue, against_std_priority_queue) {
+  m3mpm::PriorityQueue<int> my_q{5, 1, 9, 3, 7, 2};
+  std::priority_queue<int> std_q;
+  m3mpm::PriorityQueue<std::string, std::greater<std::string>, 2> min_q;
+  std::priority_queue<std::string, std::vector<std::string>,
+                      std::greater<std::string>>
+      std_min_q;
+  for (int value : {5, 1, 9, 3, 7, 2}) {
+    std_q.push(value);
+    min_q.push(std::to_string(value));
+    std_min_q.push(std::to_string(value));
+  }
+  std::mt19937 gen(40);
+  for (int step = 0; step < 20000; ++step) {
+    int value = static_cast<int>(gen() % 1000);
+    if (gen() % 5 < 3 || std_q.empty()) {
+      my_q.push(value);
+      std_q.push(value);
+      min_q.emplace(std::to_string(value));
+      std_min_q.push(std::to_string(value));
+    } else {
+      ASSERT_EQ(*my_q.try_pop(), std_q.top());
+      std_q.pop();
+      ASSERT_EQ(min_q.top(), std_min_q.top());
+      min_q.pop();
+      std_min_q.pop();
+    }
+    ASSERT_EQ(my_q.size(), std_q.size());
+    ASSERT_EQ(min_q.size(), std_min_q.size());
+  }
+  m3mpm::PriorityQueue<int> other;
+  other.swap(my_q);
+  ASSERT_TRUE(my_q.empty());
+  int out = 0;
+  while (other.try_pop(out)) {
+    ASSERT_EQ(out, std_q.top());
+    std_q.pop();
+  }
+  ASSERT_TRUE(std_q.empty());
+  ASSERT_EQ(other.try_top(), nullptr);
+  ASSERT_FAILS(other.top(), std::logic_error);
+  ASSERT_FAILS(other.pop(), std::logic_error);
+}
+
+TEST(pairing_heap, decrease_key_and_erase_against_multiset) {
+  using Heap = m3mpm::PairingHeap<int, std::greater<int>>;
+  Heap my_h;
+  std::multiset<int> std_h;
+  std::vector<Heap::handle> handles;
+  std::mt19937 gen(40);
+  for (int step = 0; step < 20000; ++step) {
+    int value = static_cast<int>(gen() % 100000);
+    switch (handles.empty() ? 0 : gen() % 5) {
+      case 0:
+      case 1:
+        handles.push_back(my_h.push(value));
+        std_h.insert(value);
+        break;
+      case 2: {
+        size_t pos = gen() % handles.size();
+        int old = my_h.get(handles[pos]);
+        int lower = old - static_cast<int>(gen() % 1000);
+        my_h.decrease_key(handles[pos], lower);
+        std_h.erase(std_h.find(old));
+        std_h.insert(lower);
+        break;
+      }
+      case 3: {
+        size_t pos = gen() % handles.size();
+        std_h.erase(std_h.find(my_h.get(handles[pos])));
+        my_h.erase(handles[pos]);
+        handles[pos] = handles.back();
+        handles.pop_back();
+        break;
+      }
+      default: {
+        ASSERT_EQ(my_h.top(), *std_h.begin());
+        Heap::handle top = handles[0];
+        for (Heap::handle h : handles) {
+          if (my_h.get(h) == my_h.top()) top = h;
+        }
+        my_h.erase(top);
+        std_h.erase(std_h.begin());
+        handles.erase(std::find(handles.begin(), handles.end(), top));
+      }
+    }
+    ASSERT_EQ(my_h.size(), std_h.size());
+  }
+  for (int value : std_h) {
+    ASSERT_EQ(*my_h.try_pop(), value);
+  }
+  ASSERT_TRUE(my_h.empty());
+  ASSERT_EQ(my_h.try_top(), nullptr);
+  ASSERT_FAILS(my_h.pop(), std::logic_error);
+}
+
+TEST(pairing_heap, copy_move_merge) {
+  using Heap = m3mpm::PairingHeap<std::string, std::less<std::string>,
+                                  CountingAllocator<std::string>>;
+  counted_allocations = 0;
+  Heap a{"b", "d", "a"};
+  Heap b;
+  Heap::handle c = b.push("c");
+  ASSERT_EQ(counted_allocations, 4);
+  a.merge(b);
+  ASSERT_EQ(counted_allocations, 4);
+  ASSERT_TRUE(b.empty());
+  ASSERT_EQ(a.size(), 4);
+  a.decrease_key(c, "e");
+  ASSERT_EQ(a.top(), "e");
+  ASSERT_FAILS(a.decrease_key(c, "a"), std::invalid_argument);
+  Heap copy(a);
+  Heap moved(std::move(a));
+  ASSERT_TRUE(a.empty());
+  a = copy;
+  for (const char *value : {"e", "d", "b", "a"}) {
+    ASSERT_EQ(a.top(), value);
+    ASSERT_EQ(copy.top(), value);
+    std::string out;
+    ASSERT_TRUE(moved.try_pop(out));
+    ASSERT_EQ(out, value);
+    a.pop();
+    copy.pop();
+  }
+  ASSERT_TRUE(moved.empty());
+  ASSERT_FAILS(copy.top(), std::logic_error);
+}
+
+TEST(container_stats, list_nodes_bytes_and_operations) {
+  using CountedList =
+      m3mpm::List<int, std::allocator<int>, m3mpm::CountingStats>;
+  using m3mpm::Op;
+  static_assert(!m3mpm::List<int>::kEnabled && CountedList::kEnabled);
+  static_assert(sizeof(CountedList) > sizeof(m3mpm::List<int>));
+  const size_t node = sizeof(m3mpm::Node<int>);
+  m3mpm::reset_global_stats();
+  {
+    CountedList l;
+    for (int i = 0; i < 100; ++i) l.push_back(i);
+    // The sentinel is a node too.
+    ASSERT_EQ(l.stats().allocations, 101);
+    ASSERT_EQ(l.stats().live_bytes, 101 * node);
+    for (int i = 0; i < 50; ++i) l.pop_front();
+    const m3mpm::ContainerStats &s = l.stats();
+    ASSERT_EQ(s.frees, 50);
+    ASSERT_EQ(s.live_nodes, 51);
+    ASSERT_EQ(s.peak_nodes, 101);
+    ASSERT_EQ(s.peak_bytes, 101 * node);
+    ASSERT_EQ(s.count(Op::kPush), 100);
+    ASSERT_EQ(s.count(Op::kPop), 50);
+    ASSERT_EQ(s.hops, 0);
+    l.reverse();
+    ASSERT_EQ(s.hops, 50);
+
+    CountedList other{7, 3};
+    other.sort();
+    l.sort();
+    l.merge(other);
+    ASSERT_EQ(s.count(Op::kMerge), 1);
+    ASSERT_EQ(s.count(Op::kInsert), 2);
+    ASSERT_EQ(s.live_nodes, 53);
+    // The nodes change hands with the list, the history does not.
+    l.swap(other);
+    ASSERT_EQ(other.stats().live_nodes, 53);
+    ASSERT_EQ(l.stats().live_nodes, 1);
+    ASSERT_EQ(l.stats().count(Op::kMerge), 1);
+
+    uint64_t allocations = other.stats().allocations;
+    other.compact();
+    ASSERT_EQ(other.stats().allocations, allocations + 1);
+    ASSERT_EQ(other.stats().live_nodes, 53);
+    ASSERT_EQ(other.stats().live_bytes, 53 * node);
+    CountedList copy(other);
+    ASSERT_EQ(copy.stats().count(Op::kCopy), 1);
+    ASSERT_EQ(copy.stats().allocations, 53);
+
+    m3mpm::ContainerStats totals = m3mpm::global_stats();
+    ASSERT_EQ(totals.live_nodes, 1 + 53 + 53);
+    ASSERT_EQ(totals.count(Op::kMerge), 1);
+  }
+  m3mpm::ContainerStats totals = m3mpm::global_stats();
+  ASSERT_EQ(totals.live_nodes, 0);
+  ASSERT_EQ(totals.live_bytes, 0);
+  ASSERT_EQ(totals.allocations, totals.frees);
+  ASSERT_GE(totals.peak_nodes, 107);
+}
+
+TEST(container_stats, stack_and_queue) {
+  using CountedQueue =
+      m3mpm::Queue<std::string, std::allocator<std::string>,
+                   m3mpm::CountingStats>;
+  using CountedStack =
+      m3mpm::Stack<int, std::allocator<int>, m3mpm::CountingStats>;
+  using m3mpm::Op;
+  m3mpm::reset_global_stats();
+  CountedQueue q{"a", "b", "c"};
+  q.pop();
+  std::string out;
+  ASSERT_TRUE(q.try_pop(out));
+  ASSERT_EQ(q.stats().count(Op::kPush), 3);
+  ASSERT_EQ(q.stats().count(Op::kPop), 2);
+  ASSERT_EQ(q.stats().allocations, 3);
+  ASSERT_EQ(q.stats().frees, 2);
+
+  CountedStack s;
+  for (int i = 0; i < 10; ++i) s.push(i);
+  CountedStack t;
+  t = s;
+  ASSERT_EQ(t.stats().count(Op::kCopy), 1);
+  ASSERT_EQ(t.stats().hops, 10);
+  ASSERT_EQ(t.stats().live_nodes, 10);
+  CountedStack moved(std::move(t));
+  ASSERT_EQ(moved.stats().live_nodes, 10);
+  ASSERT_EQ(t.stats().live_nodes, 0);
+  ASSERT_EQ(m3mpm::global_stats().live_nodes, 1 + 10 + 10);
+  ASSERT_EQ(m3mpm::global_stats().count(Op::kPush), 3 + 10 + 10);
+}
+
+TEST(latency, histogram_precision) {
+  m3mpm::LatencyHistogram h;
+  for (uint64_t v = 0; v < 32; ++v) h.record(v);
+  ASSERT_EQ(h.percentile(0.5), 15);
+  ASSERT_EQ(h.percentile(1.0), 31);
+  m3mpm::LatencyHistogram wide;
+  for (uint64_t v = 1; v <= 100000; ++v) wide.record(v * 1000);
+  for (double p : {0.5, 0.9, 0.99, 0.999}) {
+    double exact = p * 100000 * 1000;
+    ASSERT_NEAR(wide.percentile(p), exact, exact / 32);
+  }
+  ASSERT_EQ(wide.percentile(1.0), 100000000);
+  h.merge(wide);
+  ASSERT_EQ(h.count(), 100032);
+  ASSERT_EQ(h.min(), 0);
+  ASSERT_EQ(h.max(), 100000000);
+  h.record(UINT64_MAX);
+  ASSERT_EQ(h.percentile(1.0), UINT64_MAX);
+  h.reset();
+  ASSERT_EQ(h.count(), 0);
+  ASSERT_EQ(h.percentile(0.5), 0);
+}
+
+// Advances by 7 per reading, so every timed call takes 7 ticks.
+struct FakeTicks {
+  static constexpr const char *kUnit = "ticks";
+  static uint64_t now() {
+    static uint64_t ticks = 0;
+    return ticks += 7;
+  }
+};
+
+TEST(latency, sampled_operations) {
+  using m3mpm::Op;
+  using Timed = m3mpm::LatencyStats<m3mpm::CountingStats, FakeTicks>;
+  m3mpm::List<int, std::allocator<int>, Timed> l;
+  ASSERT_EQ(l.sampling(), Timed::kDefaultSampling);
+  l.set_sampling(1);
+  for (int i = 0; i < 1000; ++i) l.push_back(i);
+  ASSERT_EQ(l.latency(Op::kPush).count(), 1000);
+  ASSERT_EQ(l.latency(Op::kPush).percentile(0.99), 7);
+  l.set_sampling(10);
+  for (int i = 0; i < 1000; ++i) l.pop_front();
+  ASSERT_EQ(l.latency(Op::kPop).count(), 100);
+  l.set_sampling(0);
+  l.sort();
+  ASSERT_EQ(l.latency(Op::kSort).count(), 0);
+  // The counting base still sees every call.
+  ASSERT_EQ(l.stats().count(Op::kPop), 1000);
+  ASSERT_EQ(l.stats().count(Op::kSort), 1);
+
+  std::ostringstream out;
+  l.dump_latency(out);
+  ASSERT_EQ(out.str(),
+            "push: n=1000 p50=7 p90=7 p99=7 p99.9=7 max=7 ticks\n"
+            "pop: n=100 p50=7 p90=7 p99=7 p99.9=7 max=7 ticks\n");
+  l.reset_latency();
+  ASSERT_EQ(l.latency(Op::kPush).count(), 0);
+
+  m3mpm::Queue<int, std::allocator<int>, m3mpm::LatencyStats<>> q;
+  q.set_sampling(1);
+  q.push(1);
+  q.pop();
+  ASSERT_FAILS(q.pop(), std::logic_error);
+#if M3MPM_HAS_EXCEPTIONS
+  // The call that threw was timed as well.
+  ASSERT_EQ(q.latency(Op::kPop).count(), 2);
+#endif
+  static_assert(sizeof(m3mpm::List<int>) ==
+                sizeof(m3mpm::List<int, std::allocator<int>, m3mpm::NoStats>));
+}
+
+TEST(memory_usage, nodes_sentinel_slab_and_index) {
+  using m3mpm::detail::heap_allocation_size;
+  const size_t node = heap_allocation_size(sizeof(m3mpm::Node<int>));
+  m3mpm::Stack<int> my_s;
+  ASSERT_EQ(my_s.memory_usage(), sizeof(my_s));
+  for (int i = 0; i < 3; ++i) my_s.push(i);
+  ASSERT_EQ(my_s.memory_usage(), sizeof(my_s) + 3 * node);
+  m3mpm::Queue<Payload> my_q;
+  my_q.push(Payload(1));
+  ASSERT_EQ(my_q.memory_usage(),
+            sizeof(my_q) + heap_allocation_size(sizeof(m3mpm::Node<Payload>)));
+
+  m3mpm::List<int> my_l;
+  ASSERT_EQ(my_l.memory_usage(), sizeof(my_l) + node);
+  for (int i = 0; i < 100; ++i) my_l.push_back(i);
+  ASSERT_EQ(my_l.memory_usage(), sizeof(my_l) + 101 * node);
+  my_l.compact();
+  const size_t slab = heap_allocation_size(100 * sizeof(m3mpm::Node<int>));
+  ASSERT_EQ(my_l.memory_usage(), sizeof(my_l) + node + slab);
+  // Erased slab nodes stay paid for, new nodes come on top.
+  for (int i = 0; i < 10; ++i) my_l.pop_front();
+  my_l.push_back(100);
+  ASSERT_EQ(my_l.memory_usage(), sizeof(my_l) + 2 * node + slab);
+  const size_t before_index = my_l.memory_usage();
+  ASSERT_EQ(my_l.at(50), 60);
+  ASSERT_GT(my_l.memory_usage(),
+            before_index + heap_allocation_size(sizeof(m3mpm::SkipIndex<int>)));
+  my_l.drop_index();
+  ASSERT_EQ(my_l.memory_usage(), before_index);
+  my_l.clear();
+  ASSERT_EQ(my_l.memory_usage(), sizeof(my_l) + node);
+  m3mpm::List<int> moved(std::move(my_l));
+  ASSERT_EQ(my_l.memory_usage(), sizeof(my_l));
+}
+
+TEST(memory_usage, pooled_nodes_and_nested_containers) {
+  using m3mpm::detail::heap_allocation_size;
+  static_assert(heap_allocation_size(1) == 4 * sizeof(size_t));
+  static_assert(heap_allocation_size(3 * sizeof(size_t)) == 4 * sizeof(size_t));
+  static_assert(heap_allocation_size(3 * sizeof(size_t) + 1) ==
+                6 * sizeof(size_t));
+  m3mpm::Stack<int, m3mpm::HugePageArenaAllocator<int>> huge;
+  m3mpm::Queue<int, m3mpm::ThreadCachingAllocator<int>> cached;
+  for (int i = 0; i < 4; ++i) {
+    huge.push(i);
+    cached.push(i);
+  }
+  ASSERT_EQ(huge.memory_usage(), sizeof(huge) + 4 * sizeof(m3mpm::Node<int>));
+  ASSERT_EQ(cached.memory_usage(),
+            sizeof(cached) + 4 * sizeof(m3mpm::Node<int>));
+
+  m3mpm::List<m3mpm::List<int>> nested;
+  nested.push_back(m3mpm::List<int>{1, 2, 3});
+  nested.push_back(m3mpm::List<int>{});
+  const size_t outer = nested.memory_usage();
+  ASSERT_EQ(outer, sizeof(nested) + 3 * heap_allocation_size(sizeof(
+                                            m3mpm::Node<m3mpm::List<int>>)));
+  const size_t inner = nested.front().memory_usage() +
+                       nested.back().memory_usage() -
+                       2 * sizeof(m3mpm::List<int>);
+  ASSERT_EQ(nested.memory_usage(true), outer + inner);
+  m3mpm::Stack<m3mpm::Stack<std::string>> stacks;
+  stacks.push(m3mpm::Stack<std::string>{"a", "b"});
+  ASSERT_EQ(stacks.memory_usage(true),
+            stacks.memory_usage() + 2 * heap_allocation_size(sizeof(
+                                            m3mpm::Node<std::string>)));
+}
+
+namespace {
+// Ordered by key only, so that seq shows whether equal keys kept their
+// order.
+struct Keyed {
+  int key;
+  int seq;
+  bool operator<(const Keyed &other) const { return key < other.key; }
+};
+
+template <typename T>
+bool links_consistent(m3mpm::List<T> &l) {
+  size_t forward = 0;
+  for (auto it = l.begin(); it != l.end(); ++it) {
+    if (it.pNode_->pNext_->pPrev_ != it.pNode_) return false;
+    ++forward;
+  }
+  size_t backward = 0;
+  for (auto it = l.end(); --it != l.end();) ++backward;
+  return forward == l.size() && backward == l.size();
+}
+}  // namespace
+
+TEST(list_ParallelSortTests, stable_against_std_stable_sort) {
+  const size_t big = m3mpm::List<Keyed>::kParallelSortGrain * 4 + 123;
+  std::mt19937 gen(47);
+  for (size_t n : {size_t(0), size_t(1), size_t(2), size_t(5), size_t(1000),
+                   big}) {
+    for (size_t threads : {1, 3, 4, 0}) {
+      std::vector<Keyed> expected;
+      m3mpm::List<Keyed> my_l;
+      for (size_t i = 0; i < n; ++i) {
+        Keyed item{static_cast<int>(gen() % 500), static_cast<int>(i)};
+        expected.push_back(item);
+        my_l.push_back(item);
+      }
+      // With an index the runs are found through it, otherwise by a walk.
+      if (n > 2 && threads % 2 == 1) {
+        ASSERT_EQ(my_l.at(1).seq, 1);
+      }
+      auto held = my_l.begin();
+      my_l.parallel_sort(threads);
+      std::stable_sort(expected.begin(), expected.end());
+      ASSERT_FALSE(my_l.indexed());
+      ASSERT_TRUE(links_consistent(my_l));
+      if (n > 0) {
+        ASSERT_EQ(held->seq, 0);
+      }
+      size_t i = 0;
+      for (const Keyed &item : my_l) {
+        ASSERT_EQ(item.key, expected[i].key);
+        ASSERT_EQ(item.seq, expected[i].seq);
+        ++i;
+      }
+      if (n > 2) {
+        ASSERT_EQ(my_l.at(n / 2).seq, expected[n / 2].seq);
+      }
+    }
+  }
+  m3mpm::List<int> sorted;
+  for (int i = 0; i < 100000; ++i) sorted.push_back(i / 3);
+  sorted.parallel_sort(4);
+  ASSERT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+  ASSERT_EQ(sorted.size(), 100000);
+}
+
+#if M3MPM_HAS_EXCEPTIONS
+namespace {
+// Throws from the comparison that exhausts the shared budget.
+struct Fragile {
+  static inline std::atomic<long> budget{-1};
+  int value;
+  bool operator<(const Fragile &other) const {
+    if (budget.fetch_sub(1) == 0) throw std::runtime_error("comparison");
+    return value < other.value;
+  }
+};
+}  // namespace
+
+TEST(list_ParallelSortTests, throwing_comparison_keeps_every_element) {
+  const size_t n = m3mpm::List<Fragile>::kParallelSortGrain * 4;
+  auto fill = [n](m3mpm::List<Fragile> &l) {
+    std::mt19937 gen(5);
+    for (size_t i = 0; i < n; ++i) {
+      l.push_back(Fragile{static_cast<int>(gen() % 100000)});
+    }
+  };
+  m3mpm::List<Fragile> probe;
+  fill(probe);
+  Fragile::budget = std::numeric_limits<long>::max();
+  probe.parallel_sort(4);
+  const long total = std::numeric_limits<long>::max() - Fragile::budget;
+  std::multiset<int> values;
+  for (const Fragile &item : probe) values.insert(item.value);
+
+  // Early in the run sorts, late in them, while splitting and in the final
+  // merges.
+  for (long budget : {10L, total / 2, total - static_cast<long>(n) / 2,
+                      total - 10}) {
+    m3mpm::List<Fragile> my_l;
+    fill(my_l);
+    Fragile::budget = budget;
+    ASSERT_THROW(my_l.parallel_sort(4), std::runtime_error);
+    Fragile::budget = -1;
+    ASSERT_EQ(my_l.size(), n);
+    ASSERT_TRUE(links_consistent(my_l));
+    std::multiset<int> kept;
+    for (const Fragile &item : my_l) kept.insert(item.value);
+    ASSERT_EQ(kept, values);
+  }
+  Fragile::budget = -1;
+}
+#endif
+
+// An order-sensitive fold: the polynomial hash of the sequence and the
+// power of the base that shifts it, so partials combine only in order.
+struct SeqHash {
+  uint64_t hash = 0;
+  uint64_t shift = 1;
+};
+constexpr uint64_t kHashBase = 1000003;
+struct SeqHashOp {
+  SeqHash operator()(SeqHash acc, int x) const {
+    return {acc.hash * kHashBase + static_cast<uint64_t>(x),
+            acc.shift * kHashBase};
+  }
+  SeqHash operator()(SeqHash acc, SeqHash next) const {
+    return {acc.hash * next.shift + next.hash, acc.shift * next.shift};
+  }
+};
+
+TEST(list_ParallelScanTests, matches_sequential_scans) {
+  const size_t big = m3mpm::List<int>::kParallelGrain * 5 + 77;
+  std::mt19937 gen(59);
+  for (size_t n : {size_t(0), size_t(1), size_t(5000), big}) {
+    for (size_t threads : {1, 3, 0}) {
+      for (bool indexed : {false, true}) {
+        std::vector<int> expected;
+        m3mpm::List<int> my_l;
+        for (size_t i = 0; i < n; ++i) {
+          int value = static_cast<int>(gen() % 1000);
+          expected.push_back(value);
+          my_l.push_back(value);
+        }
+        if (indexed && n > 0) my_l.at(0);
+        ASSERT_EQ(my_l.indexed(), indexed && n > 0);
+
+        std::atomic<long> sum{0};
+        my_l.parallel_for_each([&sum](int &x) { sum += x; }, threads);
+        long total = std::accumulate(expected.begin(), expected.end(), 0L);
+        ASSERT_EQ(sum.load(), total);
+        ASSERT_EQ(my_l.parallel_reduce(0L, std::plus<>(), threads), total);
+
+        my_l.parallel_transform([](int x) { return x * 2 + 1; }, threads);
+        for (int &x : expected) x = x * 2 + 1;
+        SeqHash want =
+            std::accumulate(expected.begin(), expected.end(), SeqHash(),
+                            SeqHashOp());
+        SeqHash got = my_l.parallel_reduce(SeqHash(), SeqHashOp(), threads);
+        ASSERT_EQ(got.hash, want.hash);
+        ASSERT_EQ(got.shift, want.shift);
+
+        // [n / 3, n - n / 4) through iterators, then every element again.
+        size_t from = n / 3, to = n - n / 4;
+        auto first = std::next(my_l.begin(), from);
+        auto last = std::next(my_l.begin(), to);
+        my_l.parallel_transform(first, last, [](int x) { return -x; },
+                                threads);
+        for (size_t i = from; i < to; ++i) expected[i] = -expected[i];
+        sum = 0;
+        my_l.parallel_for_each(first, last, [&sum](int &x) { sum += x; },
+                               threads);
+        ASSERT_EQ(sum.load(), std::accumulate(expected.begin() + from,
+                                              expected.begin() + to, 0L));
+        want = std::accumulate(expected.begin() + from, expected.begin() + to,
+                               SeqHash(), SeqHashOp());
+        got = my_l.parallel_reduce(m3mpm::List<int>::const_iterator(first),
+                                   m3mpm::List<int>::const_iterator(last),
+                                   SeqHash(), SeqHashOp(), threads);
+        ASSERT_EQ(got.hash, want.hash);
+        ASSERT_TRUE(std::equal(my_l.begin(), my_l.end(), expected.begin(),
+                               expected.end()));
+      }
+    }
+  }
+}
+
+#if M3MPM_HAS_EXCEPTIONS
+TEST(list_ParallelScanTests, first_exception_is_rethrown) {
+  const size_t n = m3mpm::List<int>::kParallelGrain * 8;
+  m3mpm::List<int> my_l;
+  for (size_t i = 0; i < n; ++i) my_l.push_back(static_cast<int>(i));
+  for (bool indexed : {false, true}) {
+    if (indexed) my_l.at(0);
+    std::atomic<size_t> visited{0};
+    ASSERT_THROW(my_l.parallel_for_each(
+                     [&visited](int &x) {
+                       ++visited;
+                       if (x == 3 * 4096 + 5) throw std::runtime_error("x");
+                     },
+                     4),
+                 std::runtime_error);
+    // The rest of that chunk is skipped, as are chunks not yet claimed.
+    ASSERT_LT(visited.load(), n);
+    ASSERT_THROW(my_l.parallel_reduce(
+                     0L,
+                     [](long acc, long x) {
+                       if (x == static_cast<long>(n) - 1) {
+                         throw std::runtime_error("x");
+                       }
+                       return acc + x;
+                     },
+                     4),
+                 std::runtime_error);
+    ASSERT_EQ(my_l.size(), n);
+    ASSERT_TRUE(links_consistent(my_l));
+    ASSERT_EQ(my_l.parallel_reduce(0L, std::plus<>(), 4),
+              static_cast<long>(n) * (static_cast<long>(n) - 1) / 2);
+  }
+}
+#endif
+
+TEST(list_ParallelScanTests, large_scans_build_the_index) {
+  m3mpm::List<long> small_l;
+  for (size_t i = 0; i < m3mpm::List<long>::kParallelGrain * 4; ++i) {
+    small_l.push_back(1);
+  }
+  ASSERT_EQ(small_l.parallel_reduce(0L, std::plus<>(), 4),
+            static_cast<long>(small_l.size()));
+  ASSERT_FALSE(small_l.indexed());
+
+  const long n = m3mpm::List<long>::kParallelIndexMin;
+  m3mpm::List<long> my_l;
+  for (long i = 0; i < n; ++i) my_l.push_back(i);
+  ASSERT_EQ(my_l.parallel_reduce(0L, std::plus<>(), 4), n * (n - 1) / 2);
+  ASSERT_TRUE(my_l.indexed());
+  // The index is kept up to date for the next scan.
+  my_l.pop_front();
+  my_l.push_back(n);
+  ASSERT_EQ(my_l.at(0), 1);
+  my_l.parallel_transform([](long x) { return x - 1; }, 4);
+  ASSERT_EQ(my_l.parallel_reduce(0L, std::plus<>(), 4), n * (n - 1) / 2);
+  ASSERT_EQ(my_l.at(static_cast<size_t>(n) - 1), n - 1);
+}
+
+TEST(list_ParallelScanTests, empty_iterators_fail) {
+  m3mpm::List<int> my_l{1, 2, 3};
+  m3mpm::List<int>::iterator empty;
+  ASSERT_FAILS(my_l.parallel_for_each(empty, my_l.end(), [](int &) {}),
+               std::logic_error);
+  ASSERT_FAILS(my_l.parallel_reduce(empty, my_l.cend(), 0, std::plus<>()),
+               std::logic_error);
+  ASSERT_FAILS(
+      my_l.parallel_transform(my_l.begin(), empty, [](int x) { return x; }),
+      std::logic_error);
+}
+
+// Checks the searches and reductions of c, holding values, against the std
+// algorithms at every SIMD level the CPU has.
+template <typename C, typename T>
+void expect_search_matches(C &c, const std::vector<T> &values,
+                           const std::vector<T> &keys) {
+  for (auto level : {m3mpm::SimdLevel::kScalar, m3mpm::SimdLevel::kVector128,
+                     m3mpm::SimdLevel::kVector256}) {
+    m3mpm::set_simd_level(level);
+    for (const T &key : keys) {
+      auto at = std::find(values.begin(), values.end(), key);
+      EXPECT_EQ(std::distance(c.begin(), c.find(key)),
+                at - values.begin());
+      EXPECT_EQ(c.contains(key), at != values.end());
+      EXPECT_EQ(c.count(key),
+                static_cast<size_t>(std::count(values.begin(), values.end(),
+                                               key)));
+    }
+    EXPECT_EQ(std::distance(c.begin(), c.min_element()),
+              std::min_element(values.begin(), values.end()) -
+                  values.begin());
+    EXPECT_EQ(std::distance(c.begin(), c.max_element()),
+              std::max_element(values.begin(), values.end()) -
+                  values.begin());
+    const C &const_c = c;
+    EXPECT_EQ(std::distance(const_c.cbegin(), const_c.min_element()),
+              std::distance(c.begin(), c.min_element()));
+    // A NaN makes both sums NaN, which never compare equal.
+    T sum = const_c.sum();
+    T expected = std::accumulate(values.begin(), values.end(), T());
+    EXPECT_TRUE(sum == expected || (sum != sum && expected != expected));
+  }
+  m3mpm::set_simd_level(m3mpm::SimdLevel::kVector256);
+}
+
+TEST(list_SearchTests, matches_std_algorithms) {
+  std::mt19937 gen(61);
+  for (size_t n : {size_t(0), size_t(1), size_t(63), size_t(64), size_t(65),
+                   size_t(1000)}) {
+    std::vector<int> ints;
+    std::vector<double> doubles;
+    std::vector<char> chars;
+    std::vector<std::string> strings;
+    for (size_t i = 0; i < n; ++i) {
+      ints.push_back(static_cast<int>(gen() % 50) - 25);
+      doubles.push_back(static_cast<double>(gen() % 50));
+      chars.push_back(static_cast<char>('a' + gen() % 20));
+      strings.push_back(std::string(1, chars.back()));
+    }
+    // NaNs are never found nor picked, unless min_element() starts on one.
+    if (n > 2) doubles[n / 2] = std::nan("");
+    m3mpm::List<int> int_l;
+    m3mpm::List<double> double_l;
+    m3mpm::List<char> char_l;
+    m3mpm::List<std::string> string_l;
+    for (int x : ints) int_l.push_back(x);
+    for (double x : doubles) double_l.push_back(x);
+    for (char x : chars) char_l.push_back(x);
+    for (const auto &x : strings) string_l.push_back(x);
+    expect_search_matches(int_l, ints, {-25, 0, 24, 100});
+    expect_search_matches(double_l, doubles, {0.0, 49.0, std::nan("")});
+    expect_search_matches(char_l, chars, {'a', 't', 'z'});
+    expect_search_matches(string_l, strings, {"a", "z"});
+    if (n > 0) {
+      doubles[0] = std::nan("");
+      *double_l.begin() = doubles[0];
+      expect_search_matches(double_l, doubles, {1.0});
+    }
+  }
+}
+
+TEST(deque, search_matches_std_algorithms) {
+  std::mt19937 gen(67);
+  for (size_t n : {size_t(0), size_t(1), size_t(200), size_t(3000)}) {
+    std::vector<long> longs(n);
+    std::vector<float> floats(n);
+    for (size_t i = 0; i < n; ++i) {
+      longs[i] = static_cast<long>(gen() % 1000);
+      floats[i] = static_cast<float>(gen() % 1000);
+    }
+    if (n > 2) floats[n - 1] = std::nanf("");
+    // Filled from the middle so that the runs do not start on a block.
+    m3mpm::Deque<long> long_d;
+    m3mpm::Deque<float> float_d;
+    for (size_t i = n / 3; i < n; ++i) {
+      long_d.push_back(longs[i]);
+      float_d.push_back(floats[i]);
+    }
+    for (size_t i = n / 3; i-- > 0;) {
+      long_d.push_front(longs[i]);
+      float_d.push_front(floats[i]);
+    }
+    expect_search_matches(long_d, longs, {0L, 999L, -1L});
+    expect_search_matches(float_d, floats, {0.0f, 500.0f});
+  }
+}
+
+TEST(list_RadixSortTests, matches_std_stable_sort) {
+  std::mt19937_64 gen(71);
+  for (size_t n : {size_t(0), size_t(1), size_t(2), size_t(1000),
+                   size_t(50000)}) {
+    std::vector<Keyed> keyed;
+    std::vector<int64_t> signed_keys;
+    std::vector<uint64_t> stamps;
+    std::vector<double> doubles;
+    m3mpm::List<Keyed> keyed_l;
+    m3mpm::List<int64_t> signed_l;
+    m3mpm::List<uint64_t> stamp_l;
+    m3mpm::List<double> double_l;
+    const uint64_t epoch = 1700000000000000000ULL;
+    for (size_t i = 0; i < n; ++i) {
+      keyed.push_back({static_cast<int>(gen() % 300) - 150,
+                       static_cast<int>(i)});
+      signed_keys.push_back(static_cast<int64_t>(gen()));
+      stamps.push_back(epoch + gen() % 3600000000000ULL);
+      doubles.push_back(static_cast<double>(static_cast<int64_t>(gen())) /
+                        1e6);
+      keyed_l.push_back(keyed.back());
+      signed_l.push_back(signed_keys.back());
+      stamp_l.push_back(stamps.back());
+      double_l.push_back(doubles.back());
+    }
+    if (n > 2) {
+      ASSERT_EQ(keyed_l.at(1).seq, 1);
+    }
+    auto held = keyed_l.begin();
+    keyed_l.radix_sort([](const Keyed &item) { return item.key; });
+    signed_l.radix_sort();
+    stamp_l.radix_sort();
+    double_l.radix_sort();
+    std::stable_sort(keyed.begin(), keyed.end());
+    std::sort(signed_keys.begin(), signed_keys.end());
+    std::sort(stamps.begin(), stamps.end());
+    std::sort(doubles.begin(), doubles.end());
+
+    ASSERT_FALSE(keyed_l.indexed());
+    ASSERT_TRUE(links_consistent(keyed_l));
+    ASSERT_TRUE(links_consistent(stamp_l));
+    if (n > 0) {
+      ASSERT_EQ(held->seq, 0);
+    }
+    size_t i = 0;
+    for (const Keyed &item : keyed_l) {
+      ASSERT_EQ(item.key, keyed[i].key);
+      ASSERT_EQ(item.seq, keyed[i].seq);
+      ++i;
+    }
+    ASSERT_TRUE(std::equal(signed_l.begin(), signed_l.end(),
+                           signed_keys.begin(), signed_keys.end()));
+    ASSERT_TRUE(std::equal(stamp_l.begin(), stamp_l.end(), stamps.begin(),
+                           stamps.end()));
+    ASSERT_TRUE(std::equal(double_l.begin(), double_l.end(), doubles.begin(),
+                           doubles.end()));
+  }
+}
+
+TEST(list_RadixSortTests, float_order_and_narrow_keys) {
+  const double inf = std::numeric_limits<double>::infinity();
+  m3mpm::List<double> my_l{2.5, -0.0, inf, 0.0, -inf, -2.5, 0.0, -1e-300};
+  my_l.radix_sort();
+  std::vector<double> sorted(my_l.begin(), my_l.end());
+  std::vector<double> expected{-inf, -2.5, -1e-300, -0.0, 0.0, 0.0, 2.5, inf};
+  ASSERT_EQ(sorted, expected);
+  ASSERT_TRUE(std::signbit(sorted[3]));
+  ASSERT_FALSE(std::signbit(sorted[4]));
+
+  m3mpm::List<float> nan_l{1.0f, std::nanf(""), -1.0f, -std::nanf("")};
+  nan_l.radix_sort();
+  std::vector<float> floats(nan_l.begin(), nan_l.end());
+  ASSERT_TRUE(std::isnan(floats[0]) && std::signbit(floats[0]));
+  ASSERT_EQ(floats[1], -1.0f);
+  ASSERT_EQ(floats[2], 1.0f);
+  ASSERT_TRUE(std::isnan(floats[3]) && !std::signbit(floats[3]));
+
+  m3mpm::List<signed char> chars{5, -128, 127, 0, -1};
+  chars.radix_sort();
+  ASSERT_EQ(std::vector<signed char>(chars.begin(), chars.end()),
+            (std::vector<signed char>{-128, -1, 0, 5, 127}));
+  m3mpm::List<bool> flags{true, false, true, false};
+  flags.radix_sort();
+  ASSERT_EQ(std::vector<bool>(flags.begin(), flags.end()),
+            (std::vector<bool>{false, false, true, true}));
+}
+
+#if M3MPM_HAS_EXCEPTIONS
+TEST(list_RadixSortTests, throwing_key_leaves_the_list_unchanged) {
+  const size_t n = 5000;
+  std::mt19937 gen(73);
+  m3mpm::List<int> probe;
+  for (size_t i = 0; i < n; ++i) probe.push_back(static_cast<int>(gen()));
+  for (size_t budget : {size_t(0), n / 2, n - 1}) {
+    m3mpm::List<int> my_l(probe);
+    size_t calls = 0;
+    auto key = [&calls, budget](int x) {
+      if (++calls > budget) throw std::runtime_error("key");
+      return x;
+    };
+    ASSERT_THROW(my_l.radix_sort(key), std::runtime_error);
+    ASSERT_TRUE(links_consistent(my_l));
+    ASSERT_TRUE(std::equal(my_l.begin(), my_l.end(), probe.begin(),
+                           probe.end()));
+  }
+}
+#endif
+
 int main(int argc, char* argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
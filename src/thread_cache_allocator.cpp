@@ -0,0 +1,234 @@
+#include <stdint.h>
+
+#include <new>
+#include <thread>
+
+namespace m3mpm {
+
+template <size_t Size, size_t Align, typename Slabs>
+thread_local typename ThreadCachePool<Size, Align, Slabs>::Cache
+    *ThreadCachePool<Size, Align, Slabs>::tls_cache_ = nullptr;
+
+template <size_t Size, size_t Align, typename Slabs>
+thread_local bool ThreadCachePool<Size, Align, Slabs>::tls_exited_ = false;
+
+template <size_t Size, size_t Align, typename Slabs>
+std::atomic<bool> ThreadCachePool<Size, Align, Slabs>::orphans_lock_{false};
+
+template <size_t Size, size_t Align, typename Slabs>
+typename ThreadCachePool<Size, Align, Slabs>::Cache
+    *ThreadCachePool<Size, Align, Slabs>::orphans_ = nullptr;
+
+template <size_t Size, size_t Align, typename Slabs>
+void *ThreadCachePool<Size, Align, Slabs>::allocate() {
+  Cache *cache = tls_cache_;
+  if (cache == nullptr && tls_exited_) {
+    // No handle would return a cache attached now, so this block comes from
+    // a borrowed one that goes straight back to the orphans.
+    cache = adopt_cache();
+    if (cache == nullptr) M3MPM_THROW(std::bad_alloc());
+    void *result = nullptr;
+    M3MPM_TRY {
+      result = take_block(cache);
+    } M3MPM_CATCH_ALL {
+      release_cache(cache);
+      M3MPM_RETHROW;
+    }
+    release_cache(cache);
+    return result;
+  }
+  if (cache == nullptr) cache = attach_thread();
+  if (cache == nullptr) M3MPM_THROW(std::bad_alloc());
+  return take_block(cache);
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+void *ThreadCachePool<Size, Align, Slabs>::take_block(Cache *cache) {
+  FreeBlock *block = cache->local_;
+  if (block == nullptr) {
+    block = cache->remote_.exchange(nullptr, std::memory_order_acquire);
+  }
+  if (block != nullptr) {
+    cache->local_ = block->pNext_;
+    return block;
+  }
+
+  if (static_cast<size_t>(cache->bump_end_ - cache->bump_) < kBlockSize) {
+    carve_slab(cache);
+  }
+  void *result = cache->bump_;
+  cache->bump_ += kBlockSize;
+  return result;
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+void ThreadCachePool<Size, Align, Slabs>::deallocate(void *p) noexcept {
+  FreeBlock *block = static_cast<FreeBlock *>(p);
+  Cache *owner = owner_of(p);
+  Cache *self = tls_cache_;
+  if (self == nullptr) {
+    // Frees issued while this thread's cache is being torn down go straight
+    // back to the owner.
+    if (tls_exited_) {
+      push_remote(owner, block, block);
+      return;
+    }
+    self = attach_thread();
+    // Without a cache of its own the block can still go home.
+    if (self == nullptr) {
+      push_remote(owner, block, block);
+      return;
+    }
+  }
+
+  if (owner == self) {
+    block->pNext_ = self->local_;
+    self->local_ = block;
+  } else {
+    park(self, owner, block);
+  }
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+typename ThreadCachePool<Size, Align, Slabs>::Cache *
+ThreadCachePool<Size, Align, Slabs>::adopt_cache() noexcept {
+  lock_orphans();
+  Cache *cache = orphans_;
+  if (cache != nullptr) orphans_ = cache->pNextOrphan_;
+  unlock_orphans();
+  if (cache == nullptr) cache = new (std::nothrow) Cache();
+  if (cache != nullptr) cache->pNextOrphan_ = nullptr;
+  return cache;
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+void ThreadCachePool<Size, Align, Slabs>::release_cache(Cache *cache) {
+  for (Batch &batch : cache->pending_) flush(&batch);
+  lock_orphans();
+  cache->pNextOrphan_ = orphans_;
+  orphans_ = cache;
+  unlock_orphans();
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+typename ThreadCachePool<Size, Align, Slabs>::Cache *
+ThreadCachePool<Size, Align, Slabs>::attach_thread() noexcept {
+  Cache *cache = adopt_cache();
+  if (cache == nullptr) return nullptr;
+  tls_cache_ = cache;
+  static thread_local ThreadHandle handle;
+  (void)handle;
+  return cache;
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+ThreadCachePool<Size, Align, Slabs>::ThreadHandle::~ThreadHandle() {
+  Cache *cache = tls_cache_;
+  tls_cache_ = nullptr;
+  tls_exited_ = true;
+  if (cache != nullptr) release_cache(cache);
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+typename ThreadCachePool<Size, Align, Slabs>::Cache *
+ThreadCachePool<Size, Align, Slabs>::owner_of(void *p) {
+  uintptr_t slab =
+      reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(kSlabSize - 1);
+  return reinterpret_cast<SlabHeader *>(slab)->owner_;
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+void ThreadCachePool<Size, Align, Slabs>::carve_slab(Cache *cache) {
+  char *slab = static_cast<char *>(Slabs::allocate_slab());
+  new (slab) SlabHeader{cache};
+  cache->bump_ = slab + kHeaderSize;
+  cache->bump_end_ = slab + kSlabSize;
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+void ThreadCachePool<Size, Align, Slabs>::park(Cache *self, Cache *owner,
+                                               FreeBlock *block) {
+  Batch *slot = nullptr;
+  for (Batch &batch : self->pending_) {
+    if (batch.owner_ == owner) {
+      slot = &batch;
+      break;
+    }
+  }
+  if (slot == nullptr) {
+    for (Batch &batch : self->pending_) {
+      if (batch.owner_ == nullptr) {
+        slot = &batch;
+        break;
+      }
+    }
+  }
+  if (slot == nullptr) {
+    slot = &self->pending_[self->next_victim_];
+    self->next_victim_ = (self->next_victim_ + 1) % kPendingOwners;
+    flush(slot);
+  }
+
+  slot->owner_ = owner;
+  block->pNext_ = slot->head_;
+  slot->head_ = block;
+  if (slot->tail_ == nullptr) slot->tail_ = block;
+  if (++slot->count_ == kBatchSize) flush(slot);
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+void ThreadCachePool<Size, Align, Slabs>::flush(Batch *batch) {
+  if (batch->count_ != 0) {
+    push_remote(batch->owner_, batch->head_, batch->tail_);
+  }
+  *batch = Batch{nullptr, nullptr, nullptr, 0};
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+void ThreadCachePool<Size, Align, Slabs>::push_remote(Cache *owner,
+                                                      FreeBlock *head,
+                                                      FreeBlock *tail) {
+  FreeBlock *old = owner->remote_.load(std::memory_order_relaxed);
+  do {
+    tail->pNext_ = old;
+  } while (!owner->remote_.compare_exchange_weak(
+      old, head, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+void ThreadCachePool<Size, Align, Slabs>::lock_orphans() {
+  while (orphans_lock_.exchange(true, std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+}
+
+template <size_t Size, size_t Align, typename Slabs>
+void ThreadCachePool<Size, Align, Slabs>::unlock_orphans() {
+  orphans_lock_.store(false, std::memory_order_release);
+}
+
+template <typename T>
+T *ThreadCachingAllocator<T>::allocate(size_t n) {
+  using pool = ThreadCachePool<sizeof(T), alignof(T)>;
+  if (n == 1 && pool::kPooled) return static_cast<T *>(pool::allocate());
+  return std::allocator<T>().allocate(n);
+}
+
+template <typename T>
+void ThreadCachingAllocator<T>::deallocate(T *p, size_t n) noexcept {
+  using pool = ThreadCachePool<sizeof(T), alignof(T)>;
+  if (n == 1 && pool::kPooled) {
+    pool::deallocate(p);
+  } else {
+    std::allocator<T>().deallocate(p, n);
+  }
+}
+
+template <typename T>
+size_t ThreadCachingAllocator<T>::allocation_size(size_t n) {
+  using pool = ThreadCachePool<sizeof(T), alignof(T)>;
+  if (n == 1 && pool::kPooled) return pool::block_size();
+  return detail::heap_allocation_size(n * sizeof(T));
+}
+
+}  // namespace m3mpm
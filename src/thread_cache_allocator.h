@@ -0,0 +1,140 @@
+#ifndef SRC_M3MPM_THREAD_CACHE_ALLOCATOR_H_
+#define SRC_M3MPM_THREAD_CACHE_ALLOCATOR_H_
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "config.h"
+#include "memory_usage.h"
+
+namespace m3mpm {
+// Where ThreadCachePool gets its slabs: kSlabSize bytes aligned to their
+// size, so a block finds its slab header by masking its address. Blocks
+// above kMaxBlockSize are not pooled.
+struct HeapSlabs {
+  static constexpr size_t kSlabSize = 64 * 1024;
+  static constexpr size_t kMaxBlockSize = kSlabSize / 16;
+  static void *allocate_slab() {
+    return ::operator new(kSlabSize, std::align_val_t(kSlabSize));
+  }
+};
+
+// Fixed-size block pool with one cache per thread. A thread allocates from
+// its own magazine (an intrusive free list) and carves slabs, 64 KiB ones
+// from HeapSlabs by default, when the magazine runs dry. Every slab records
+// the cache that carved it, so a block freed on another thread is
+// recognised as foreign: it is parked in a small per-thread batch and
+// handed back to its owner in a single atomic push once kBatchSize blocks
+// have gathered. The owner drains those returns before it
+// carves new memory. Pooled memory is reused but never given back to the
+// system; the cache of an exiting thread is adopted by the next new thread.
+// A thread whose cache is already torn down borrows one per allocation.
+template <size_t Size, size_t Align, typename Slabs = HeapSlabs>
+class ThreadCachePool {
+ private:
+  static constexpr size_t kSlabSize = Slabs::kSlabSize;
+  static constexpr size_t kBatchSize = 32;
+  static constexpr size_t kPendingOwners = 4;
+
+  struct FreeBlock {
+    FreeBlock *pNext_;
+  };
+  struct Cache;
+  struct Batch {
+    Cache *owner_;
+    FreeBlock *head_;
+    FreeBlock *tail_;
+    size_t count_;
+  };
+  struct Cache {
+    FreeBlock *local_ = nullptr;
+    char *bump_ = nullptr;
+    char *bump_end_ = nullptr;
+    std::atomic<FreeBlock *> remote_{nullptr};
+    Batch pending_[kPendingOwners] = {};
+    size_t next_victim_ = 0;
+    Cache *pNextOrphan_ = nullptr;
+  };
+  struct SlabHeader {
+    Cache *owner_;
+  };
+  struct ThreadHandle {
+    ~ThreadHandle();
+  };
+
+  static constexpr size_t round_up(size_t n, size_t a) {
+    return (n + a - 1) / a * a;
+  }
+  static constexpr size_t kBlockAlign =
+      Align > alignof(FreeBlock) ? Align : alignof(FreeBlock);
+  static constexpr size_t kBlockSize = round_up(
+      Size > sizeof(FreeBlock) ? Size : sizeof(FreeBlock), kBlockAlign);
+  static constexpr size_t kHeaderSize =
+      round_up(sizeof(SlabHeader), kBlockAlign);
+
+ public:
+  // Blocks too large to fit many per slab are not pooled.
+  static constexpr bool kPooled = kBlockSize <= Slabs::kMaxBlockSize &&
+                                  kBlockAlign <= Slabs::kMaxBlockSize;
+
+  // Bytes each block takes, alignment padding included.
+  static constexpr size_t block_size() { return kBlockSize; }
+  static void *allocate();
+  static void deallocate(void *p) noexcept;
+
+ private:
+  static Cache *adopt_cache() noexcept;
+  static void release_cache(Cache *cache);
+  static Cache *attach_thread() noexcept;
+  static void *take_block(Cache *cache);
+  static Cache *owner_of(void *p);
+  static void carve_slab(Cache *cache);
+  static void park(Cache *self, Cache *owner, FreeBlock *block);
+  static void flush(Batch *batch);
+  static void push_remote(Cache *owner, FreeBlock *head, FreeBlock *tail);
+  static void lock_orphans();
+  static void unlock_orphans();
+
+  static thread_local Cache *tls_cache_;
+  static thread_local bool tls_exited_;
+  static std::atomic<bool> orphans_lock_;
+  static Cache *orphans_;
+};
+
+// Stateless allocator that serves single-object requests, i.e. container
+// nodes, from the ThreadCachePool matching the size and alignment of T.
+// Array requests go to std::allocator. Suited to pipelines where one thread
+// pushes into a container and another pops from it.
+template <typename T>
+class ThreadCachingAllocator {
+ public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  ThreadCachingAllocator() noexcept {}
+  template <typename U>
+  ThreadCachingAllocator(const ThreadCachingAllocator<U> &) noexcept {}
+
+  T *allocate(size_t n);
+  void deallocate(T *p, size_t n) noexcept;
+  // Bytes allocate(n) takes; the slab headers, one per 64 KiB, are left out.
+  static size_t allocation_size(size_t n);
+};
+
+template <typename T, typename U>
+bool operator==(const ThreadCachingAllocator<T> &,
+                const ThreadCachingAllocator<U> &) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const ThreadCachingAllocator<T> &,
+                const ThreadCachingAllocator<U> &) {
+  return false;
+}
+}  // namespace m3mpm
+#include "thread_cache_allocator.cpp"
+#endif  // SRC_M3MPM_THREAD_CACHE_ALLOCATOR_H_